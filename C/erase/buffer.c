@@ -314,7 +314,7 @@ erase_status_t _erase_buffer_create(size_t size, erase_buffer_t **buffer)
 	bs = BUFFER_BYTES(BUFFER_ROUNDUP(size));
 	ts = bs + BUFFER_HDRSIZE;
 
-	if(ERA_ST_OK == (st = _erase_memory_alloc(ts, (void **)&bm)))
+	if(ERA_ST_OK == (st = _erase_secure_alloc(ts, (void **)&bm)))
 	{
 		bu  = (erase_buffer_t *)bm;
 		bu->bu_flags = 0;
@@ -327,7 +327,7 @@ erase_status_t _erase_buffer_create(size_t size, erase_buffer_t **buffer)
 erase_status_t _erase_buffer_destroy(erase_buffer_t *buffer)
 {
 	erase_debug("_erase_buffer_destroy(%p)", buffer);
-	return _erase_memory_free(buffer);
+	return _erase_secure_free(buffer);
 }
 
 erase_status_t _erase_fill_buffer_reset(erase_buffer_t *buffer)
@@ -131,6 +131,8 @@ extern erase_status_t _erase_memdup	   (const void *, size_t, void **);
 extern erase_status_t _erase_memory_alloc  (size_t, void **);
 extern erase_status_t _erase_memory_free   (void *);
 extern erase_status_t _erase_memory_realloc(void *, size_t, void **);
+extern erase_status_t _erase_secure_alloc  (size_t, void **);
+extern erase_status_t _erase_secure_free   (void *);
 extern erase_status_t _erase_strdup        (const char *, char **);
 
 /* methods.c */
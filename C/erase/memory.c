@@ -23,11 +23,14 @@
 
 #include "erase_internal.h"
 #include <CCA/memory.h>
+#include <CCA/secure.h>
 
 extern erase_status_t _erase_memdup	   (const void *, size_t, void **);
 extern erase_status_t _erase_memory_alloc  (size_t, void **);
 extern erase_status_t _erase_memory_free   (void *);
 extern erase_status_t _erase_memory_realloc(void *, size_t, void **);
+extern erase_status_t _erase_secure_alloc  (size_t, void **);
+extern erase_status_t _erase_secure_free   (void *);
 extern erase_status_t _erase_strdup        (const char *, char **);
 
 erase_status_t _erase_memdup(const void *src, size_t nby, void **retval)
@@ -72,6 +75,25 @@ erase_status_t _erase_memory_free(void *pointer)
 	return ERA_ST_OK;
 }
 
+erase_status_t _erase_secure_alloc(size_t nbytes, void **retval)
+{
+	void *p;
+
+	erase_debug("_erase_secure_alloc(%lu, %p)", nbytes, retval);
+	if(CC_TNULL(void) == (p = cc_secure_alloc(nbytes)))
+		return ERA_ST_SYSTEM_ERROR;
+
+	*retval = p;
+	return ERA_ST_OK;
+}
+
+erase_status_t _erase_secure_free(void *pointer)
+{
+	erase_debug("_erase_secure_free(%p)", pointer);
+	cc_secure_free(pointer);
+	return ERA_ST_OK;
+}
+
 erase_status_t _erase_strdup(const char *string, char **retval)
 {
 
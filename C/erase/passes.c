@@ -17,9 +17,12 @@
 
 #include <sys/types.h>
 #include <errno.h>
+#include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include <CCA/pool.h>
+
 #include "erase_internal.h"
 
 extern erase_status_t _erase_pass_process(erase_file_t *, erase_method_t *, uint64_t);
@@ -38,15 +41,27 @@ extern erase_status_t  erase_pass_create_rndbyte(int, erase_pass_t **);
 extern erase_status_t  erase_pass_destroy(erase_pass_t *);
 
 static erase_status_t builder(unsigned long, unsigned long, erase_pass_t **);
+static void           pool_init(void);
 
-static erase_status_t builder(unsigned long code, unsigned long arg, erase_pass_t **pass)
+/* Passes are many small objects of one size */
+static pthread_once_t pass_once = PTHREAD_ONCE_INIT;
+static CC_POOL        pass_pool = NULL;
+
+static void pool_init(void)
 {
-	erase_status_t  status;
+	pass_pool = cc_pool_create(sizeof(erase_pass_t), 0, 0);
+	return;
+}
 
+static erase_status_t builder(unsigned long code, unsigned long arg, erase_pass_t **pass)
+{
 	erase_debug("builder(%02lX, %02lX, %p)", code, arg, pass);
-	if(ERA_ST_OK == (status = _erase_memory_alloc(sizeof(erase_pass_t), (void **)pass)))
-		(*pass)->ep_mode = ERASE_MAKE_MODE(code, arg);
-	return status;
+	(void)pthread_once(&pass_once, pool_init);
+	if(NULL == pass_pool || NULL == (*pass = (erase_pass_t *)cc_pool_alloc(pass_pool)))
+		return ERA_ST_SYSTEM_ERROR;
+	(void)memset(*pass, 0, sizeof(erase_pass_t));
+	(*pass)->ep_mode = ERASE_MAKE_MODE(code, arg);
+	return ERA_ST_OK;
 }
 
 erase_status_t erase_pass_create_bit_lrotate(unsigned long nrot, erase_pass_t **pass)
@@ -189,7 +204,9 @@ erase_status_t erase_pass_destroy(erase_pass_t *pass)
 		break;
 	}
 	erase_debug(" . method destroyed");
-	return _erase_memory_free(pass);
+	(void)memset(pass, 0, sizeof(erase_pass_t));
+	cc_pool_free(pass_pool, pass);
+	return ERA_ST_OK;
 }
 
 erase_status_t _erase_pass_process(erase_file_t *file, erase_method_t *method, uint64_t passno)
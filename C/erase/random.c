@@ -39,10 +39,25 @@
 #endif
 
 #include "erase_internal.h"
+#include <CCA/memory.h>
+#include <CCA/secure.h>
 
 extern void          _erase_random_init(void);
 extern unsigned long _erase_random(void);
 
+#if !defined(HAVE_ARC4RANDOM)
+/*
+ * The state of random(3) is kept in secure memory (see CCA/secure.h),
+ * so that the patterns written cannot be predicted from a swap area or
+ * a core dump. It falls back to the static state of srandom when the
+ * secure memory is exhausted.
+ */
+# define RANDOM_STATE	256
+
+static char *random_state  = CC_TNULL(char);
+static int   random_seeded = 0;
+#endif
+
 void _erase_random_init(void)
 {
 #ifdef HAVE_ARC4RANDOM
@@ -75,7 +90,14 @@ seed_fail:
 # ifdef SEED_FILE
 seed_ok:
 # endif /* SEED_FILE */
-	srandom(seed);
+	if(CC_TNULL(char) == random_state)
+		random_state = (char *)cc_secure_alloc(RANDOM_STATE);
+	if(CC_TNULL(char) != random_state)
+		(void)initstate(seed, random_state, RANDOM_STATE);
+	else
+		srandom(seed);
+	cc_memwipe(&seed, sizeof(seed));
+	random_seeded = 1;
 #endif /* HAVE_ARC4RANDOM */
 	return;
 }
@@ -99,8 +121,9 @@ unsigned long _erase_random(void)
 #else
 	unsigned char *p;
 	size_t         s;
-	for(s = sizeof(unsigned long), p = (unsigned char *)&r; s > 0; s -=1, *(p++) = (unsigned char)(rand() & 0xFF))
-		printf("%lu\n", (unsigned long)s);
+	if(!random_seeded)
+		_erase_random_init();
+	for(s = sizeof(unsigned long), p = (unsigned char *)&r; s > 0; s -=1, *(p++) = (unsigned char)(random() & 0xFF));
 #endif
 	return r;
 }
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026
+ *     Christian CAMIER <christian.c at promethee dot services>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __CC_ARENA_H__
+#define __CC_ARENA_H__
+
+/*
+ * Arena (region) allocator.
+ *
+ * Blocks are cut one after the other out of large chunks, with no
+ * header and no individual free : they are released all together, by
+ * cc_arena_reset (back to a mark, or to the empty arena) or by
+ * cc_arena_destroy. Blocks larger than a quarter of a chunk get a chunk
+ * of their own.
+ *
+ * Chunks released by cc_arena_reset are kept for the next blocks, so
+ * that an arena reset after each request stops calling malloc once it
+ * has grown to the size of the largest request.
+ *
+ * An arena is not thread safe : concurrent accesses must be serialized
+ * by the caller.
+ */
+
+#include <stddef.h>
+
+#ifdef __CC_ARENA_INTERNAL__
+struct arena_st;
+typedef struct arena_st *CC_ARENA;
+#else
+typedef void *CC_ARENA;
+#endif
+
+/* Flags of cc_arena_create */
+#define CC_ARENA_WIPE	0x0001	/* Zero the memory released         */
+
+/* Alignment of the blocks of cc_arena_alloc */
+#define CC_ARENA_ALIGN	16
+
+/* Position in an arena, see cc_arena_mark */
+typedef struct cc_arena_mark_st {
+	void   *am_chunk;
+	size_t  am_used;
+	void   *am_large;
+} cc_arena_mark_t;
+
+/*
+ * cc_arena_create:
+ *	Create an arena
+ *
+ * Synopsis:
+ *	CC_ARENA cc_arena_create(size_t chunk, int flags);
+ *
+ * Arguments:
+ *  . chunk:
+ *	Size of the chunks, 0 for the default (64 KB).
+ *  . flags:
+ *	0 or CC_ARENA_WIPE : the memory released by cc_arena_reset and
+ *	cc_arena_destroy is zeroed first, for arenas holding secrets.
+ *
+ * Returns:
+ *	An arena or NULL if an error occurs.
+ *
+ * cc_arena_destroy:
+ *	Release the arena and all of its blocks.
+ */
+
+extern CC_ARENA cc_arena_create (size_t, int);
+extern void     cc_arena_destroy(CC_ARENA);
+
+/*
+ * cc_arena_alloc:
+ *	Allocate size bytes, aligned on CC_ARENA_ALIGN. The block is not
+ *	initialized.
+ *
+ * cc_arena_calloc:
+ *	Same, the block being zeroed.
+ *
+ * cc_arena_aligned:
+ *	Allocate size bytes aligned on align, a power of two.
+ *
+ * cc_arena_memdup, cc_arena_strdup:
+ *	Copy of a memory area or of a string.
+ *
+ * Returns:
+ *	The block or NULL if an error occurs.
+ */
+
+extern void    *cc_arena_alloc  (CC_ARENA, size_t);
+extern void    *cc_arena_calloc (CC_ARENA, size_t);
+extern void    *cc_arena_aligned(CC_ARENA, size_t, size_t);
+extern void    *cc_arena_memdup (CC_ARENA, const void *, size_t);
+extern char    *cc_arena_strdup (CC_ARENA, const char *);
+
+/*
+ * cc_arena_mark:
+ *	Store in *mark the current position of the arena.
+ *
+ * cc_arena_reset:
+ *	Release the blocks allocated since mark was taken, or all of the
+ *	blocks if mark is NULL. Marks taken after mark become invalid.
+ *
+ * cc_arena_used:
+ *	Number of bytes allocated in the arena, alignment padding included.
+ */
+
+extern void     cc_arena_mark   (CC_ARENA, cc_arena_mark_t *);
+extern void     cc_arena_reset  (CC_ARENA, const cc_arena_mark_t *);
+extern size_t   cc_arena_used   (CC_ARENA);
+
+#endif /* ! __CC_ARENA_H__ */
@@ -29,6 +29,17 @@ extern "C" {
 
 typedef uint16_t cc_crc16_t;
 typedef uint32_t cc_crc32_t;
+typedef uint64_t cc_crc64_t;
+
+/*
+ * cc_*_combine(crcA, crcB, lenB):
+ *	CRC of a message A followed by a message B of lenB bytes, from
+ *	the CRC of A and the CRC of B.
+ *
+ * cc_*_parallel(data, nBytes, nThreads):
+ *	Same result as cc_*_crcFast, the work being shared between up
+ *	to nThreads threads.
+ */
 
 /* CCITT_CRC 16 functions */
 extern cc_crc16_t  cc_ccitt_crcSlow(const void *data, size_t nBytes);
@@ -36,6 +47,7 @@ extern cc_crc16_t  cc_ccitt_crcFast(const void *data, size_t nBytes);
 extern cc_crc16_t *cc_ccitt_crcStart(cc_crc16_t *context);
 extern cc_crc16_t *cc_ccitt_crcAppnd(cc_crc16_t *context, const void *data, size_t nBytes);
 extern cc_crc16_t  cc_ccitt_crcClose(cc_crc16_t *context);
+extern cc_crc16_t  cc_ccitt_combine(cc_crc16_t crcA, cc_crc16_t crcB, size_t lenB);
 
 /* CRC 16 functions */
 extern cc_crc16_t  cc_crc16_crcSlow(const void *data, size_t nBytes);
@@ -43,6 +55,7 @@ extern cc_crc16_t  cc_crc16_crcFast(const void *data, size_t nBytes);
 extern cc_crc16_t *cc_crc16_crcStart(cc_crc16_t *context);
 extern cc_crc16_t *cc_crc16_crcAppnd(cc_crc16_t *context, const void *data, size_t nBytes);
 extern cc_crc16_t  cc_crc16_crcClose(cc_crc16_t *context);
+extern cc_crc16_t  cc_crc16_combine(cc_crc16_t crcA, cc_crc16_t crcB, size_t lenB);
 
 /* CRC 32 functions */
 extern cc_crc32_t  cc_crc32_crcSlow(const void *data, size_t nBytes);
@@ -50,6 +63,100 @@ extern cc_crc32_t  cc_crc32_crcFast(const void *data, size_t nBytes);
 extern cc_crc32_t *cc_crc32_crcStart(cc_crc32_t *context);
 extern cc_crc32_t *cc_crc32_crcAppnd(cc_crc32_t *context, const void *data, size_t nBytes);
 extern cc_crc32_t  cc_crc32_crcClose(cc_crc32_t *context);
+extern cc_crc32_t  cc_crc32_combine(cc_crc32_t crcA, cc_crc32_t crcB, size_t lenB);
+extern cc_crc32_t  cc_crc32_parallel(const void *data, size_t nBytes, unsigned nThreads);
+
+/* CRC 32C (Castagnoli) functions */
+extern cc_crc32_t  cc_crc32c_crcSlow(const void *data, size_t nBytes);
+extern cc_crc32_t  cc_crc32c_crcFast(const void *data, size_t nBytes);
+extern cc_crc32_t *cc_crc32c_crcStart(cc_crc32_t *context);
+extern cc_crc32_t *cc_crc32c_crcAppnd(cc_crc32_t *context, const void *data, size_t nBytes);
+extern cc_crc32_t  cc_crc32c_crcClose(cc_crc32_t *context);
+extern cc_crc32_t  cc_crc32c_combine(cc_crc32_t crcA, cc_crc32_t crcB, size_t lenB);
+extern cc_crc32_t  cc_crc32c_parallel(const void *data, size_t nBytes, unsigned nThreads);
+
+/* CRC 64 ECMA-182 functions */
+extern cc_crc64_t  cc_crc64ecma_crcSlow(const void *data, size_t nBytes);
+extern cc_crc64_t  cc_crc64ecma_crcFast(const void *data, size_t nBytes);
+extern cc_crc64_t *cc_crc64ecma_crcStart(cc_crc64_t *context);
+extern cc_crc64_t *cc_crc64ecma_crcAppnd(cc_crc64_t *context, const void *data, size_t nBytes);
+extern cc_crc64_t  cc_crc64ecma_crcClose(cc_crc64_t *context);
+extern cc_crc64_t  cc_crc64ecma_combine(cc_crc64_t crcA, cc_crc64_t crcB, size_t lenB);
+
+/* CRC 64 XZ functions */
+extern cc_crc64_t  cc_crc64xz_crcSlow(const void *data, size_t nBytes);
+extern cc_crc64_t  cc_crc64xz_crcFast(const void *data, size_t nBytes);
+extern cc_crc64_t *cc_crc64xz_crcStart(cc_crc64_t *context);
+extern cc_crc64_t *cc_crc64xz_crcAppnd(cc_crc64_t *context, const void *data, size_t nBytes);
+extern cc_crc64_t  cc_crc64xz_crcClose(cc_crc64_t *context);
+extern cc_crc64_t  cc_crc64xz_combine(cc_crc64_t crcA, cc_crc64_t crcB, size_t lenB);
+
+/*
+ * Generic CRC engine.
+ *
+ * A CRC is described by its Rocksoft model parameters (see Ross
+ * Williams, "A painless guide to CRC error detection algorithms") :
+ *  . cm_width:  Width in bits of the CRC, from 1 to 64.
+ *  . cm_poly:   Polynomial, in its normal form, without the top bit.
+ *  . cm_init:   Initial remainder.
+ *  . cm_refin:  Non zero if the input bytes are reflected.
+ *  . cm_refout: Non zero if the remainder is reflected before the
+ *               final xor.
+ *  . cm_xorout: Value xor'ed to the final remainder.
+ *  . cm_check:  CRC of the ASCII string "123456789".
+ *
+ * cc_crc_engine_init builds the division table of the model in the
+ * engine. Once initialized, an engine is read only and may be shared
+ * between threads. The engine functions have the same meaning as the
+ * family ones above, values of narrower CRCs being held in the low bits
+ * of a cc_crc64_t.
+ */
+typedef struct cc_crc_model_st {
+	const char *cm_name;
+	unsigned    cm_width;
+	cc_crc64_t  cm_poly;
+	cc_crc64_t  cm_init;
+	int         cm_refin;
+	int         cm_refout;
+	cc_crc64_t  cm_xorout;
+	cc_crc64_t  cm_check;
+} cc_crc_model_t;
+
+typedef struct cc_crc_engine_st {
+	cc_crc_model_t   ce_model;
+	unsigned         ce_shift;	/* Left alignment of the register */
+	cc_crc64_t       ce_init;	/* Initial register */
+	cc_crc64_t     (*ce_divide)(const struct cc_crc_engine_st *, cc_crc64_t, const uint8_t *, size_t);
+	union {
+		uint8_t    t08[256];
+		uint16_t   t16[256];
+		uint32_t   t32[256];
+		uint64_t   t64[256];
+	}                ce_table;
+} cc_crc_engine_t;
+
+/* Predefined models */
+extern const cc_crc_model_t cc_crc_model_ccitt;
+extern const cc_crc_model_t cc_crc_model_crc16;
+extern const cc_crc_model_t cc_crc_model_crc32;
+extern const cc_crc_model_t cc_crc_model_crc32c;
+extern const cc_crc_model_t cc_crc_model_crc64ecma;
+extern const cc_crc_model_t cc_crc_model_crc64xz;
+
+/*
+ * cc_crc_engine_init:
+ *	Initialize an engine for the given model.
+ *
+ * Returns:
+ *	0 on success, -1 (errno set to EINVAL) if the model is not valid.
+ */
+extern int         cc_crc_engine_init (cc_crc_engine_t *engine, const cc_crc_model_t *model);
+extern cc_crc64_t  cc_crc_engine_crcSlow (const cc_crc_engine_t *engine, const void *data, size_t nBytes);
+extern cc_crc64_t  cc_crc_engine_crcFast (const cc_crc_engine_t *engine, const void *data, size_t nBytes);
+extern cc_crc64_t *cc_crc_engine_crcStart(const cc_crc_engine_t *engine, cc_crc64_t *context);
+extern cc_crc64_t *cc_crc_engine_crcAppnd(const cc_crc_engine_t *engine, cc_crc64_t *context, const void *data, size_t nBytes);
+extern cc_crc64_t  cc_crc_engine_crcClose(const cc_crc_engine_t *engine, cc_crc64_t *context);
+extern cc_crc64_t  cc_crc_engine_combine (const cc_crc_engine_t *engine, cc_crc64_t crcA, cc_crc64_t crcB, size_t lenB);
 
 #ifdef __cplusplus
 }
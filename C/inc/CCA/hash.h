@@ -0,0 +1,64 @@
+/*-                                               -*- c -*-
+ * Copyright (c) 2026
+ *      Christian CAMIER <chcamier@free.fr>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Description :
+ *	64 bits hash function for lookup tables
+ */
+
+#ifndef __CC_HASH_H__
+#define __CC_HASH_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * cc_hash64:
+ *	Hash `len' bytes at `data' into a 64 bits value.
+ *
+ * cc_hash64_str:
+ *	Hash a NUL terminated string in a single pass. The result is
+ *	the one of cc_hash64(str, strlen(str), seed).
+ *
+ * cc_hash64_key:
+ *	cc_hash64_str with a null seed, usable as a cc_lookup_hash_t.
+ *	This is the default hasher of cc_lookup and cc_hashtable.
+ *
+ * The seed can be any value; different seeds give independent hash
+ * functions. Not suitable for cryptographic purposes.
+ */
+extern uint64_t cc_hash64    (const void *data, size_t len, uint64_t seed);
+extern uint64_t cc_hash64_str(const char *str, uint64_t seed);
+extern uint64_t cc_hash64_key(const void *str);
+
+/*
+ * cc_hash_batch:
+ *	Hash `n' keys at once : out[i] = cc_hash64(keys[i], lens[i], 0).
+ *	If `lens' is NULL the keys are NUL terminated strings and
+ *	out[i] = cc_hash64_key(keys[i]).
+ *	Independent keys are hashed in parallel, which is faster than
+ *	calling cc_hash64 for each of them.
+ */
+extern void     cc_hash_batch(const void **keys, const size_t *lens, size_t n, uint64_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !__CC_HASH_H__ */
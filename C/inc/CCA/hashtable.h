@@ -31,18 +31,38 @@ typedef struct cc_hashtable_hdr_st {
 	CC_HASHTABLE_HEADER(struct cc_hashtable_hdr_st, void, key);
 } cc_hashtable_hdr_t, *CC_HASHTABLE_HDR;
 
+/*
+ * While the table is resized, the elements are moved a few buckets at a
+ * time from ht_oheads to ht_heads : the buckets of ht_oheads below
+ * ht_move are already moved.
+ */
 typedef struct cc_hashtable_st {
 	cc_hashtable_comp_t  fn_comp;
 	cc_hashtable_hash_t  fn_hash;
-	size_t               ht_size;
-	CC_HASHTABLE_HDR     ht_heads[1];
+	size_t               ht_size;	/* Buckets of ht_heads              */
+	size_t               ht_count;	/* Number of elements               */
+	size_t               ht_min;	/* Size the table never shrinks under */
+	int                  ht_shrink;	/* Shrink when sparse               */
+	size_t               ht_osize;	/* Buckets of ht_oheads             */
+	size_t               ht_move;	/* Next bucket of ht_oheads to move */
+	CC_HASHTABLE_HDR    *ht_oheads;	/* Table being emptied or NULL      */
+	CC_HASHTABLE_HDR    *ht_heads;
+	size_t               ht_cursors;	/* Open cursors : no resizing       */
 } cc_hashtable_t, *CC_HASHTABLE;
 
-#define CC_HASHTABLE_HDR_SZ (size_t)(((struct cc_hashtable_st *)0)->ht_heads)
+typedef struct cc_hashtable_cursor_st {
+	CC_HASHTABLE         hc_table;
+	int                  hc_phase;	/* 0 : ht_oheads, 1 : ht_heads      */
+	size_t               hc_bucket;	/* Next bucket                      */
+	CC_HASHTABLE_HDR     hc_next;	/* Next element of the bucket       */
+} cc_hashtable_cursor_t;
+
+#define CC_HASHTABLE_HDR_SZ sizeof(struct cc_hashtable_st)
 /* Errors */
 #define CC_HASHTABLE_ERR_NOERROR	0 /* No error */
 #define CC_HASHTABLE_ERR_EXISTS		1 /* Key already exists */
 #define CC_HASHTABLE_ERR_NOTFOUND	2 /* KEy not found */
+#define CC_HASHTABLE_ERR_SYSERR		3 /* Memory allocation failed */
 
 /*
  * cc_hashtable_create:
@@ -53,7 +73,11 @@ typedef struct cc_hashtable_st {
  *
  * Arguments:
  *  . size:
- *      Size of the hash table (number of entries).
+ *      Initial size of the hash table (number of entries).
+ *	The table doubles when it holds more elements than entries, and
+ *	the elements are moved to the new entries a few at each
+ *	cc_hashtable_add or cc_hashtable_del, so that no call pays for the
+ *	whole table.
  *	For the size of the tables, the use of an odd first number is strongly advised for reasons of distribution.
  *	First possiblities :
  *	3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109,
@@ -70,13 +94,48 @@ typedef struct cc_hashtable_st {
  *	If comparator is NULL, defaul function will be "strcmp".
  *  . hasher:
  *      Hash function.
- *	If hasher is NULL, default function will be "jenkin".
+ *	If hasher is NULL, default function will be "cc_hash64_key"
+ *	(see CCA/hash.h).
  *
  * Returns:
  *	An hashtable header or NULL if an error occurs.
+ *
+ * cc_hashtable_destroy:
+ *	Free the hashtable. The elements belong to the caller and are left
+ *	untouched.
+ */
+
+extern CC_HASHTABLE cc_hashtable_create (size_t, cc_hashtable_comp_t, cc_hashtable_hash_t);
+extern void         cc_hashtable_destroy(CC_HASHTABLE);
+
+/*
+ * cc_hashtable_reserve:
+ *	Size the table for a given number of elements
+ *
+ * Synopsis:
+ *	int cc_hashtable_reserve(CC_HASHTABLE hashtable, size_t count);
+ *
+ * Arguments:
+ *   . hashtable : hashtable to use.
+ *   . count     : Number of elements expected.
+ *
+ * Description:
+ *	Any resizing in progress is completed and the table is enlarged at
+ *	once to count entries, so that a bulk load does not resize it. The
+ *	table does not shrink under count entries afterwards.
+ *
+ * Returns:
+ *	. CC_HASHTABLE_ERR_NOERROR : Success.
+ *	. CC_HASHTABLE_ERR_SYSERR  : Memory allocation failed.
+ *
+ * cc_hashtable_autoshrink:
+ *	Enable (non zero) or disable (0, the default) the shrinking of the
+ *	table to half its size when less than 1/8 of its entries are used.
+ *	The table never shrinks under its initial or reserved size.
  */
 
-extern CC_HASHTABLE cc_hashtable_create(size_t, cc_hashtable_comp_t, cc_hashtable_hash_t);
+extern int          cc_hashtable_reserve   (CC_HASHTABLE, size_t);
+extern void         cc_hashtable_autoshrink(CC_HASHTABLE, int);
 
 /*
  * cc_hashtable_add:
@@ -98,4 +157,42 @@ extern int          cc_hashtable_add   (CC_HASHTABLE, CC_HASHTABLE_HDR);
 extern int          cc_hashtable_del   (CC_HASHTABLE, void *, CC_HASHTABLE_HDR *);
 extern int          cc_hashtable_search(CC_HASHTABLE, void *, CC_HASHTABLE_HDR *);
 
+/*
+ * cc_hashtable_cursor_open:
+ *	Start an iteration on the hashtable.
+ *
+ * cc_hashtable_cursor_next:
+ *	Return the next element, or NULL at the end of the hashtable.
+ *
+ * cc_hashtable_cursor_close:
+ *	End the iteration.
+ *
+ * Synopsis:
+ *	void             cc_hashtable_cursor_open (CC_HASHTABLE hashtable, cc_hashtable_cursor_t *cursor);
+ *	CC_HASHTABLE_HDR cc_hashtable_cursor_next (cc_hashtable_cursor_t *cursor);
+ *	void             cc_hashtable_cursor_close(cc_hashtable_cursor_t *cursor);
+ *
+ * Description:
+ *	The elements present during the whole iteration are returned once.
+ *	Elements may be added meanwhile, and are returned or not. The
+ *	element last returned may be deleted, but no other one. The
+ *	hashtable is not resized while a cursor is open.
+ */
+
+extern void             cc_hashtable_cursor_open (CC_HASHTABLE, cc_hashtable_cursor_t *);
+extern CC_HASHTABLE_HDR cc_hashtable_cursor_next (cc_hashtable_cursor_t *);
+extern void             cc_hashtable_cursor_close(cc_hashtable_cursor_t *);
+
+/*
+ * cc_hashtable_snapshot:
+ *	Return in *elements an array of the *count elements of the
+ *	hashtable, to be freed by cc_free.
+ *
+ * Returns:
+ *	. CC_HASHTABLE_ERR_NOERROR : Success.
+ *	. CC_HASHTABLE_ERR_SYSERR  : Memory allocation failed.
+ */
+
+extern int              cc_hashtable_snapshot(CC_HASHTABLE, CC_HASHTABLE_HDR **, size_t *);
+
 #endif /* ! __CC_HASHTABLE_H__ */
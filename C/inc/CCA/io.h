@@ -21,6 +21,17 @@
 extern ssize_t cc_io_read (int,       void *, size_t, size_t *,       void **);
 extern ssize_t cc_io_write(int, const void *, size_t, size_t *, const void **);
 
+/*
+ * cc_io_writev:
+ *	writev until all the iovcnt buffers are written or an error occurs.
+ *	The iovec array is modified when a write is partial.
+ *
+ * Returns:
+ *	The number of bytes written, or -1 if an error occurs.
+ */
+struct iovec;
+extern ssize_t cc_io_writev(int, struct iovec *, int);
+
 #define CC_IO_READ(f, d, s)  cc_io_read (f, d, s, NULL, NULL)
 #define CC_IO_WRITE(f, d, s) cc_io_write(f, d, s, NULL, NULL)
 
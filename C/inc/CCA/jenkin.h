@@ -16,6 +16,9 @@
  *
  * Description :
  *	Jenkin's hash function for lookup tables
+ *
+ *	Kept for compatibility : new code should use the 64 bits
+ *	functions of CCA/hash.h.
  */
 
 #ifndef __JENKIN_H__
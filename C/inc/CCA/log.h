@@ -24,7 +24,9 @@ extern int    cc_log_config         (const char *, const char *);
 extern void   cc_log_crit           (const char *, ...);
 extern void   cc_log_debug          (const char *, ...);
 extern void   cc_log_emerg          (const char *, ...);
+extern void   cc_log_emit           (int, const char *, ...);
 extern void   cc_log_err            (const char *, ...);
+extern void   cc_log_flush          (void);
 extern void   cc_log_info           (const char *, ...);
 extern void   cc_log_notice         (const char *, ...);
 extern void   cc_log_perror         (const char *);
@@ -32,6 +34,149 @@ extern void   cc_log_reinit         (void);
 extern void   cc_log_start          (void);
 extern void   cc_log_warning        (const char *, ...);
 
+/*
+ * cc_log_config("timeprecision", "0", "3" or "6") adds milliseconds or
+ * microseconds to the time of the lines. They come from the coarse
+ * clock, which moves at each clock tick (a few ms).
+ *
+ * Asynchronous logging (stderr, file and bfile drivers), set by cc_log_config
+ * and applied by cc_log_start:
+ *  . "async"          : "on" or "off" (the default).
+ *  . "async_slots"    : Lines the ring holds (1024).
+ *  . "async_overflow" : When the ring is full, "block" (the default)
+ *                       until a line is written, "drop" the line, or
+ *                       "count" : drop it and log the number dropped.
+ *  . "async_binary"   : "on" to queue the raw arguments and let the
+ *                       writer thread format the lines, "off" (the
+ *                       default).
+ *  . "async_binfile"  : Path of a binary log file the writer appends
+ *                       the raw records to instead of formatting them,
+ *                       "" for none (the default). The driver is not
+ *                       used, cc_logdecode formats the file.
+ * cc_log_close writes the lines queued.
+ *
+ * A queued line is cut at the same length as a line written at once
+ * (1023 bytes). In binary mode, the format must be a constant string :
+ * only its address is queued. The strings given as arguments are
+ * copied, and the raw arguments of a line take 1024 bytes at most, so
+ * that long strings are cut a little shorter. Positional arguments
+ * (%1$s) are not supported.
+ *
+ * cc_log_async_dropped:
+ *	Number of lines dropped since the program started.
+ */
+extern unsigned long cc_log_async_dropped(void);
+
+/*
+ * Buffered file driver, cc_log_config("type", "bfile"). The lines are
+ * written by blocks instead of one by one:
+ *  . "file", "mode"    : As for the file driver.
+ *  . "buffer_size"     : Bytes buffered (64K, K, M and G suffixes).
+ *  . "flush_interval"  : Milliseconds a line may wait in the buffer
+ *                        (1000), checked when a line is logged or by
+ *                        the idle async writer.
+ *  . "flush_level"     : Lines of this level or more severe are written
+ *                        at once ("err").
+ *  . "rotate_size"     : Size the file is rotated at, 0 for never (0).
+ *  . "rotate_interval" : Seconds after which the file is rotated, 0 for
+ *                        never (0).
+ *  . "rotate_keep"     : Rotated files kept, file.1 being the newest
+ *                        (5).
+ *  . "datasync"        : fdatasync after each write ("flush"), at
+ *                        rotation and close ("rotate"), or "none" (the
+ *                        default).
+ *
+ * cc_log_flush:
+ *	Write the lines the driver buffers. cc_log_close writes them too.
+ */
+
+/*
+ * Logging macros.
+ *
+ * CC_LOG_EMERG(format, ...) ... CC_LOG_DEBUG(format, ...) log as the
+ * cc_log_ functions, but test the level before the arguments are
+ * evaluated:
+ *  . Levels less severe than CC_LOG_COMPILE_LEVEL (CC_LOG_LEVEL_DEBUG
+ *    by default) are compiled to nothing : build with
+ *    -DCC_LOG_COMPILE_LEVEL=CC_LOG_LEVEL_INFO to drop the debug lines.
+ *  . The others cost one load and one compare, predicted not taken,
+ *    when their level is not logged.
+ *
+ * The level tested is the one of cc_log_config("level", ...), or the
+ * one of the module when CC_LOG_MODULE is defined before CCA/log.h is
+ * included. A module is defined once by CC_LOG_MODULE_DEFINE(name) in
+ * a source file, and its level is set by cc_log_config("level.name",
+ * level), "default" giving it back the global one.
+ *
+ *	#define CC_LOG_MODULE net
+ *	#include <CCA/log.h>
+ *
+ *	CC_LOG_MODULE_DEFINE(net)
+ *	...
+ *	CC_LOG_DEBUG("%s: %zu bytes received", peer_name(p), size);
+ *
+ * cc_log_emit:
+ *	Log format at level, whatever the configured level is. Used by
+ *	the macros once they tested the level.
+ */
+#include <CCA/util.h>
+
+/* Same values as the syslog(3) levels */
+#define CC_LOG_LEVEL_EMERG	0
+#define CC_LOG_LEVEL_ALERT	1
+#define CC_LOG_LEVEL_CRIT	2
+#define CC_LOG_LEVEL_ERR	3
+#define CC_LOG_LEVEL_WARNING	4
+#define CC_LOG_LEVEL_NOTICE	5
+#define CC_LOG_LEVEL_INFO	6
+#define CC_LOG_LEVEL_DEBUG	7
+
+#ifndef CC_LOG_COMPILE_LEVEL
+# define CC_LOG_COMPILE_LEVEL	CC_LOG_LEVEL_DEBUG
+#endif
+
+typedef struct cc_log_module_st {
+	int                      lm_level;	/* Level tested by the macros       */
+	int                      lm_set;	/* Level given by cc_log_config     */
+	const char              *lm_name;
+	struct cc_log_module_st *lm_next;
+} cc_log_module_t;
+
+extern int  cc_log_level;			/* Level tested by the macros       */
+extern void cc_log_register_module(cc_log_module_t *);
+
+#define CC_LOG_MODULE_VAR_(name)	cc_log_module_##name
+#define CC_LOG_MODULE_VAR(name)		CC_LOG_MODULE_VAR_(name)
+
+#define CC_LOG_MODULE_DEFINE(name)							\
+	cc_log_module_t CC_LOG_MODULE_VAR_(name) = { CC_LOG_LEVEL_INFO, 0, #name, NULL };	\
+	static __attribute__((constructor)) void cc_log_module_ctor_##name(void)	\
+	{										\
+		cc_log_register_module(&CC_LOG_MODULE_VAR_(name));			\
+	}
+
+#ifdef CC_LOG_MODULE
+extern cc_log_module_t CC_LOG_MODULE_VAR(CC_LOG_MODULE);
+# define CC_LOG_THRESHOLD	(CC_LOG_MODULE_VAR(CC_LOG_MODULE).lm_level)
+#else
+# define CC_LOG_THRESHOLD	cc_log_level
+#endif
+
+#define CC_LOG_AT(level, ...)								\
+	do {										\
+		if((level) <= CC_LOG_COMPILE_LEVEL && CC_UNLIKELY((level) <= CC_LOG_THRESHOLD))	\
+			cc_log_emit((level), __VA_ARGS__);				\
+	} while(0)
+
+#define CC_LOG_EMERG(...)	CC_LOG_AT(CC_LOG_LEVEL_EMERG,   __VA_ARGS__)
+#define CC_LOG_ALERT(...)	CC_LOG_AT(CC_LOG_LEVEL_ALERT,   __VA_ARGS__)
+#define CC_LOG_CRIT(...)	CC_LOG_AT(CC_LOG_LEVEL_CRIT,    __VA_ARGS__)
+#define CC_LOG_ERR(...)		CC_LOG_AT(CC_LOG_LEVEL_ERR,     __VA_ARGS__)
+#define CC_LOG_WARNING(...)	CC_LOG_AT(CC_LOG_LEVEL_WARNING, __VA_ARGS__)
+#define CC_LOG_NOTICE(...)	CC_LOG_AT(CC_LOG_LEVEL_NOTICE,  __VA_ARGS__)
+#define CC_LOG_INFO(...)	CC_LOG_AT(CC_LOG_LEVEL_INFO,    __VA_ARGS__)
+#define CC_LOG_DEBUG(...)	CC_LOG_AT(CC_LOG_LEVEL_DEBUG,   __VA_ARGS__)
+
 #ifdef _STDARG_H
 extern size_t cc_log_format_message (char *, size_t, int, const char *, va_list);
 extern void   cc_log_valert         (const char *, va_list);
@@ -18,11 +18,51 @@
 #ifndef __CC_LOOKUP_H__
 #define __CC_LOOKUP_H__
 
+/*
+ * Thread safety:
+ *
+ *	A table made by cc_lookup_create is not thread safe : concurrent
+ *	accesses must be serialized by the caller, for instance with
+ *	cc_lookup_lock and cc_lookup_unlock.
+ *
+ *	A table made by cc_lookup_create_concurrent is split in shards,
+ *	each with its own lock and free entries. cc_lookup_add,
+ *	cc_lookup_del, cc_lookup_search, cc_lookup_reserve and
+ *	cc_lookup_count may be called from any number of threads; only
+ *	the calls on keys of the same shard wait for each other.
+ *	The comparator, hasher and destructor are called with the lock of
+ *	the shard held and must not use the table.
+ *	cc_lookup_search returns the data, not a reference on it: the
+ *	caller must make sure a concurrent cc_lookup_del does not free it
+ *	while it is used (with CC_LOOKUP_LOCK_RCU, that the search returns
+ *	before cc_lookup_synchronize does).
+ *
+ *	With CC_LOOKUP_LOCK_RCU, cc_lookup_search takes no lock and makes
+ *	no atomic read-modify-write: it only publishes, in a record of the
+ *	calling thread, the epoch it runs in. The entries deleted or moved
+ *	by the writers are reused only once every search that could reach
+ *	them has returned, and the destructor runs on the data of a
+ *	deleted entry at that time, not in cc_lookup_del. Without
+ *	destructor, the caller frees the key and data of a deleted entry
+ *	after cc_lookup_synchronize. A search running along a
+ *	cc_lookup_add or a cc_lookup_del of the same key may see the table
+ *	before or after it. The comparator and hasher are then called
+ *	without lock.
+ *
+ *	cc_lookup_bulk_add, the cursors and cc_lookup_snapshot are thread
+ *	safe as well.
+ *
+ *	cc_lookup_destroy and cc_lookup_autoshrink are never thread safe.
+ */
+
 #ifdef __CC_LOOKUP_INTERNAL__
 struct lookup_table_st;
-typedef struct lookup_table_st *CC_LOOKUP;
+struct lookup_cursor_st;
+typedef struct lookup_table_st  *CC_LOOKUP;
+typedef struct lookup_cursor_st *CC_LOOKUP_CURSOR;
 #else
 typedef void *CC_LOOKUP;
+typedef void *CC_LOOKUP_CURSOR;
 #endif
 
 typedef enum cc_lookup_status_en {
@@ -33,6 +73,20 @@ typedef enum cc_lookup_status_en {
 } cc_lookup_status_t;
 	
 
+typedef enum cc_lookup_locking_en {
+	CC_LOOKUP_LOCK_NONE	= 0,  /* No locking                          */
+	CC_LOOKUP_LOCK_MUTEX,	      /* A mutex by shard                    */
+	CC_LOOKUP_LOCK_RWLOCK,	      /* A reader-writer lock by shard:
+					 concurrent searches share it      */
+	CC_LOOKUP_LOCK_RCU	      /* A mutex by shard for the writers,
+					 no lock for the searches          */
+} cc_lookup_locking_t;
+
+typedef struct cc_lookup_pair_st {
+	const void *lp_key;
+	void       *lp_data;
+} cc_lookup_pair_t;
+
 typedef int      (*cc_lookup_comp_t)(const void *, const void *);
 typedef uint64_t (*cc_lookup_hash_t)(const void *);
 typedef void     (*cc_lookup_free_t)(const void *);
@@ -46,7 +100,11 @@ typedef void     (*cc_lookup_free_t)(const void *);
  *
  * Arguments:
  *  . size:
- *      Size of the hash table (number of entries).
+ *      Initial size of the hash table (number of entries).
+ *	The table doubles when it holds more elements than entries, and
+ *	the elements are moved to the new entries a few at each
+ *	cc_lookup_add or cc_lookup_del, so that no call pays for the
+ *	whole table.
  *	For the size of the tables, the use of an odd first number is strongly advised for reasons of distribution.
  *	First possiblities :
  *	3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109,
@@ -63,7 +121,8 @@ typedef void     (*cc_lookup_free_t)(const void *);
  *	If comparator is NULL, defaul function will be "strcmp".
  *  . hasher:
  *      Hash function.
- *	If hasher is NULL, default function will be "jenkin".
+ *	If hasher is NULL, default function will be "cc_hash64_key"
+ *	(see CCA/hash.h).
  *
  * Returns:
  *	An lookup header or NULL if an error occurs.
@@ -72,6 +131,48 @@ typedef void     (*cc_lookup_free_t)(const void *);
 extern CC_LOOKUP cc_lookup_create(size_t, cc_lookup_comp_t, cc_lookup_hash_t, cc_lookup_free_t);
 extern void      cc_lookup_destroy(CC_LOOKUP);
 
+/*
+ * cc_lookup_create_concurrent:
+ *	Create a lookup table shared by several threads
+ *
+ * Synopsis:
+ *	CC_LOOKUP cc_lookup_create_concurrent(size_t size, size_t shards, cc_lookup_locking_t locking,
+ *	                                      cc_lookup_cmp_t comparator, cc_lookup_hash_t hasher,
+ *	                                      cc_lookup_free_t destructor);
+ *
+ * Arguments:
+ *  . size:
+ *      Initial size of the hash table, shared among the shards.
+ *  . shards:
+ *	Number of shards, rounded up to a power of two (at most 4096).
+ *	If shards is 0, 4 shards by online CPU are used.
+ *	A few times the number of threads using the table is enough to
+ *	make contention rare.
+ *  . locking:
+ *	CC_LOOKUP_LOCK_MUTEX for general use, CC_LOOKUP_LOCK_RWLOCK for
+ *	tables mostly searched, CC_LOOKUP_LOCK_RCU for tables almost only
+ *	searched (searches without lock, scaling with the cores).
+ *	CC_LOOKUP_LOCK_NONE gives the table of cc_lookup_create (one
+ *	shard, no locking).
+ *  . comparator, hasher, destructor:
+ *	See cc_lookup_create. The shard is chosen by the high bits of the
+ *	hash, the hasher must spread them.
+ *
+ * Returns:
+ *	An lookup header or NULL if an error occurs.
+ */
+
+extern CC_LOOKUP cc_lookup_create_concurrent(size_t, size_t, cc_lookup_locking_t, cc_lookup_comp_t, cc_lookup_hash_t, cc_lookup_free_t);
+
+/*
+ * cc_lookup_lock, cc_lookup_unlock:
+ *	Lock and unlock the mutex of the table, for callers serializing
+ *	their own sequences of calls. The table functions never take it.
+ */
+
+extern void      cc_lookup_lock  (CC_LOOKUP);
+extern void      cc_lookup_unlock(CC_LOOKUP);
+
 /*
  * cc_lookup_add:
  *	Add an element to lookup
@@ -92,4 +193,114 @@ extern cc_lookup_status_t cc_lookup_add   (CC_LOOKUP, const void *, void  *);
 extern cc_lookup_status_t cc_lookup_del   (CC_LOOKUP, const void *, void **);
 extern cc_lookup_status_t cc_lookup_search(CC_LOOKUP, const void *, void **);
 
+/*
+ * cc_lookup_reserve:
+ *	Size the table for a given number of elements
+ *
+ * Synopsis:
+ *	cc_lookup_status_t cc_lookup_reserve(CC_LOOKUP lookup, size_t count);
+ *
+ * Arguments:
+ *   . lookup : lookup to use.
+ *   . count  : Number of elements expected.
+ *
+ * Description:
+ *	Any resizing in progress is completed and the table is enlarged at
+ *	once to count entries, so that a bulk load does not resize it. The
+ *	table does not shrink under count entries afterwards.
+ *
+ * Returns:
+ *	. CC_LOOKUP_OK     : Success.
+ *	. CC_LOOKUP_SYSERR : Memory allocation failed.
+ *
+ * cc_lookup_autoshrink:
+ *	Enable (non zero) or disable (0, the default) the shrinking of the
+ *	table to half its size when less than 1/8 of its entries are used.
+ *	The table never shrinks under its initial or reserved size.
+ *
+ * cc_lookup_count:
+ *	Number of elements of the table.
+ */
+
+extern cc_lookup_status_t cc_lookup_reserve   (CC_LOOKUP, size_t);
+extern void               cc_lookup_autoshrink(CC_LOOKUP, int);
+extern size_t             cc_lookup_count     (CC_LOOKUP);
+
+/*
+ * cc_lookup_bulk_add:
+ *	Add many elements
+ *
+ * Synopsis:
+ *	cc_lookup_status_t cc_lookup_bulk_add(CC_LOOKUP lookup, const void **keys, void **data, size_t count);
+ *
+ * Description:
+ *	Add the elements (keys[i], data[i]) for i in [0, count[. The table
+ *	is first sized for them (see cc_lookup_reserve). The keys are
+ *	hashed ahead of their insertion and, if the table is not a
+ *	concurrent one, the head of their bucket is prefetched, so that
+ *	the memory accesses of several insertions overlap.
+ *
+ * Returns:
+ *	. CC_LOOKUP_OK     : Every element has been added.
+ *	. CC_LOOKUP_DUPKEY : Some keys were already present and have been
+ *	                     skipped, the other elements are added.
+ *	. CC_LOOKUP_SYSERR : Memory allocation failed, the elements before
+ *	                     the failing one are added.
+ */
+
+extern cc_lookup_status_t cc_lookup_bulk_add(CC_LOOKUP, const void **, void **, size_t);
+
+/*
+ * cc_lookup_cursor_open:
+ *	Start an iteration on the table, returning NULL if memory is
+ *	lacking.
+ *
+ * cc_lookup_cursor_next:
+ *	Return the next element in *key and *data (if not NULL).
+ *	Returns CC_LOOKUP_OK, CC_LOOKUP_NOENT at the end of the table or
+ *	CC_LOOKUP_SYSERR.
+ *
+ * cc_lookup_cursor_close:
+ *	End the iteration.
+ *
+ * Description:
+ *	The elements present during the whole iteration are returned once.
+ *	Elements may be added or deleted meanwhile, from the iterating
+ *	thread or from other ones : they are returned or not. The table is
+ *	not resized while a cursor is open (cc_lookup_reserve only records
+ *	the size), so long iterations should not be left open.
+ */
+
+extern CC_LOOKUP_CURSOR   cc_lookup_cursor_open (CC_LOOKUP);
+extern cc_lookup_status_t cc_lookup_cursor_next (CC_LOOKUP_CURSOR, const void **, void **);
+extern void               cc_lookup_cursor_close(CC_LOOKUP_CURSOR);
+
+/*
+ * cc_lookup_snapshot:
+ *	Copy the elements of the table
+ *
+ * Synopsis:
+ *	cc_lookup_status_t cc_lookup_snapshot(CC_LOOKUP lookup, cc_lookup_pair_t **pairs, size_t *count);
+ *
+ * Description:
+ *	Return in *pairs an array of the *count (key, data) of the table,
+ *	to be freed by cc_free. Every shard is locked during the copy, so
+ *	that the array is the content of the table at one point in time.
+ *
+ * Returns:
+ *	CC_LOOKUP_OK or CC_LOOKUP_SYSERR.
+ */
+
+extern cc_lookup_status_t cc_lookup_snapshot(CC_LOOKUP, cc_lookup_pair_t **, size_t *);
+
+/*
+ * cc_lookup_synchronize:
+ *	Wait until the cc_lookup_search running on CC_LOOKUP_LOCK_RCU
+ *	tables when it is called have returned : the keys and data of
+ *	the entries deleted before the call are no longer used by them.
+ *	It must not be called by a comparator or a hasher.
+ */
+
+extern void               cc_lookup_synchronize(void);
+
 #endif /* ! __CC_LOOKUP_H__ */
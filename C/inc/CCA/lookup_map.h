@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2026
+ *     Christian CAMIER <christian.c at promethee dot services>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __CC_LOOKUP_MAP_H__
+#define __CC_LOOKUP_MAP_H__
+
+/*
+ * Read only lookup tables stored in a file.
+ *
+ * The file holds a header, an open addressing index and the records.
+ * Records are referenced by their offset, never by an address, and
+ * hold the key and the data inline, so that the file is searched
+ * directly once mapped in memory, without being read or parsed.
+ *
+ * The keys are hashed by cc_hash64 (see CCA/hash.h) and compared as
+ * bytes. Files are in the byte order of the machine writing them, and
+ * are rejected by machines of the other one.
+ */
+
+#include <CCA/hashtable.h>
+#include <CCA/lookup.h>
+
+#ifdef __CC_LOOKUP_MAP_INTERNAL__
+struct lookup_map_st;
+typedef struct lookup_map_st *CC_LOOKUP_MAP;
+#else
+typedef void *CC_LOOKUP_MAP;
+#endif
+
+/*
+ * Bytes of a key or of a data : returns their length and sets *bytes
+ * to them.
+ */
+typedef size_t (*cc_lookup_map_dump_t)(const void *, const void **);
+
+/* Flags of cc_lookup_map_open */
+#define CC_LOOKUP_MAP_POPULATE	0x0001	/* Read the whole file at once */
+
+/*
+ * cc_lookup_map_build:
+ *	Write a lookup table in a file
+ *
+ * Synopsis:
+ *	int cc_lookup_map_build          (const char *path, CC_LOOKUP lookup,
+ *	                                  cc_lookup_map_dump_t kdump, cc_lookup_map_dump_t ddump);
+ *	int cc_lookup_map_build_hashtable(const char *path, CC_HASHTABLE hashtable,
+ *	                                  cc_lookup_map_dump_t kdump, cc_lookup_map_dump_t ddump);
+ *	int cc_lookup_map_write          (const char *path, const cc_lookup_pair_t *pairs, size_t count,
+ *	                                  cc_lookup_map_dump_t kdump, cc_lookup_map_dump_t ddump);
+ *
+ * Arguments:
+ *  . path:
+ *	File to write. It is written under path.tmp then renamed, so that
+ *	a file being mapped is never modified.
+ *  . lookup, hashtable, pairs and count:
+ *	Elements to write : the ones of a snapshot of the lookup table,
+ *	the elements of the hashtable (their data is the element, given
+ *	to ddump as a CC_HASHTABLE_HDR), or the count given pairs.
+ *  . kdump, ddump:
+ *	Functions giving the bytes to store for a key and for a data.
+ *	If NULL, keys and data are NUL terminated strings, except for
+ *	the data of cc_lookup_map_build_hashtable, whose ddump is
+ *	required.
+ *
+ * Returns:
+ *	0 on success, -1 with errno set if an error occurs (EINVAL if a
+ *	key or data is 4 GB or more, or if cc_lookup_map_build_hashtable
+ *	is given no ddump).
+ */
+
+extern int cc_lookup_map_build          (const char *, CC_LOOKUP,    cc_lookup_map_dump_t, cc_lookup_map_dump_t);
+extern int cc_lookup_map_build_hashtable(const char *, CC_HASHTABLE, cc_lookup_map_dump_t, cc_lookup_map_dump_t);
+extern int cc_lookup_map_write          (const char *, const cc_lookup_pair_t *, size_t, cc_lookup_map_dump_t, cc_lookup_map_dump_t);
+
+/*
+ * cc_lookup_map_open:
+ *	Map a file written by cc_lookup_map_build
+ *
+ * Synopsis:
+ *	CC_LOOKUP_MAP cc_lookup_map_open(const char *path, int flags);
+ *
+ * Arguments:
+ *  . path  : File to map.
+ *  . flags : 0 or CC_LOOKUP_MAP_POPULATE to read the file at once
+ *	      instead of at the first searches.
+ *
+ * Returns:
+ *	The map, or NULL with errno set (EINVAL if the file is not a valid
+ *	one).
+ *
+ * cc_lookup_map_close:
+ *	Unmap the file.
+ *
+ * cc_lookup_map_count:
+ *	Number of elements of the map.
+ */
+
+extern CC_LOOKUP_MAP cc_lookup_map_open (const char *, int);
+extern void          cc_lookup_map_close(CC_LOOKUP_MAP);
+extern size_t        cc_lookup_map_count(CC_LOOKUP_MAP);
+
+/*
+ * cc_lookup_map_search:
+ *	Search the key of `klen' bytes, returning in *data and *dlen (if
+ *	not NULL) the data stored for it. The data points in the mapping,
+ *	is followed by a NUL byte and is aligned on 8 bytes when the key
+ *	length is a multiple of 8 minus 1 : strlen(key) for the keys
+ *	written by the default kdump.
+ *	Maps are read only : any number of threads may search them.
+ *
+ * cc_lookup_map_search_str:
+ *	Same, for a NUL terminated key written by the default kdump.
+ *
+ * Returns:
+ *	. CC_LOOKUP_OK    : Key found.
+ *	. CC_LOOKUP_NOENT : Key not found.
+ */
+
+extern cc_lookup_status_t cc_lookup_map_search    (CC_LOOKUP_MAP, const void *, size_t, const void **, size_t *);
+extern cc_lookup_status_t cc_lookup_map_search_str(CC_LOOKUP_MAP, const char *, const char **);
+
+#endif /* ! __CC_LOOKUP_MAP_H__ */
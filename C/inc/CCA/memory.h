@@ -68,12 +68,17 @@
 
 /*
  * Functions defined in cc_memory.c
+ *
+ * Blocks of cc_malloc, cc_calloc and cc_realloc are zeroed, and wiped
+ * by cc_free. cc_memwipe (and cc_memclr) zero an area with stores the
+ * compiler cannot drop, for memory holding secrets.
  */
 extern void *cc_calloc(size_t, size_t);
 extern void  cc_free(void *);
 extern void *cc_malloc(size_t);
 extern void  cc_memclr(void *, size_t);
 extern void *cc_memdup(const void *, size_t);
+extern void  cc_memwipe(void *, size_t);
 extern void *cc_realloc(void *, size_t);
 extern char *cc_strdup(const char *);
 
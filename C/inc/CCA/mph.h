@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026
+ *     Christian CAMIER <christian.c at promethee dot services>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __CC_MPH_H__
+#define __CC_MPH_H__
+
+/*
+ * Minimal perfect hash of a static set of keys (CHD algorithm).
+ *
+ * cc_mph_index maps each of the n keys of the set to its own index in
+ * [0, n[, so that the set can be stored in an array of n entries in
+ * that order. Any other key is mapped to some index too : the caller
+ * compares it with the key of the entry, so that a search costs one
+ * hash and one compare.
+ *
+ * The keys are spread over about n / 4 buckets. Each bucket holds a
+ * displacement pair (d0, d1) chosen at build time so that the keys of
+ * the bucket land on free indexes : index = (f1 + d0 * f2 + d1) mod n,
+ * where the bucket, f1 and f2 come from one cc_hash64 of the key.
+ *
+ * The structure holds no pointer but mp_disp, so that cc_mph_emit can
+ * write it as C code for tables known at compile time.
+ */
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define CC_MPH_ICASE	0x0001	/* Keys compare in any ASCII case    */
+#define CC_MPH_ICASE_MAX	64	/* Longest key of a CC_MPH_ICASE set */
+
+typedef struct cc_mph_st {
+	uint64_t        mp_seed;	/* Seed of cc_hash64                */
+	uint32_t        mp_count;	/* Number of keys                   */
+	uint32_t        mp_nbucket;	/* Number of buckets                */
+	uint32_t        mp_maxlen;	/* Length of the longest key        */
+	uint32_t        mp_flags;
+	const uint32_t *mp_disp;	/* d0, d1 of each bucket            */
+} cc_mph_t;
+
+/*
+ * cc_mph_build:
+ *	Build the perfect hash of a set of keys
+ *
+ * Synopsis:
+ *	int cc_mph_build(cc_mph_t *mph, const void *const *keys, const size_t *lens, size_t count, int flags);
+ *
+ * Arguments:
+ *  . mph:
+ *	Structure to fill. mp_disp is allocated, to be released by
+ *	cc_mph_free.
+ *  . keys, lens, count:
+ *	The count keys of the set and their lengths. If lens is NULL,
+ *	keys are NUL terminated strings.
+ *  . flags:
+ *	0 or CC_MPH_ICASE : keys are hashed in upper case, so that the
+ *	index of a key does not depend on its case. Keys are then at most
+ *	CC_MPH_ICASE_MAX bytes long.
+ *
+ * Returns:
+ *	0 on success, -1 with errno set if an error occurs : EINVAL if a
+ *	key is duplicated or too long, EAGAIN if no displacement was found
+ *	(never seen with keys hashing well), ENOMEM.
+ */
+
+extern int      cc_mph_build(cc_mph_t *, const void *const *, const size_t *, size_t, int);
+extern void     cc_mph_free (cc_mph_t *);
+
+/*
+ * cc_mph_index:
+ *	Index of a key, in [0, mp_count[ for the keys of the set. Returns
+ *	mp_count for keys that cannot be in the set (empty set, key longer
+ *	than all of them).
+ *
+ * cc_mph_index_str:
+ *	Same, for a NUL terminated key.
+ */
+
+extern uint32_t cc_mph_index    (const cc_mph_t *, const void *, size_t);
+extern uint32_t cc_mph_index_str(const cc_mph_t *, const char *);
+
+/*
+ * cc_mph_emit:
+ *	Write the C code of a perfect hash
+ *
+ * Synopsis:
+ *	int cc_mph_emit(FILE *out, const cc_mph_t *mph, const char *name,
+ *	                const void *const *keys, const size_t *lens,
+ *	                const char *type, const char *const *inits);
+ *
+ * Description:
+ *	Write, after a comment telling they are generated, the
+ *	definitions of
+ *		static const uint32_t name_disp[];
+ *		static const cc_mph_t name_mph;
+ *		static const type     name[];
+ *	the entries of name[] being the initializers inits[i] of the keys
+ *	(given in the order of keys), written in the order of their index.
+ *	If inits is NULL, the keys are written as string literals and type
+ *	should be "char *const". The cc_mphgen tool (C/tools) calls it on
+ *	the keys of a file.
+ *
+ * Returns:
+ *	0 on success, -1 with errno set if a write fails.
+ */
+
+extern int      cc_mph_emit(FILE *, const cc_mph_t *, const char *, const void *const *, const size_t *, const char *, const char *const *);
+
+#endif /* ! __CC_MPH_H__ */
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026
+ *     Christian CAMIER <christian.c at promethee dot services>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __CC_POOL_H__
+#define __CC_POOL_H__
+
+/*
+ * Pools of fixed size objects.
+ *
+ * Objects are carved from slabs, so that objects allocated together are
+ * close in memory, and cached by magazines of CC_POOL_MAGAZINE objects.
+ * Each thread keeps a loaded and a previous magazine per pool : most
+ * allocations and releases only touch them. When both are exhausted,
+ * full and empty magazines are exchanged with the depot of the pool,
+ * two lock free stacks. A lock is only taken to carve a new slab.
+ *
+ * Objects can be released by any thread. Slabs are only given back to
+ * the system by cc_pool_destroy.
+ *
+ * At most CC_POOL_MAX pools exist at the same time.
+ */
+
+#include <stddef.h>
+
+#ifdef __CC_POOL_INTERNAL__
+struct pool_st;
+typedef struct pool_st *CC_POOL;
+#else
+typedef void *CC_POOL;
+#endif
+
+#define CC_POOL_MAX		64	/* Pools at the same time           */
+#define CC_POOL_MAGAZINE	32	/* Objects by magazine              */
+#define CC_POOL_ALIGN		16	/* Default alignment of the objects */
+
+typedef struct cc_pool_stats_st {
+	size_t ps_size;		/* Size of the objects, rounded to their alignment */
+	size_t ps_slabs;	/* Slabs carved                                   */
+	size_t ps_objects;	/* Objects carved from the slabs                  */
+	size_t ps_depot;	/* Free objects in the depot                      */
+	size_t ps_exchanges;	/* Magazines exchanged with the depot             */
+} cc_pool_stats_t;
+
+/*
+ * cc_pool_create:
+ *	Create a pool
+ *
+ * Synopsis:
+ *	CC_POOL cc_pool_create(size_t size, size_t align, size_t slab);
+ *
+ * Arguments:
+ *  . size:
+ *	Size of the objects.
+ *  . align:
+ *	Alignment of the objects, a power of two, 0 for CC_POOL_ALIGN.
+ *  . slab:
+ *	Objects carved at once, rounded to a multiple of CC_POOL_MAGAZINE,
+ *	0 for the default (4 magazines).
+ *
+ * Returns:
+ *	A pool, or NULL with errno set (EINVAL, ENOMEM, or EAGAIN when
+ *	CC_POOL_MAX pools exist).
+ *
+ * cc_pool_destroy:
+ *	Release the pool and all of its objects. No thread may use the
+ *	pool any more.
+ */
+
+extern CC_POOL cc_pool_create (size_t, size_t, size_t);
+extern void    cc_pool_destroy(CC_POOL);
+
+/*
+ * cc_pool_alloc:
+ *	Allocate an object. Its content is undefined.
+ *
+ * cc_pool_free:
+ *	Release an object of the pool.
+ *
+ * Returns:
+ *	The object, or NULL if the memory is exhausted.
+ */
+
+extern void   *cc_pool_alloc  (CC_POOL);
+extern void    cc_pool_free   (CC_POOL, void *);
+
+/*
+ * cc_pool_stats:
+ *	Fill *stats with the counters of the pool. The objects in use are
+ *	ps_objects - ps_depot minus the ones cached by the threads.
+ */
+
+extern void    cc_pool_stats  (CC_POOL, cc_pool_stats_t *);
+
+#endif /* ! __CC_POOL_H__ */
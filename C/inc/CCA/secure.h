@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026
+ *     Christian CAMIER <christian.c at promethee dot services>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __CC_SECURE_H__
+#define __CC_SECURE_H__
+
+/*
+ * Memory for secrets (keys, passwords, PRNG states).
+ *
+ * Blocks are carved from regions mapped with mmap, locked in memory so
+ * that they are never written to swap, excluded from core dumps
+ * (MADV_DONTDUMP where available), and surrounded by two inaccessible
+ * guard pages. A region of CC_SECURE_REGION bytes is shared by many
+ * blocks, so that mlock is called once per region and not per block.
+ * Blocks larger than a quarter of a region get a region of their own,
+ * returned to the system when freed.
+ *
+ * When the lock fails (RLIMIT_MEMLOCK reached), the region is used
+ * unlocked : cc_secure_stats tells how many bytes are not locked.
+ *
+ * All the functions are thread safe.
+ */
+
+#include <stddef.h>
+
+#define CC_SECURE_REGION	(64 * 1024)	/* Bytes of a shared region  */
+#define CC_SECURE_ALIGN		16		/* Alignment of the blocks   */
+
+typedef struct cc_secure_stats_st {
+	size_t ss_regions;	/* Regions mapped                          */
+	size_t ss_mapped;	/* Bytes of the regions, guards excluded   */
+	size_t ss_unlocked;	/* Bytes of the regions mlock refused      */
+	size_t ss_used;		/* Bytes of the blocks in use              */
+} cc_secure_stats_t;
+
+/*
+ * cc_secure_alloc:
+ *	Allocate a block of secure memory
+ *
+ * Synopsis:
+ *	void *cc_secure_alloc(size_t size);
+ *
+ * Returns:
+ *	A zeroed block aligned on CC_SECURE_ALIGN bytes, or NULL with
+ *	errno set if the memory is exhausted.
+ *
+ * cc_secure_free:
+ *	Wipe the block (see cc_memwipe) and release it. NULL is ignored.
+ *
+ * cc_secure_stats:
+ *	Fill *stats with the counters of the secure memory.
+ */
+
+extern void *cc_secure_alloc(size_t);
+extern void  cc_secure_free (void *);
+extern void  cc_secure_stats(cc_secure_stats_t *);
+
+#endif /* ! __CC_SECURE_H__ */
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026
+ *     Christian CAMIER <christian.c at promethee dot services>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __CC_SWISSTABLE_H__
+#define __CC_SWISSTABLE_H__
+
+/*
+ * Open addressing hash table ("Swiss table").
+ *
+ * Entries (key, data) are stored in a flat array of slots. A parallel
+ * array holds one control byte per slot : empty, deleted, or 7 bits of
+ * the key hash. A lookup reads a group of 16 control bytes (8 without
+ * SSE2), keeps the slots whose byte matches the hash, and only calls
+ * the comparator on them. The capacity is a power of two and the table
+ * grows when it is 7/8 full.
+ *
+ * A table is not thread safe : concurrent accesses must be serialized
+ * by the caller.
+ */
+
+#ifdef __CC_SWISSTABLE_INTERNAL__
+struct swiss_table_st;
+typedef struct swiss_table_st *CC_SWISSTABLE;
+#else
+typedef void *CC_SWISSTABLE;
+#endif
+
+typedef enum cc_swisstable_status_en {
+	CC_SWISSTABLE_SYSERR	= -1, /* System error    */
+	CC_SWISSTABLE_OK	= 0,  /* No error        */
+	CC_SWISSTABLE_NOENT,	      /* Entry not found */
+	CC_SWISSTABLE_DUPKEY	      /* Duplicate key   */
+} cc_swisstable_status_t;
+
+typedef int      (*cc_swisstable_comp_t)(const void *, const void *);
+typedef uint64_t (*cc_swisstable_hash_t)(const void *);
+typedef void     (*cc_swisstable_free_t)(const void *);
+
+/*
+ * cc_swisstable_create:
+ *	Create a table
+ *
+ * Synopsis:
+ *	CC_SWISSTABLE cc_swisstable_create(size_t size, cc_swisstable_comp_t comparator,
+ *	                                   cc_swisstable_hash_t hasher, cc_swisstable_free_t destructor);
+ *
+ * Arguments:
+ *  . size:
+ *      Number of entries expected. The table grows beyond it if needed.
+ *  . comparator:
+ *      Comparator function, returning 0 for equal keys.
+ *	If comparator is NULL, defaul function will be "strcmp".
+ *  . hasher:
+ *      Hash function.
+ *	If hasher is NULL, default function will be "cc_hash64_key"
+ *	(see CCA/hash.h).
+ *  . destructor:
+ *	Function called on the data of deleted entries (NULL if none).
+ *
+ * Returns:
+ *	A table or NULL if an error occurs.
+ */
+
+extern CC_SWISSTABLE cc_swisstable_create (size_t, cc_swisstable_comp_t, cc_swisstable_hash_t, cc_swisstable_free_t);
+extern void          cc_swisstable_destroy(CC_SWISSTABLE);
+
+/*
+ * cc_swisstable_add:
+ *	Add the entry (key, data). The key is referenced, not copied.
+ *
+ * cc_swisstable_del:
+ *	Remove the entry of key, returning its data in *deleted (if not
+ *	NULL) before calling the destructor on it.
+ *
+ * cc_swisstable_search:
+ *	Return in *returned (if not NULL) the data of the entry of key.
+ *
+ * cc_swisstable_count:
+ *	Number of entries.
+ *
+ * Returns:
+ *	. CC_SWISSTABLE_OK     : Success.
+ *	. CC_SWISSTABLE_NOENT  : Key not found (del, search).
+ *	. CC_SWISSTABLE_DUPKEY : Duplicate key (add).
+ *	. CC_SWISSTABLE_SYSERR : Memory allocation failed (add).
+ */
+
+extern cc_swisstable_status_t cc_swisstable_add   (CC_SWISSTABLE, const void *, void  *);
+extern cc_swisstable_status_t cc_swisstable_del   (CC_SWISSTABLE, const void *, void **);
+extern cc_swisstable_status_t cc_swisstable_search(CC_SWISSTABLE, const void *, void **);
+extern size_t                 cc_swisstable_count (CC_SWISSTABLE);
+
+#endif /* ! __CC_SWISSTABLE_H__ */
@@ -41,4 +41,13 @@
 
 #define CC_ARRAY_COUNT(A)	(sizeof(A) / sizeof(A[0]))
 
+/* Branch hints, for the tests of the hot paths */
+#if defined(__GNUC__)
+# define CC_LIKELY(e)		__builtin_expect(!!(e), 1)
+# define CC_UNLIKELY(e)		__builtin_expect(!!(e), 0)
+#else
+# define CC_LIKELY(e)		(e)
+# define CC_UNLIKELY(e)		(e)
+#endif
+
 #endif /*!__CC_UTIL_H__*/
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2026
+ *     Christian CAMIER <christian.c at promethee dot services>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/types.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <CCA/memory.h>
+#include <CCA/util.h>
+
+#define __CC_ARENA_INTERNAL__
+#include <CCA/arena.h>
+
+#define ARENA_CHUNK	65536
+
+/*
+ * Chunks come from malloc, not cc_malloc : the arena zeroes what it is
+ * asked to, and a length header per chunk would be of no use.
+ * The header is CC_ARENA_ALIGN bytes long so that ac_data keeps the
+ * alignment of malloc.
+ */
+struct arena_chunk_st {
+	struct arena_chunk_st *ac_next;
+	size_t                 ac_size;		/* Bytes of ac_data                 */
+	size_t                 ac_used;		/* Bytes of ac_data allocated       */
+	size_t                 ac_pad;
+	uint8_t                ac_data[];
+};
+
+struct arena_st {
+	struct arena_chunk_st *ar_chunk;	/* Current chunk, then older ones   */
+	struct arena_chunk_st *ar_large;	/* Chunks of a single block         */
+	struct arena_chunk_st *ar_spare;	/* Released chunks                  */
+	size_t                 ar_csize;
+	int                    ar_flags;
+};
+
+/* Global functions */
+extern CC_ARENA cc_arena_create (size_t, int);
+extern void     cc_arena_destroy(CC_ARENA);
+extern void    *cc_arena_alloc  (CC_ARENA, size_t);
+extern void    *cc_arena_calloc (CC_ARENA, size_t);
+extern void    *cc_arena_aligned(CC_ARENA, size_t, size_t);
+extern void    *cc_arena_memdup (CC_ARENA, const void *, size_t);
+extern char    *cc_arena_strdup (CC_ARENA, const char *);
+extern void     cc_arena_mark   (CC_ARENA, cc_arena_mark_t *);
+extern void     cc_arena_reset  (CC_ARENA, const cc_arena_mark_t *);
+extern size_t   cc_arena_used   (CC_ARENA);
+
+/* Local defined functions */
+static void    *arena_large(CC_ARENA, size_t, size_t);
+static void     arena_wipe (CC_ARENA, void *, size_t);
+
+CC_ARENA cc_arena_create(size_t csize, int flags)
+{
+	CC_ARENA arena;
+
+	if(NULL == (arena = CC_TALLOC(struct arena_st, 1)))
+		return NULL;
+	arena->ar_chunk = NULL;
+	arena->ar_large = NULL;
+	arena->ar_spare = NULL;
+	arena->ar_csize = (0 == csize) ? ARENA_CHUNK : CC_MAX(csize, 4 * CC_ARENA_ALIGN);
+	arena->ar_flags = flags;
+	return arena;
+}
+
+void cc_arena_destroy(CC_ARENA arena)
+{
+	struct arena_chunk_st *c;
+
+	cc_arena_reset(arena, NULL);
+	while(NULL != (c = arena->ar_spare))
+	{
+		arena->ar_spare = c->ac_next;
+		free(c);
+	}
+	cc_free(arena);
+	return;
+}
+
+void *cc_arena_alloc(CC_ARENA arena, size_t size)
+{
+	return cc_arena_aligned(arena, size, CC_ARENA_ALIGN);
+}
+
+void *cc_arena_calloc(CC_ARENA arena, size_t size)
+{
+	void *p;
+
+	if(NULL != (p = cc_arena_aligned(arena, size, CC_ARENA_ALIGN)))
+		memset(p, 0, size);
+	return p;
+}
+
+void *cc_arena_aligned(CC_ARENA arena, size_t size, size_t align)
+{
+	struct arena_chunk_st *c;
+	uintptr_t              p;
+	size_t                 off;
+
+	if(0 == align || 0 != (align & (align - 1)))
+	{
+		errno = EINVAL;
+		return NULL;
+	}
+	if(NULL != (c = arena->ar_chunk))
+	{
+		p   = ((uintptr_t)(c->ac_data + c->ac_used) + align - 1) & ~(uintptr_t)(align - 1);
+		off = p - (uintptr_t)c->ac_data;
+		if(off <= c->ac_size && size <= c->ac_size - off)
+		{
+			c->ac_used = off + size;
+			return (void *)p;
+		}
+	}
+
+	if(size > arena->ar_csize / 4 || align > arena->ar_csize / 4)
+		return arena_large(arena, size, align);
+
+	/*
+	 * The rest of the current chunk is left unused : it is smaller
+	 * than a quarter of a chunk.
+	 */
+	if(NULL != (c = arena->ar_spare))
+		arena->ar_spare = c->ac_next;
+	else if(NULL == (c = (struct arena_chunk_st *)malloc(sizeof(*c) + arena->ar_csize)))
+		return NULL;
+	else
+		c->ac_size = arena->ar_csize;
+	c->ac_used      = 0;
+	c->ac_next      = arena->ar_chunk;
+	arena->ar_chunk = c;
+
+	p = ((uintptr_t)c->ac_data + align - 1) & ~(uintptr_t)(align - 1);
+	c->ac_used = p - (uintptr_t)c->ac_data + size;
+	return (void *)p;
+}
+
+void *cc_arena_memdup(CC_ARENA arena, const void *data, size_t size)
+{
+	void *p;
+
+	if(NULL != (p = cc_arena_aligned(arena, size, 1)))
+		memcpy(p, data, size);
+	return p;
+}
+
+char *cc_arena_strdup(CC_ARENA arena, const char *string)
+{
+	return (char *)cc_arena_memdup(arena, string, strlen(string) + 1);
+}
+
+void cc_arena_mark(CC_ARENA arena, cc_arena_mark_t *mark)
+{
+	mark->am_chunk = arena->ar_chunk;
+	mark->am_used  = arena->ar_chunk ? arena->ar_chunk->ac_used : 0;
+	mark->am_large = arena->ar_large;
+	return;
+}
+
+void cc_arena_reset(CC_ARENA arena, const cc_arena_mark_t *mark)
+{
+	static const cc_arena_mark_t empty = { NULL, 0, NULL };
+	struct arena_chunk_st       *c;
+
+	if(NULL == mark)
+		mark = &empty;
+
+	while(mark->am_large != (c = arena->ar_large))
+	{
+		arena->ar_large = c->ac_next;
+		arena_wipe(arena, c->ac_data, c->ac_used);
+		free(c);
+	}
+	while(mark->am_chunk != (c = arena->ar_chunk))
+	{
+		arena->ar_chunk = c->ac_next;
+		arena_wipe(arena, c->ac_data, c->ac_used);
+		c->ac_next      = arena->ar_spare;
+		arena->ar_spare = c;
+	}
+	if(NULL != c)
+	{
+		arena_wipe(arena, c->ac_data + mark->am_used, c->ac_used - mark->am_used);
+		c->ac_used = mark->am_used;
+	}
+	return;
+}
+
+size_t cc_arena_used(CC_ARENA arena)
+{
+	struct arena_chunk_st *c;
+	size_t                 used;
+
+	for(used = 0, c = arena->ar_chunk; c; c = c->ac_next)
+		used += c->ac_used;
+	for(c = arena->ar_large; c; c = c->ac_next)
+		used += c->ac_used;
+	return used;
+}
+
+/*
+ * Block in a chunk of its own.
+ */
+static void *arena_large(CC_ARENA arena, size_t size, size_t align)
+{
+	struct arena_chunk_st *c;
+	uintptr_t              p;
+
+	if(size > SIZE_MAX - sizeof(*c) - align)
+	{
+		errno = ENOMEM;
+		return NULL;
+	}
+	if(NULL == (c = (struct arena_chunk_st *)malloc(sizeof(*c) + size + align - 1)))
+		return NULL;
+	p = ((uintptr_t)c->ac_data + align - 1) & ~(uintptr_t)(align - 1);
+	c->ac_size      = size + align - 1;
+	c->ac_used      = p - (uintptr_t)c->ac_data + size;
+	c->ac_next      = arena->ar_large;
+	arena->ar_large = c;
+	return (void *)p;
+}
+
+static void arena_wipe(CC_ARENA arena, void *data, size_t size)
+{
+	if(0 == (arena->ar_flags & CC_ARENA_WIPE) || 0 == size)
+		return;
+	cc_memwipe(data, size);
+	return;
+}
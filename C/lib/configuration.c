@@ -28,8 +28,10 @@
 #include <unistd.h>
 #include <glob.h>
 
+#include <CCA/arena.h>
 #include <CCA/display.h>
 #include <CCA/memory.h>
+#include <CCA/secure.h>
 #include <CCA/util.h>
 
 /* Local types */
@@ -83,6 +85,7 @@ static cc_conf_status_t  split_line     (char *, char ***, int *, char **);
 static size_t       bufsize = 1024;			  /* Buffer size    */
 static const char   ifs[] = " \t\n\r";			  /* Separators     */
 static included_t  *included_files = CC_TNULL(included_t); /* Included files */
+static CC_ARENA     included_arena = NULL;                 /* Their records  */
 
 cc_conf_status_t cc_conf_read(const char *fn, const cc_conf_kwr_t *kw, void *ud)
 {
@@ -100,7 +103,11 @@ cc_conf_status_t cc_conf_read(const char *fn, const cc_conf_kwr_t *kw, void *ud)
 	for(pi = included_files; pi; pi = pi->in_next)
 		if(pi->in_ino == fi.st_ino && pi->in_dev == fi.st_dev)
 			return CC_CONF_ST_OK;
-	if(CC_TNULL(included_t) == (pi = CC_TALLOC(included_t, 1)))
+	if(NULL == included_arena && NULL == (included_arena = cc_arena_create(sizeof(included_t) * 64, 0)))
+		pi = CC_TNULL(included_t);
+	else
+		pi = (included_t *)cc_arena_alloc(included_arena, sizeof(included_t));
+	if(CC_TNULL(included_t) == pi)
 	{
 		CC_PROTECT_ERRNO(cc_printf_err("cc_conf_read: Cannot allocate %lu bytes", sizeof(included_t)));
 		return CC_CONF_ST_SYSTEM_ERROR;
@@ -300,7 +307,8 @@ static cc_conf_status_t context_create(int fd, const cc_conf_kwr_t *kw, const ch
 		return CC_CONF_ST_SYSTEM_ERROR;
 	}
 
-	if(NULL == (ctx_new = (cc_conf_ctx_t *)cc_malloc(ctx_size)))
+	/* The buffer holds the text of the file, secrets included */
+	if(NULL == (ctx_new = (cc_conf_ctx_t *)cc_secure_alloc(ctx_size)))
 	{
 		CC_PROTECT_ERRNO(
 			cc_printf_err("context_create: Cannot allocate %lu bytes", ctx_size);
@@ -321,7 +329,7 @@ static cc_conf_status_t context_create(int fd, const cc_conf_kwr_t *kw, const ch
 static void context_destroy(cc_conf_ctx_t *ct)
 {
 	const char *fn = ct->ct_filename;
-	cc_free((void *)ct);
+	cc_secure_free((void *)ct);
 	cc_free((void *)fn);
 	return;
 }
@@ -0,0 +1,46 @@
+/*
+ * #@ "crc_accel.c"
+ *
+ * Author : Christian CAMIER (chcamier@free.fr)
+ *
+ * Runtime selection of the hardware accelerated CRC kernels.
+ *
+ * The kernels are chosen once, at library load time, from the CPU
+ * features. When none is usable the pointers stay NULL and crcFast and
+ * crcAppnd keep using the table driven code.
+ *
+ * History :
+ * ---------
+ *
+ * Oct 18, 2026: Christian CAMIER
+ *	v1.0 :	Creation
+ */
+
+#define CRC_CRC32
+#include "crc_internal.h"
+
+cc_crc32_t (*cc_crc_crc32_accel )(cc_crc32_t, const uint8_t *, size_t) = NULL;
+cc_crc32_t (*cc_crc_crc32c_accel)(cc_crc32_t, const uint8_t *, size_t) = NULL;
+
+#if defined(CRC_HAVE_X86_ACCEL)
+
+extern cc_crc32_t cc_crc_crc32_pclmul     (cc_crc32_t, const uint8_t *, size_t);
+extern cc_crc32_t cc_crc_crc32c_sse42     (cc_crc32_t, const uint8_t *, size_t);
+extern void       cc_crc_crc32c_sse42_init(void);
+
+static __attribute__((constructor)) void accel_ctor(void)
+{
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("sse4.1") && __builtin_cpu_supports("pclmul"))
+		cc_crc_crc32_accel = cc_crc_crc32_pclmul;
+
+	if (__builtin_cpu_supports("sse4.2"))
+	{
+		cc_crc_crc32c_sse42_init();
+		cc_crc_crc32c_accel = cc_crc_crc32c_sse42;
+	}
+	return;
+}
+
+#endif /* CRC_HAVE_X86_ACCEL */
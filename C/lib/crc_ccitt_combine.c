@@ -0,0 +1,10 @@
+/*
+ * #@"crc_ccitt_combine.c"
+ */
+
+#define CRC_CCITT
+
+#define crcCombine(a, b, c)	cc_ccitt_combine(a, b, c)
+
+#include "crc_combine.h"
+
@@ -0,0 +1,41 @@
+/*
+ * #@ "crc_combine.h"
+ *
+ * Author : Christian CAMIER (chcamier@free.fr)
+ *
+ * CRC of the concatenation of two messages, from the CRC of each one
+ * and the length of the second one.
+ *
+ * History :
+ * ---------
+ *
+ * Oct 18, 2026: Christian CAMIER
+ *	v1.0 :	Creation
+ */
+
+#include "crc_internal.h"
+
+/*********************************************************************
+ *
+ * Function:    crcCombine()
+ *
+ * Description: Compute the CRC of A followed by B.
+ *
+ * Notes:	crcA and crcB are the values returned by crcFast (or
+ *		crcClose) for A and B. The cost only depends on the
+ *		logarithm of lenB.
+ *
+ * Returns:	The CRC of the concatenated message.
+ *
+ *********************************************************************/
+CRC_TYPE
+crcCombine(CRC_TYPE crcA, CRC_TYPE crcB, size_t lenB)
+{
+	uint64_t op[WIDTH];
+
+	if (0 == lenB)
+		return crcA;
+
+	cc_crc_gf2_zeros(op, WIDTH, POLYNOMIAL, CRC_REFLECTED, lenB);
+	return crc_combine_op(crcA, crcB, op);
+}
@@ -0,0 +1,10 @@
+/*
+ * #@"crc_crc16_combine.c"
+ */
+
+#define CRC_CRC16
+
+#define crcCombine(a, b, c)	cc_crc16_combine(a, b, c)
+
+#include "crc_combine.h"
+
@@ -0,0 +1,10 @@
+/*
+ * #@"crc_crc32_combine.c"
+ */
+
+#define CRC_CRC32
+
+#define crcCombine(a, b, c)	cc_crc32_combine(a, b, c)
+
+#include "crc_combine.h"
+
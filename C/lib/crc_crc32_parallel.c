@@ -0,0 +1,11 @@
+/*
+ * #@"crc_crc32_parallel.c"
+ */
+
+#define CRC_CRC32
+
+#define crcFast(a, b)		cc_crc32_crcFast(a, b)
+#define crcParallel(a, b, c)	cc_crc32_parallel(a, b, c)
+
+#include "crc_parallel.h"
+
@@ -0,0 +1,178 @@
+/*
+ * #@ "crc_crc32_pclmul.c"
+ *
+ * Author : Christian CAMIER (chcamier@free.fr)
+ *
+ * CRC-32 division by folding with the carry-less multiply instruction.
+ *
+ * Reference:
+ *	V. Gopal, E. Ozturk et al., "Fast CRC Computation for Generic
+ *	Polynomials Using PCLMULQDQ Instruction", Intel, 2009.
+ *
+ * The message is folded 64 bytes at a time into four 128 bits
+ * accumulators, then 16 bytes at a time into a single one, which is
+ * finally reduced to 32 bits with a Barrett reduction. The constants
+ * are the bit-reflected ones given at the end of the paper.
+ *
+ * History :
+ * ---------
+ *
+ * Oct 18, 2026: Christian CAMIER
+ *	v1.0 :	Creation
+ */
+
+#define CRC_CRC32
+#include "crc_internal.h"
+
+#if defined(CRC_HAVE_X86_ACCEL)
+
+#include <smmintrin.h>
+#include <wmmintrin.h>
+
+extern cc_crc32_t cc_crc_crc32_pclmul(cc_crc32_t, const uint8_t *, size_t);
+
+static __attribute__((target("sse4.1,pclmul"))) cc_crc32_t fold(cc_crc32_t, const uint8_t *, size_t);
+
+/*********************************************************************
+ *
+ * Function:    cc_crc_crc32_pclmul()
+ *
+ * Description: Divide the message by the CRC-32 polynomial starting
+ *		with the given reflected remainder.
+ *
+ * Notes:	Blocks of 16 bytes are folded when the message is at
+ *		least 64 bytes long, the tail goes through the table.
+ *
+ * Returns:	The reflected remainder.
+ *
+ *********************************************************************/
+cc_crc32_t
+cc_crc_crc32_pclmul(cc_crc32_t remainder, const uint8_t *message, size_t nBytes)
+{
+	size_t folded;
+
+	if (nBytes >= 64)
+	{
+		folded     = nBytes & ~(size_t)15;
+		remainder  = fold(remainder, message, folded);
+		message   += folded;
+		nBytes    -= folded;
+	}
+
+	for (; nBytes > 0; nBytes -= 1, message += 1)
+		remainder = CRC_BYTE_STEP(remainder, *message);
+
+	return remainder;
+}
+
+/*
+ * Fold `nBytes' (a multiple of 16, at least 64) bytes.
+ */
+static __attribute__((target("sse4.1,pclmul"))) cc_crc32_t
+fold(cc_crc32_t remainder, const uint8_t *message, size_t nBytes)
+{
+	static const uint64_t __attribute__((aligned(16))) k1k2[] = { 0x0154442BD4ULL, 0x01C6E41596ULL };
+	static const uint64_t __attribute__((aligned(16))) k3k4[] = { 0x01751997D0ULL, 0x00CCAA009EULL };
+	static const uint64_t __attribute__((aligned(16))) k5k0[] = { 0x0163CD6124ULL, 0x0000000000ULL };
+	static const uint64_t __attribute__((aligned(16))) poly[] = { 0x01DB710641ULL, 0x01F7011641ULL };
+
+	__m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+	__m128i y5, y6, y7, y8;
+
+	/*
+	 * Load the first 64 bytes, and bring in the remainder.
+	 */
+	x1 = _mm_loadu_si128((const __m128i *)(message + 0x00));
+	x2 = _mm_loadu_si128((const __m128i *)(message + 0x10));
+	x3 = _mm_loadu_si128((const __m128i *)(message + 0x20));
+	x4 = _mm_loadu_si128((const __m128i *)(message + 0x30));
+	x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)remainder));
+
+	x0 = _mm_load_si128((const __m128i *)k1k2);
+	message += 64;
+	nBytes  -= 64;
+
+	/*
+	 * Fold 64 bytes at a time.
+	 */
+	for (; nBytes >= 64; nBytes -= 64, message += 64)
+	{
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+		x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+		x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+		x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+		x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+		y5 = _mm_loadu_si128((const __m128i *)(message + 0x00));
+		y6 = _mm_loadu_si128((const __m128i *)(message + 0x10));
+		y7 = _mm_loadu_si128((const __m128i *)(message + 0x20));
+		y8 = _mm_loadu_si128((const __m128i *)(message + 0x30));
+
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+		x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+		x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+		x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+	}
+
+	/*
+	 * Fold the four accumulators into one.
+	 */
+	x0 = _mm_load_si128((const __m128i *)k3k4);
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+	/*
+	 * Fold 16 bytes at a time.
+	 */
+	for (; nBytes >= 16; nBytes -= 16, message += 16)
+	{
+		x2 = _mm_loadu_si128((const __m128i *)message);
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+	}
+
+	/*
+	 * Fold 128 bits to 64 bits.
+	 */
+	x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+	x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+	x1 = _mm_srli_si128(x1, 8);
+	x1 = _mm_xor_si128(x1, x2);
+
+	x0 = _mm_loadl_epi64((const __m128i *)k5k0);
+
+	x2 = _mm_srli_si128(x1, 4);
+	x1 = _mm_and_si128(x1, x3);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	/*
+	 * Barrett reduction to 32 bits.
+	 */
+	x0 = _mm_load_si128((const __m128i *)poly);
+
+	x2 = _mm_and_si128(x1, x3);
+	x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+	x2 = _mm_and_si128(x2, x3);
+	x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	return (cc_crc32_t)_mm_extract_epi32(x1, 1);
+}
+
+#endif /* CRC_HAVE_X86_ACCEL */
@@ -0,0 +1,10 @@
+/*
+ * #@"crc_crc32c_combine.c"
+ */
+
+#define CRC_CRC32C
+
+#define crcCombine(a, b, c)	cc_crc32c_combine(a, b, c)
+
+#include "crc_combine.h"
+
@@ -0,0 +1,12 @@
+/*
+ * #@"crc_crc32c_cumul.c"
+ */
+
+#define CRC_CRC32C
+
+#define crcStart(a)		cc_crc32c_crcStart(a)
+#define crcAppnd(a, b, c)	cc_crc32c_crcAppnd(a, b, c)
+#define crcClose(a)		cc_crc32c_crcClose(a)
+
+#include "crc_cumul.h"
+
@@ -0,0 +1,10 @@
+/*
+ * #@"crc_crc32c_fast.c"
+ */
+
+#define CRC_CRC32C
+
+#define crcFast(a, b) cc_crc32c_crcFast(a, b)
+
+#include "crc_fast.h"
+
@@ -0,0 +1,11 @@
+/*
+ * #@"crc_crc32c_parallel.c"
+ */
+
+#define CRC_CRC32C
+
+#define crcFast(a, b)		cc_crc32c_crcFast(a, b)
+#define crcParallel(a, b, c)	cc_crc32c_parallel(a, b, c)
+
+#include "crc_parallel.h"
+
@@ -0,0 +1,893 @@
+/*
+ * #@ "crc_crc32c_slice.c"
+ *
+ * Author : Christian CAMIER (chcamier@free.fr)
+ *
+ * Slicing-by-8/16 tables for the CRC-32C (Castagnoli) family.
+ *
+ * These tables work on the reflected (LSB first) remainder, so they are
+ * built from the reflected polynomial 0x82F63B78. Table 0 is the classic
+ * byte-at-a-time table; table K gives the contribution of a byte which
+ * is followed by K other bytes:
+ *
+ *	T[0][n] = reflected byte division of n
+ *	T[K][n] = (T[K - 1][n] >> 8) ^ T[0][T[K - 1][n] & 0xFF]
+ *
+ * History :
+ * ---------
+ *
+ * Oct 18, 2026: Christian CAMIER
+ *	v1.0 :	Creation
+ */
+
+#define CRC_CRC32C
+#include "crc_internal.h"
+
+extern cc_crc32_t const cc_crc_crc32c_slice[16][256];
+
+cc_crc32_t const cc_crc_crc32c_slice[16][256] = {
+	{
+		0x00000000, 0xF26B8303, 0xE13B70F7, 0x1350F3F4, 0xC79A971F,
+		0x35F1141C, 0x26A1E7E8, 0xD4CA64EB, 0x8AD958CF, 0x78B2DBCC,
+		0x6BE22838, 0x9989AB3B, 0x4D43CFD0, 0xBF284CD3, 0xAC78BF27,
+		0x5E133C24, 0x105EC76F, 0xE235446C, 0xF165B798, 0x030E349B,
+		0xD7C45070, 0x25AFD373, 0x36FF2087, 0xC494A384, 0x9A879FA0,
+		0x68EC1CA3, 0x7BBCEF57, 0x89D76C54, 0x5D1D08BF, 0xAF768BBC,
+		0xBC267848, 0x4E4DFB4B, 0x20BD8EDE, 0xD2D60DDD, 0xC186FE29,
+		0x33ED7D2A, 0xE72719C1, 0x154C9AC2, 0x061C6936, 0xF477EA35,
+		0xAA64D611, 0x580F5512, 0x4B5FA6E6, 0xB93425E5, 0x6DFE410E,
+		0x9F95C20D, 0x8CC531F9, 0x7EAEB2FA, 0x30E349B1, 0xC288CAB2,
+		0xD1D83946, 0x23B3BA45, 0xF779DEAE, 0x05125DAD, 0x1642AE59,
+		0xE4292D5A, 0xBA3A117E, 0x4851927D, 0x5B016189, 0xA96AE28A,
+		0x7DA08661, 0x8FCB0562, 0x9C9BF696, 0x6EF07595, 0x417B1DBC,
+		0xB3109EBF, 0xA0406D4B, 0x522BEE48, 0x86E18AA3, 0x748A09A0,
+		0x67DAFA54, 0x95B17957, 0xCBA24573, 0x39C9C670, 0x2A993584,
+		0xD8F2B687, 0x0C38D26C, 0xFE53516F, 0xED03A29B, 0x1F682198,
+		0x5125DAD3, 0xA34E59D0, 0xB01EAA24, 0x42752927, 0x96BF4DCC,
+		0x64D4CECF, 0x77843D3B, 0x85EFBE38, 0xDBFC821C, 0x2997011F,
+		0x3AC7F2EB, 0xC8AC71E8, 0x1C661503, 0xEE0D9600, 0xFD5D65F4,
+		0x0F36E6F7, 0x61C69362, 0x93AD1061, 0x80FDE395, 0x72966096,
+		0xA65C047D, 0x5437877E, 0x4767748A, 0xB50CF789, 0xEB1FCBAD,
+		0x197448AE, 0x0A24BB5A, 0xF84F3859, 0x2C855CB2, 0xDEEEDFB1,
+		0xCDBE2C45, 0x3FD5AF46, 0x7198540D, 0x83F3D70E, 0x90A324FA,
+		0x62C8A7F9, 0xB602C312, 0x44694011, 0x5739B3E5, 0xA55230E6,
+		0xFB410CC2, 0x092A8FC1, 0x1A7A7C35, 0xE811FF36, 0x3CDB9BDD,
+		0xCEB018DE, 0xDDE0EB2A, 0x2F8B6829, 0x82F63B78, 0x709DB87B,
+		0x63CD4B8F, 0x91A6C88C, 0x456CAC67, 0xB7072F64, 0xA457DC90,
+		0x563C5F93, 0x082F63B7, 0xFA44E0B4, 0xE9141340, 0x1B7F9043,
+		0xCFB5F4A8, 0x3DDE77AB, 0x2E8E845F, 0xDCE5075C, 0x92A8FC17,
+		0x60C37F14, 0x73938CE0, 0x81F80FE3, 0x55326B08, 0xA759E80B,
+		0xB4091BFF, 0x466298FC, 0x1871A4D8, 0xEA1A27DB, 0xF94AD42F,
+		0x0B21572C, 0xDFEB33C7, 0x2D80B0C4, 0x3ED04330, 0xCCBBC033,
+		0xA24BB5A6, 0x502036A5, 0x4370C551, 0xB11B4652, 0x65D122B9,
+		0x97BAA1BA, 0x84EA524E, 0x7681D14D, 0x2892ED69, 0xDAF96E6A,
+		0xC9A99D9E, 0x3BC21E9D, 0xEF087A76, 0x1D63F975, 0x0E330A81,
+		0xFC588982, 0xB21572C9, 0x407EF1CA, 0x532E023E, 0xA145813D,
+		0x758FE5D6, 0x87E466D5, 0x94B49521, 0x66DF1622, 0x38CC2A06,
+		0xCAA7A905, 0xD9F75AF1, 0x2B9CD9F2, 0xFF56BD19, 0x0D3D3E1A,
+		0x1E6DCDEE, 0xEC064EED, 0xC38D26C4, 0x31E6A5C7, 0x22B65633,
+		0xD0DDD530, 0x0417B1DB, 0xF67C32D8, 0xE52CC12C, 0x1747422F,
+		0x49547E0B, 0xBB3FFD08, 0xA86F0EFC, 0x5A048DFF, 0x8ECEE914,
+		0x7CA56A17, 0x6FF599E3, 0x9D9E1AE0, 0xD3D3E1AB, 0x21B862A8,
+		0x32E8915C, 0xC083125F, 0x144976B4, 0xE622F5B7, 0xF5720643,
+		0x07198540, 0x590AB964, 0xAB613A67, 0xB831C993, 0x4A5A4A90,
+		0x9E902E7B, 0x6CFBAD78, 0x7FAB5E8C, 0x8DC0DD8F, 0xE330A81A,
+		0x115B2B19, 0x020BD8ED, 0xF0605BEE, 0x24AA3F05, 0xD6C1BC06,
+		0xC5914FF2, 0x37FACCF1, 0x69E9F0D5, 0x9B8273D6, 0x88D28022,
+		0x7AB90321, 0xAE7367CA, 0x5C18E4C9, 0x4F48173D, 0xBD23943E,
+		0xF36E6F75, 0x0105EC76, 0x12551F82, 0xE03E9C81, 0x34F4F86A,
+		0xC69F7B69, 0xD5CF889D, 0x27A40B9E, 0x79B737BA, 0x8BDCB4B9,
+		0x988C474D, 0x6AE7C44E, 0xBE2DA0A5, 0x4C4623A6, 0x5F16D052,
+		0xAD7D5351,
+	},
+	{
+		0x00000000, 0x13A29877, 0x274530EE, 0x34E7A899, 0x4E8A61DC,
+		0x5D28F9AB, 0x69CF5132, 0x7A6DC945, 0x9D14C3B8, 0x8EB65BCF,
+		0xBA51F356, 0xA9F36B21, 0xD39EA264, 0xC03C3A13, 0xF4DB928A,
+		0xE7790AFD, 0x3FC5F181, 0x2C6769F6, 0x1880C16F, 0x0B225918,
+		0x714F905D, 0x62ED082A, 0x560AA0B3, 0x45A838C4, 0xA2D13239,
+		0xB173AA4E, 0x859402D7, 0x96369AA0, 0xEC5B53E5, 0xFFF9CB92,
+		0xCB1E630B, 0xD8BCFB7C, 0x7F8BE302, 0x6C297B75, 0x58CED3EC,
+		0x4B6C4B9B, 0x310182DE, 0x22A31AA9, 0x1644B230, 0x05E62A47,
+		0xE29F20BA, 0xF13DB8CD, 0xC5DA1054, 0xD6788823, 0xAC154166,
+		0xBFB7D911, 0x8B507188, 0x98F2E9FF, 0x404E1283, 0x53EC8AF4,
+		0x670B226D, 0x74A9BA1A, 0x0EC4735F, 0x1D66EB28, 0x298143B1,
+		0x3A23DBC6, 0xDD5AD13B, 0xCEF8494C, 0xFA1FE1D5, 0xE9BD79A2,
+		0x93D0B0E7, 0x80722890, 0xB4958009, 0xA737187E, 0xFF17C604,
+		0xECB55E73, 0xD852F6EA, 0xCBF06E9D, 0xB19DA7D8, 0xA23F3FAF,
+		0x96D89736, 0x857A0F41, 0x620305BC, 0x71A19DCB, 0x45463552,
+		0x56E4AD25, 0x2C896460, 0x3F2BFC17, 0x0BCC548E, 0x186ECCF9,
+		0xC0D23785, 0xD370AFF2, 0xE797076B, 0xF4359F1C, 0x8E585659,
+		0x9DFACE2E, 0xA91D66B7, 0xBABFFEC0, 0x5DC6F43D, 0x4E646C4A,
+		0x7A83C4D3, 0x69215CA4, 0x134C95E1, 0x00EE0D96, 0x3409A50F,
+		0x27AB3D78, 0x809C2506, 0x933EBD71, 0xA7D915E8, 0xB47B8D9F,
+		0xCE1644DA, 0xDDB4DCAD, 0xE9537434, 0xFAF1EC43, 0x1D88E6BE,
+		0x0E2A7EC9, 0x3ACDD650, 0x296F4E27, 0x53028762, 0x40A01F15,
+		0x7447B78C, 0x67E52FFB, 0xBF59D487, 0xACFB4CF0, 0x981CE469,
+		0x8BBE7C1E, 0xF1D3B55B, 0xE2712D2C, 0xD69685B5, 0xC5341DC2,
+		0x224D173F, 0x31EF8F48, 0x050827D1, 0x16AABFA6, 0x6CC776E3,
+		0x7F65EE94, 0x4B82460D, 0x5820DE7A, 0xFBC3FAF9, 0xE861628E,
+		0xDC86CA17, 0xCF245260, 0xB5499B25, 0xA6EB0352, 0x920CABCB,
+		0x81AE33BC, 0x66D73941, 0x7575A136, 0x419209AF, 0x523091D8,
+		0x285D589D, 0x3BFFC0EA, 0x0F186873, 0x1CBAF004, 0xC4060B78,
+		0xD7A4930F, 0xE3433B96, 0xF0E1A3E1, 0x8A8C6AA4, 0x992EF2D3,
+		0xADC95A4A, 0xBE6BC23D, 0x5912C8C0, 0x4AB050B7, 0x7E57F82E,
+		0x6DF56059, 0x1798A91C, 0x043A316B, 0x30DD99F2, 0x237F0185,
+		0x844819FB, 0x97EA818C, 0xA30D2915, 0xB0AFB162, 0xCAC27827,
+		0xD960E050, 0xED8748C9, 0xFE25D0BE, 0x195CDA43, 0x0AFE4234,
+		0x3E19EAAD, 0x2DBB72DA, 0x57D6BB9F, 0x447423E8, 0x70938B71,
+		0x63311306, 0xBB8DE87A, 0xA82F700D, 0x9CC8D894, 0x8F6A40E3,
+		0xF50789A6, 0xE6A511D1, 0xD242B948, 0xC1E0213F, 0x26992BC2,
+		0x353BB3B5, 0x01DC1B2C, 0x127E835B, 0x68134A1E, 0x7BB1D269,
+		0x4F567AF0, 0x5CF4E287, 0x04D43CFD, 0x1776A48A, 0x23910C13,
+		0x30339464, 0x4A5E5D21, 0x59FCC556, 0x6D1B6DCF, 0x7EB9F5B8,
+		0x99C0FF45, 0x8A626732, 0xBE85CFAB, 0xAD2757DC, 0xD74A9E99,
+		0xC4E806EE, 0xF00FAE77, 0xE3AD3600, 0x3B11CD7C, 0x28B3550B,
+		0x1C54FD92, 0x0FF665E5, 0x759BACA0, 0x663934D7, 0x52DE9C4E,
+		0x417C0439, 0xA6050EC4, 0xB5A796B3, 0x81403E2A, 0x92E2A65D,
+		0xE88F6F18, 0xFB2DF76F, 0xCFCA5FF6, 0xDC68C781, 0x7B5FDFFF,
+		0x68FD4788, 0x5C1AEF11, 0x4FB87766, 0x35D5BE23, 0x26772654,
+		0x12908ECD, 0x013216BA, 0xE64B1C47, 0xF5E98430, 0xC10E2CA9,
+		0xD2ACB4DE, 0xA8C17D9B, 0xBB63E5EC, 0x8F844D75, 0x9C26D502,
+		0x449A2E7E, 0x5738B609, 0x63DF1E90, 0x707D86E7, 0x0A104FA2,
+		0x19B2D7D5, 0x2D557F4C, 0x3EF7E73B, 0xD98EEDC6, 0xCA2C75B1,
+		0xFECBDD28, 0xED69455F, 0x97048C1A, 0x84A6146D, 0xB041BCF4,
+		0xA3E32483,
+	},
+	{
+		0x00000000, 0xA541927E, 0x4F6F520D, 0xEA2EC073, 0x9EDEA41A,
+		0x3B9F3664, 0xD1B1F617, 0x74F06469, 0x38513EC5, 0x9D10ACBB,
+		0x773E6CC8, 0xD27FFEB6, 0xA68F9ADF, 0x03CE08A1, 0xE9E0C8D2,
+		0x4CA15AAC, 0x70A27D8A, 0xD5E3EFF4, 0x3FCD2F87, 0x9A8CBDF9,
+		0xEE7CD990, 0x4B3D4BEE, 0xA1138B9D, 0x045219E3, 0x48F3434F,
+		0xEDB2D131, 0x079C1142, 0xA2DD833C, 0xD62DE755, 0x736C752B,
+		0x9942B558, 0x3C032726, 0xE144FB14, 0x4405696A, 0xAE2BA919,
+		0x0B6A3B67, 0x7F9A5F0E, 0xDADBCD70, 0x30F50D03, 0x95B49F7D,
+		0xD915C5D1, 0x7C5457AF, 0x967A97DC, 0x333B05A2, 0x47CB61CB,
+		0xE28AF3B5, 0x08A433C6, 0xADE5A1B8, 0x91E6869E, 0x34A714E0,
+		0xDE89D493, 0x7BC846ED, 0x0F382284, 0xAA79B0FA, 0x40577089,
+		0xE516E2F7, 0xA9B7B85B, 0x0CF62A25, 0xE6D8EA56, 0x43997828,
+		0x37691C41, 0x92288E3F, 0x78064E4C, 0xDD47DC32, 0xC76580D9,
+		0x622412A7, 0x880AD2D4, 0x2D4B40AA, 0x59BB24C3, 0xFCFAB6BD,
+		0x16D476CE, 0xB395E4B0, 0xFF34BE1C, 0x5A752C62, 0xB05BEC11,
+		0x151A7E6F, 0x61EA1A06, 0xC4AB8878, 0x2E85480B, 0x8BC4DA75,
+		0xB7C7FD53, 0x12866F2D, 0xF8A8AF5E, 0x5DE93D20, 0x29195949,
+		0x8C58CB37, 0x66760B44, 0xC337993A, 0x8F96C396, 0x2AD751E8,
+		0xC0F9919B, 0x65B803E5, 0x1148678C, 0xB409F5F2, 0x5E273581,
+		0xFB66A7FF, 0x26217BCD, 0x8360E9B3, 0x694E29C0, 0xCC0FBBBE,
+		0xB8FFDFD7, 0x1DBE4DA9, 0xF7908DDA, 0x52D11FA4, 0x1E704508,
+		0xBB31D776, 0x511F1705, 0xF45E857B, 0x80AEE112, 0x25EF736C,
+		0xCFC1B31F, 0x6A802161, 0x56830647, 0xF3C29439, 0x19EC544A,
+		0xBCADC634, 0xC85DA25D, 0x6D1C3023, 0x8732F050, 0x2273622E,
+		0x6ED23882, 0xCB93AAFC, 0x21BD6A8F, 0x84FCF8F1, 0xF00C9C98,
+		0x554D0EE6, 0xBF63CE95, 0x1A225CEB, 0x8B277743, 0x2E66E53D,
+		0xC448254E, 0x6109B730, 0x15F9D359, 0xB0B84127, 0x5A968154,
+		0xFFD7132A, 0xB3764986, 0x1637DBF8, 0xFC191B8B, 0x595889F5,
+		0x2DA8ED9C, 0x88E97FE2, 0x62C7BF91, 0xC7862DEF, 0xFB850AC9,
+		0x5EC498B7, 0xB4EA58C4, 0x11ABCABA, 0x655BAED3, 0xC01A3CAD,
+		0x2A34FCDE, 0x8F756EA0, 0xC3D4340C, 0x6695A672, 0x8CBB6601,
+		0x29FAF47F, 0x5D0A9016, 0xF84B0268, 0x1265C21B, 0xB7245065,
+		0x6A638C57, 0xCF221E29, 0x250CDE5A, 0x804D4C24, 0xF4BD284D,
+		0x51FCBA33, 0xBBD27A40, 0x1E93E83E, 0x5232B292, 0xF77320EC,
+		0x1D5DE09F, 0xB81C72E1, 0xCCEC1688, 0x69AD84F6, 0x83834485,
+		0x26C2D6FB, 0x1AC1F1DD, 0xBF8063A3, 0x55AEA3D0, 0xF0EF31AE,
+		0x841F55C7, 0x215EC7B9, 0xCB7007CA, 0x6E3195B4, 0x2290CF18,
+		0x87D15D66, 0x6DFF9D15, 0xC8BE0F6B, 0xBC4E6B02, 0x190FF97C,
+		0xF321390F, 0x5660AB71, 0x4C42F79A, 0xE90365E4, 0x032DA597,
+		0xA66C37E9, 0xD29C5380, 0x77DDC1FE, 0x9DF3018D, 0x38B293F3,
+		0x7413C95F, 0xD1525B21, 0x3B7C9B52, 0x9E3D092C, 0xEACD6D45,
+		0x4F8CFF3B, 0xA5A23F48, 0x00E3AD36, 0x3CE08A10, 0x99A1186E,
+		0x738FD81D, 0xD6CE4A63, 0xA23E2E0A, 0x077FBC74, 0xED517C07,
+		0x4810EE79, 0x04B1B4D5, 0xA1F026AB, 0x4BDEE6D8, 0xEE9F74A6,
+		0x9A6F10CF, 0x3F2E82B1, 0xD50042C2, 0x7041D0BC, 0xAD060C8E,
+		0x08479EF0, 0xE2695E83, 0x4728CCFD, 0x33D8A894, 0x96993AEA,
+		0x7CB7FA99, 0xD9F668E7, 0x9557324B, 0x3016A035, 0xDA386046,
+		0x7F79F238, 0x0B899651, 0xAEC8042F, 0x44E6C45C, 0xE1A75622,
+		0xDDA47104, 0x78E5E37A, 0x92CB2309, 0x378AB177, 0x437AD51E,
+		0xE63B4760, 0x0C158713, 0xA954156D, 0xE5F54FC1, 0x40B4DDBF,
+		0xAA9A1DCC, 0x0FDB8FB2, 0x7B2BEBDB, 0xDE6A79A5, 0x3444B9D6,
+		0x91052BA8,
+	},
+	{
+		0x00000000, 0xDD45AAB8, 0xBF672381, 0x62228939, 0x7B2231F3,
+		0xA6679B4B, 0xC4451272, 0x1900B8CA, 0xF64463E6, 0x2B01C95E,
+		0x49234067, 0x9466EADF, 0x8D665215, 0x5023F8AD, 0x32017194,
+		0xEF44DB2C, 0xE964B13D, 0x34211B85, 0x560392BC, 0x8B463804,
+		0x924680CE, 0x4F032A76, 0x2D21A34F, 0xF06409F7, 0x1F20D2DB,
+		0xC2657863, 0xA047F15A, 0x7D025BE2, 0x6402E328, 0xB9474990,
+		0xDB65C0A9, 0x06206A11, 0xD725148B, 0x0A60BE33, 0x6842370A,
+		0xB5079DB2, 0xAC072578, 0x71428FC0, 0x136006F9, 0xCE25AC41,
+		0x2161776D, 0xFC24DDD5, 0x9E0654EC, 0x4343FE54, 0x5A43469E,
+		0x8706EC26, 0xE524651F, 0x3861CFA7, 0x3E41A5B6, 0xE3040F0E,
+		0x81268637, 0x5C632C8F, 0x45639445, 0x98263EFD, 0xFA04B7C4,
+		0x27411D7C, 0xC805C650, 0x15406CE8, 0x7762E5D1, 0xAA274F69,
+		0xB327F7A3, 0x6E625D1B, 0x0C40D422, 0xD1057E9A, 0xABA65FE7,
+		0x76E3F55F, 0x14C17C66, 0xC984D6DE, 0xD0846E14, 0x0DC1C4AC,
+		0x6FE34D95, 0xB2A6E72D, 0x5DE23C01, 0x80A796B9, 0xE2851F80,
+		0x3FC0B538, 0x26C00DF2, 0xFB85A74A, 0x99A72E73, 0x44E284CB,
+		0x42C2EEDA, 0x9F874462, 0xFDA5CD5B, 0x20E067E3, 0x39E0DF29,
+		0xE4A57591, 0x8687FCA8, 0x5BC25610, 0xB4868D3C, 0x69C32784,
+		0x0BE1AEBD, 0xD6A40405, 0xCFA4BCCF, 0x12E11677, 0x70C39F4E,
+		0xAD8635F6, 0x7C834B6C, 0xA1C6E1D4, 0xC3E468ED, 0x1EA1C255,
+		0x07A17A9F, 0xDAE4D027, 0xB8C6591E, 0x6583F3A6, 0x8AC7288A,
+		0x57828232, 0x35A00B0B, 0xE8E5A1B3, 0xF1E51979, 0x2CA0B3C1,
+		0x4E823AF8, 0x93C79040, 0x95E7FA51, 0x48A250E9, 0x2A80D9D0,
+		0xF7C57368, 0xEEC5CBA2, 0x3380611A, 0x51A2E823, 0x8CE7429B,
+		0x63A399B7, 0xBEE6330F, 0xDCC4BA36, 0x0181108E, 0x1881A844,
+		0xC5C402FC, 0xA7E68BC5, 0x7AA3217D, 0x52A0C93F, 0x8FE56387,
+		0xEDC7EABE, 0x30824006, 0x2982F8CC, 0xF4C75274, 0x96E5DB4D,
+		0x4BA071F5, 0xA4E4AAD9, 0x79A10061, 0x1B838958, 0xC6C623E0,
+		0xDFC69B2A, 0x02833192, 0x60A1B8AB, 0xBDE41213, 0xBBC47802,
+		0x6681D2BA, 0x04A35B83, 0xD9E6F13B, 0xC0E649F1, 0x1DA3E349,
+		0x7F816A70, 0xA2C4C0C8, 0x4D801BE4, 0x90C5B15C, 0xF2E73865,
+		0x2FA292DD, 0x36A22A17, 0xEBE780AF, 0x89C50996, 0x5480A32E,
+		0x8585DDB4, 0x58C0770C, 0x3AE2FE35, 0xE7A7548D, 0xFEA7EC47,
+		0x23E246FF, 0x41C0CFC6, 0x9C85657E, 0x73C1BE52, 0xAE8414EA,
+		0xCCA69DD3, 0x11E3376B, 0x08E38FA1, 0xD5A62519, 0xB784AC20,
+		0x6AC10698, 0x6CE16C89, 0xB1A4C631, 0xD3864F08, 0x0EC3E5B0,
+		0x17C35D7A, 0xCA86F7C2, 0xA8A47EFB, 0x75E1D443, 0x9AA50F6F,
+		0x47E0A5D7, 0x25C22CEE, 0xF8878656, 0xE1873E9C, 0x3CC29424,
+		0x5EE01D1D, 0x83A5B7A5, 0xF90696D8, 0x24433C60, 0x4661B559,
+		0x9B241FE1, 0x8224A72B, 0x5F610D93, 0x3D4384AA, 0xE0062E12,
+		0x0F42F53E, 0xD2075F86, 0xB025D6BF, 0x6D607C07, 0x7460C4CD,
+		0xA9256E75, 0xCB07E74C, 0x16424DF4, 0x106227E5, 0xCD278D5D,
+		0xAF050464, 0x7240AEDC, 0x6B401616, 0xB605BCAE, 0xD4273597,
+		0x09629F2F, 0xE6264403, 0x3B63EEBB, 0x59416782, 0x8404CD3A,
+		0x9D0475F0, 0x4041DF48, 0x22635671, 0xFF26FCC9, 0x2E238253,
+		0xF36628EB, 0x9144A1D2, 0x4C010B6A, 0x5501B3A0, 0x88441918,
+		0xEA669021, 0x37233A99, 0xD867E1B5, 0x05224B0D, 0x6700C234,
+		0xBA45688C, 0xA345D046, 0x7E007AFE, 0x1C22F3C7, 0xC167597F,
+		0xC747336E, 0x1A0299D6, 0x782010EF, 0xA565BA57, 0xBC65029D,
+		0x6120A825, 0x0302211C, 0xDE478BA4, 0x31035088, 0xEC46FA30,
+		0x8E647309, 0x5321D9B1, 0x4A21617B, 0x9764CBC3, 0xF54642FA,
+		0x2803E842,
+	},
+	{
+		0x00000000, 0x38116FAC, 0x7022DF58, 0x4833B0F4, 0xE045BEB0,
+		0xD854D11C, 0x906761E8, 0xA8760E44, 0xC5670B91, 0xFD76643D,
+		0xB545D4C9, 0x8D54BB65, 0x2522B521, 0x1D33DA8D, 0x55006A79,
+		0x6D1105D5, 0x8F2261D3, 0xB7330E7F, 0xFF00BE8B, 0xC711D127,
+		0x6F67DF63, 0x5776B0CF, 0x1F45003B, 0x27546F97, 0x4A456A42,
+		0x725405EE, 0x3A67B51A, 0x0276DAB6, 0xAA00D4F2, 0x9211BB5E,
+		0xDA220BAA, 0xE2336406, 0x1BA8B557, 0x23B9DAFB, 0x6B8A6A0F,
+		0x539B05A3, 0xFBED0BE7, 0xC3FC644B, 0x8BCFD4BF, 0xB3DEBB13,
+		0xDECFBEC6, 0xE6DED16A, 0xAEED619E, 0x96FC0E32, 0x3E8A0076,
+		0x069B6FDA, 0x4EA8DF2E, 0x76B9B082, 0x948AD484, 0xAC9BBB28,
+		0xE4A80BDC, 0xDCB96470, 0x74CF6A34, 0x4CDE0598, 0x04EDB56C,
+		0x3CFCDAC0, 0x51EDDF15, 0x69FCB0B9, 0x21CF004D, 0x19DE6FE1,
+		0xB1A861A5, 0x89B90E09, 0xC18ABEFD, 0xF99BD151, 0x37516AAE,
+		0x0F400502, 0x4773B5F6, 0x7F62DA5A, 0xD714D41E, 0xEF05BBB2,
+		0xA7360B46, 0x9F2764EA, 0xF236613F, 0xCA270E93, 0x8214BE67,
+		0xBA05D1CB, 0x1273DF8F, 0x2A62B023, 0x625100D7, 0x5A406F7B,
+		0xB8730B7D, 0x806264D1, 0xC851D425, 0xF040BB89, 0x5836B5CD,
+		0x6027DA61, 0x28146A95, 0x10050539, 0x7D1400EC, 0x45056F40,
+		0x0D36DFB4, 0x3527B018, 0x9D51BE5C, 0xA540D1F0, 0xED736104,
+		0xD5620EA8, 0x2CF9DFF9, 0x14E8B055, 0x5CDB00A1, 0x64CA6F0D,
+		0xCCBC6149, 0xF4AD0EE5, 0xBC9EBE11, 0x848FD1BD, 0xE99ED468,
+		0xD18FBBC4, 0x99BC0B30, 0xA1AD649C, 0x09DB6AD8, 0x31CA0574,
+		0x79F9B580, 0x41E8DA2C, 0xA3DBBE2A, 0x9BCAD186, 0xD3F96172,
+		0xEBE80EDE, 0x439E009A, 0x7B8F6F36, 0x33BCDFC2, 0x0BADB06E,
+		0x66BCB5BB, 0x5EADDA17, 0x169E6AE3, 0x2E8F054F, 0x86F90B0B,
+		0xBEE864A7, 0xF6DBD453, 0xCECABBFF, 0x6EA2D55C, 0x56B3BAF0,
+		0x1E800A04, 0x269165A8, 0x8EE76BEC, 0xB6F60440, 0xFEC5B4B4,
+		0xC6D4DB18, 0xABC5DECD, 0x93D4B161, 0xDBE70195, 0xE3F66E39,
+		0x4B80607D, 0x73910FD1, 0x3BA2BF25, 0x03B3D089, 0xE180B48F,
+		0xD991DB23, 0x91A26BD7, 0xA9B3047B, 0x01C50A3F, 0x39D46593,
+		0x71E7D567, 0x49F6BACB, 0x24E7BF1E, 0x1CF6D0B2, 0x54C56046,
+		0x6CD40FEA, 0xC4A201AE, 0xFCB36E02, 0xB480DEF6, 0x8C91B15A,
+		0x750A600B, 0x4D1B0FA7, 0x0528BF53, 0x3D39D0FF, 0x954FDEBB,
+		0xAD5EB117, 0xE56D01E3, 0xDD7C6E4F, 0xB06D6B9A, 0x887C0436,
+		0xC04FB4C2, 0xF85EDB6E, 0x5028D52A, 0x6839BA86, 0x200A0A72,
+		0x181B65DE, 0xFA2801D8, 0xC2396E74, 0x8A0ADE80, 0xB21BB12C,
+		0x1A6DBF68, 0x227CD0C4, 0x6A4F6030, 0x525E0F9C, 0x3F4F0A49,
+		0x075E65E5, 0x4F6DD511, 0x777CBABD, 0xDF0AB4F9, 0xE71BDB55,
+		0xAF286BA1, 0x9739040D, 0x59F3BFF2, 0x61E2D05E, 0x29D160AA,
+		0x11C00F06, 0xB9B60142, 0x81A76EEE, 0xC994DE1A, 0xF185B1B6,
+		0x9C94B463, 0xA485DBCF, 0xECB66B3B, 0xD4A70497, 0x7CD10AD3,
+		0x44C0657F, 0x0CF3D58B, 0x34E2BA27, 0xD6D1DE21, 0xEEC0B18D,
+		0xA6F30179, 0x9EE26ED5, 0x36946091, 0x0E850F3D, 0x46B6BFC9,
+		0x7EA7D065, 0x13B6D5B0, 0x2BA7BA1C, 0x63940AE8, 0x5B856544,
+		0xF3F36B00, 0xCBE204AC, 0x83D1B458, 0xBBC0DBF4, 0x425B0AA5,
+		0x7A4A6509, 0x3279D5FD, 0x0A68BA51, 0xA21EB415, 0x9A0FDBB9,
+		0xD23C6B4D, 0xEA2D04E1, 0x873C0134, 0xBF2D6E98, 0xF71EDE6C,
+		0xCF0FB1C0, 0x6779BF84, 0x5F68D028, 0x175B60DC, 0x2F4A0F70,
+		0xCD796B76, 0xF56804DA, 0xBD5BB42E, 0x854ADB82, 0x2D3CD5C6,
+		0x152DBA6A, 0x5D1E0A9E, 0x650F6532, 0x081E60E7, 0x300F0F4B,
+		0x783CBFBF, 0x402DD013, 0xE85BDE57, 0xD04AB1FB, 0x9879010F,
+		0xA0686EA3,
+	},
+	{
+		0x00000000, 0xEF306B19, 0xDB8CA0C3, 0x34BCCBDA, 0xB2F53777,
+		0x5DC55C6E, 0x697997B4, 0x8649FCAD, 0x6006181F, 0x8F367306,
+		0xBB8AB8DC, 0x54BAD3C5, 0xD2F32F68, 0x3DC34471, 0x097F8FAB,
+		0xE64FE4B2, 0xC00C303E, 0x2F3C5B27, 0x1B8090FD, 0xF4B0FBE4,
+		0x72F90749, 0x9DC96C50, 0xA975A78A, 0x4645CC93, 0xA00A2821,
+		0x4F3A4338, 0x7B8688E2, 0x94B6E3FB, 0x12FF1F56, 0xFDCF744F,
+		0xC973BF95, 0x2643D48C, 0x85F4168D, 0x6AC47D94, 0x5E78B64E,
+		0xB148DD57, 0x370121FA, 0xD8314AE3, 0xEC8D8139, 0x03BDEA20,
+		0xE5F20E92, 0x0AC2658B, 0x3E7EAE51, 0xD14EC548, 0x570739E5,
+		0xB83752FC, 0x8C8B9926, 0x63BBF23F, 0x45F826B3, 0xAAC84DAA,
+		0x9E748670, 0x7144ED69, 0xF70D11C4, 0x183D7ADD, 0x2C81B107,
+		0xC3B1DA1E, 0x25FE3EAC, 0xCACE55B5, 0xFE729E6F, 0x1142F576,
+		0x970B09DB, 0x783B62C2, 0x4C87A918, 0xA3B7C201, 0x0E045BEB,
+		0xE13430F2, 0xD588FB28, 0x3AB89031, 0xBCF16C9C, 0x53C10785,
+		0x677DCC5F, 0x884DA746, 0x6E0243F4, 0x813228ED, 0xB58EE337,
+		0x5ABE882E, 0xDCF77483, 0x33C71F9A, 0x077BD440, 0xE84BBF59,
+		0xCE086BD5, 0x213800CC, 0x1584CB16, 0xFAB4A00F, 0x7CFD5CA2,
+		0x93CD37BB, 0xA771FC61, 0x48419778, 0xAE0E73CA, 0x413E18D3,
+		0x7582D309, 0x9AB2B810, 0x1CFB44BD, 0xF3CB2FA4, 0xC777E47E,
+		0x28478F67, 0x8BF04D66, 0x64C0267F, 0x507CEDA5, 0xBF4C86BC,
+		0x39057A11, 0xD6351108, 0xE289DAD2, 0x0DB9B1CB, 0xEBF65579,
+		0x04C63E60, 0x307AF5BA, 0xDF4A9EA3, 0x5903620E, 0xB6330917,
+		0x828FC2CD, 0x6DBFA9D4, 0x4BFC7D58, 0xA4CC1641, 0x9070DD9B,
+		0x7F40B682, 0xF9094A2F, 0x16392136, 0x2285EAEC, 0xCDB581F5,
+		0x2BFA6547, 0xC4CA0E5E, 0xF076C584, 0x1F46AE9D, 0x990F5230,
+		0x763F3929, 0x4283F2F3, 0xADB399EA, 0x1C08B7D6, 0xF338DCCF,
+		0xC7841715, 0x28B47C0C, 0xAEFD80A1, 0x41CDEBB8, 0x75712062,
+		0x9A414B7B, 0x7C0EAFC9, 0x933EC4D0, 0xA7820F0A, 0x48B26413,
+		0xCEFB98BE, 0x21CBF3A7, 0x1577387D, 0xFA475364, 0xDC0487E8,
+		0x3334ECF1, 0x0788272B, 0xE8B84C32, 0x6EF1B09F, 0x81C1DB86,
+		0xB57D105C, 0x5A4D7B45, 0xBC029FF7, 0x5332F4EE, 0x678E3F34,
+		0x88BE542D, 0x0EF7A880, 0xE1C7C399, 0xD57B0843, 0x3A4B635A,
+		0x99FCA15B, 0x76CCCA42, 0x42700198, 0xAD406A81, 0x2B09962C,
+		0xC439FD35, 0xF08536EF, 0x1FB55DF6, 0xF9FAB944, 0x16CAD25D,
+		0x22761987, 0xCD46729E, 0x4B0F8E33, 0xA43FE52A, 0x90832EF0,
+		0x7FB345E9, 0x59F09165, 0xB6C0FA7C, 0x827C31A6, 0x6D4C5ABF,
+		0xEB05A612, 0x0435CD0B, 0x308906D1, 0xDFB96DC8, 0x39F6897A,
+		0xD6C6E263, 0xE27A29B9, 0x0D4A42A0, 0x8B03BE0D, 0x6433D514,
+		0x508F1ECE, 0xBFBF75D7, 0x120CEC3D, 0xFD3C8724, 0xC9804CFE,
+		0x26B027E7, 0xA0F9DB4A, 0x4FC9B053, 0x7B757B89, 0x94451090,
+		0x720AF422, 0x9D3A9F3B, 0xA98654E1, 0x46B63FF8, 0xC0FFC355,
+		0x2FCFA84C, 0x1B736396, 0xF443088F, 0xD200DC03, 0x3D30B71A,
+		0x098C7CC0, 0xE6BC17D9, 0x60F5EB74, 0x8FC5806D, 0xBB794BB7,
+		0x544920AE, 0xB206C41C, 0x5D36AF05, 0x698A64DF, 0x86BA0FC6,
+		0x00F3F36B, 0xEFC39872, 0xDB7F53A8, 0x344F38B1, 0x97F8FAB0,
+		0x78C891A9, 0x4C745A73, 0xA344316A, 0x250DCDC7, 0xCA3DA6DE,
+		0xFE816D04, 0x11B1061D, 0xF7FEE2AF, 0x18CE89B6, 0x2C72426C,
+		0xC3422975, 0x450BD5D8, 0xAA3BBEC1, 0x9E87751B, 0x71B71E02,
+		0x57F4CA8E, 0xB8C4A197, 0x8C786A4D, 0x63480154, 0xE501FDF9,
+		0x0A3196E0, 0x3E8D5D3A, 0xD1BD3623, 0x37F2D291, 0xD8C2B988,
+		0xEC7E7252, 0x034E194B, 0x8507E5E6, 0x6A378EFF, 0x5E8B4525,
+		0xB1BB2E3C,
+	},
+	{
+		0x00000000, 0x68032CC8, 0xD0065990, 0xB8057558, 0xA5E0C5D1,
+		0xCDE3E919, 0x75E69C41, 0x1DE5B089, 0x4E2DFD53, 0x262ED19B,
+		0x9E2BA4C3, 0xF628880B, 0xEBCD3882, 0x83CE144A, 0x3BCB6112,
+		0x53C84DDA, 0x9C5BFAA6, 0xF458D66E, 0x4C5DA336, 0x245E8FFE,
+		0x39BB3F77, 0x51B813BF, 0xE9BD66E7, 0x81BE4A2F, 0xD27607F5,
+		0xBA752B3D, 0x02705E65, 0x6A7372AD, 0x7796C224, 0x1F95EEEC,
+		0xA7909BB4, 0xCF93B77C, 0x3D5B83BD, 0x5558AF75, 0xED5DDA2D,
+		0x855EF6E5, 0x98BB466C, 0xF0B86AA4, 0x48BD1FFC, 0x20BE3334,
+		0x73767EEE, 0x1B755226, 0xA370277E, 0xCB730BB6, 0xD696BB3F,
+		0xBE9597F7, 0x0690E2AF, 0x6E93CE67, 0xA100791B, 0xC90355D3,
+		0x7106208B, 0x19050C43, 0x04E0BCCA, 0x6CE39002, 0xD4E6E55A,
+		0xBCE5C992, 0xEF2D8448, 0x872EA880, 0x3F2BDDD8, 0x5728F110,
+		0x4ACD4199, 0x22CE6D51, 0x9ACB1809, 0xF2C834C1, 0x7AB7077A,
+		0x12B42BB2, 0xAAB15EEA, 0xC2B27222, 0xDF57C2AB, 0xB754EE63,
+		0x0F519B3B, 0x6752B7F3, 0x349AFA29, 0x5C99D6E1, 0xE49CA3B9,
+		0x8C9F8F71, 0x917A3FF8, 0xF9791330, 0x417C6668, 0x297F4AA0,
+		0xE6ECFDDC, 0x8EEFD114, 0x36EAA44C, 0x5EE98884, 0x430C380D,
+		0x2B0F14C5, 0x930A619D, 0xFB094D55, 0xA8C1008F, 0xC0C22C47,
+		0x78C7591F, 0x10C475D7, 0x0D21C55E, 0x6522E996, 0xDD279CCE,
+		0xB524B006, 0x47EC84C7, 0x2FEFA80F, 0x97EADD57, 0xFFE9F19F,
+		0xE20C4116, 0x8A0F6DDE, 0x320A1886, 0x5A09344E, 0x09C17994,
+		0x61C2555C, 0xD9C72004, 0xB1C40CCC, 0xAC21BC45, 0xC422908D,
+		0x7C27E5D5, 0x1424C91D, 0xDBB77E61, 0xB3B452A9, 0x0BB127F1,
+		0x63B20B39, 0x7E57BBB0, 0x16549778, 0xAE51E220, 0xC652CEE8,
+		0x959A8332, 0xFD99AFFA, 0x459CDAA2, 0x2D9FF66A, 0x307A46E3,
+		0x58796A2B, 0xE07C1F73, 0x887F33BB, 0xF56E0EF4, 0x9D6D223C,
+		0x25685764, 0x4D6B7BAC, 0x508ECB25, 0x388DE7ED, 0x808892B5,
+		0xE88BBE7D, 0xBB43F3A7, 0xD340DF6F, 0x6B45AA37, 0x034686FF,
+		0x1EA33676, 0x76A01ABE, 0xCEA56FE6, 0xA6A6432E, 0x6935F452,
+		0x0136D89A, 0xB933ADC2, 0xD130810A, 0xCCD53183, 0xA4D61D4B,
+		0x1CD36813, 0x74D044DB, 0x27180901, 0x4F1B25C9, 0xF71E5091,
+		0x9F1D7C59, 0x82F8CCD0, 0xEAFBE018, 0x52FE9540, 0x3AFDB988,
+		0xC8358D49, 0xA036A181, 0x1833D4D9, 0x7030F811, 0x6DD54898,
+		0x05D66450, 0xBDD31108, 0xD5D03DC0, 0x8618701A, 0xEE1B5CD2,
+		0x561E298A, 0x3E1D0542, 0x23F8B5CB, 0x4BFB9903, 0xF3FEEC5B,
+		0x9BFDC093, 0x546E77EF, 0x3C6D5B27, 0x84682E7F, 0xEC6B02B7,
+		0xF18EB23E, 0x998D9EF6, 0x2188EBAE, 0x498BC766, 0x1A438ABC,
+		0x7240A674, 0xCA45D32C, 0xA246FFE4, 0xBFA34F6D, 0xD7A063A5,
+		0x6FA516FD, 0x07A63A35, 0x8FD9098E, 0xE7DA2546, 0x5FDF501E,
+		0x37DC7CD6, 0x2A39CC5F, 0x423AE097, 0xFA3F95CF, 0x923CB907,
+		0xC1F4F4DD, 0xA9F7D815, 0x11F2AD4D, 0x79F18185, 0x6414310C,
+		0x0C171DC4, 0xB412689C, 0xDC114454, 0x1382F328, 0x7B81DFE0,
+		0xC384AAB8, 0xAB878670, 0xB66236F9, 0xDE611A31, 0x66646F69,
+		0x0E6743A1, 0x5DAF0E7B, 0x35AC22B3, 0x8DA957EB, 0xE5AA7B23,
+		0xF84FCBAA, 0x904CE762, 0x2849923A, 0x404ABEF2, 0xB2828A33,
+		0xDA81A6FB, 0x6284D3A3, 0x0A87FF6B, 0x17624FE2, 0x7F61632A,
+		0xC7641672, 0xAF673ABA, 0xFCAF7760, 0x94AC5BA8, 0x2CA92EF0,
+		0x44AA0238, 0x594FB2B1, 0x314C9E79, 0x8949EB21, 0xE14AC7E9,
+		0x2ED97095, 0x46DA5C5D, 0xFEDF2905, 0x96DC05CD, 0x8B39B544,
+		0xE33A998C, 0x5B3FECD4, 0x333CC01C, 0x60F48DC6, 0x08F7A10E,
+		0xB0F2D456, 0xD8F1F89E, 0xC5144817, 0xAD1764DF, 0x15121187,
+		0x7D113D4F,
+	},
+	{
+		0x00000000, 0x493C7D27, 0x9278FA4E, 0xDB448769, 0x211D826D,
+		0x6821FF4A, 0xB3657823, 0xFA590504, 0x423B04DA, 0x0B0779FD,
+		0xD043FE94, 0x997F83B3, 0x632686B7, 0x2A1AFB90, 0xF15E7CF9,
+		0xB86201DE, 0x847609B4, 0xCD4A7493, 0x160EF3FA, 0x5F328EDD,
+		0xA56B8BD9, 0xEC57F6FE, 0x37137197, 0x7E2F0CB0, 0xC64D0D6E,
+		0x8F717049, 0x5435F720, 0x1D098A07, 0xE7508F03, 0xAE6CF224,
+		0x7528754D, 0x3C14086A, 0x0D006599, 0x443C18BE, 0x9F789FD7,
+		0xD644E2F0, 0x2C1DE7F4, 0x65219AD3, 0xBE651DBA, 0xF759609D,
+		0x4F3B6143, 0x06071C64, 0xDD439B0D, 0x947FE62A, 0x6E26E32E,
+		0x271A9E09, 0xFC5E1960, 0xB5626447, 0x89766C2D, 0xC04A110A,
+		0x1B0E9663, 0x5232EB44, 0xA86BEE40, 0xE1579367, 0x3A13140E,
+		0x732F6929, 0xCB4D68F7, 0x827115D0, 0x593592B9, 0x1009EF9E,
+		0xEA50EA9A, 0xA36C97BD, 0x782810D4, 0x31146DF3, 0x1A00CB32,
+		0x533CB615, 0x8878317C, 0xC1444C5B, 0x3B1D495F, 0x72213478,
+		0xA965B311, 0xE059CE36, 0x583BCFE8, 0x1107B2CF, 0xCA4335A6,
+		0x837F4881, 0x79264D85, 0x301A30A2, 0xEB5EB7CB, 0xA262CAEC,
+		0x9E76C286, 0xD74ABFA1, 0x0C0E38C8, 0x453245EF, 0xBF6B40EB,
+		0xF6573DCC, 0x2D13BAA5, 0x642FC782, 0xDC4DC65C, 0x9571BB7B,
+		0x4E353C12, 0x07094135, 0xFD504431, 0xB46C3916, 0x6F28BE7F,
+		0x2614C358, 0x1700AEAB, 0x5E3CD38C, 0x857854E5, 0xCC4429C2,
+		0x361D2CC6, 0x7F2151E1, 0xA465D688, 0xED59ABAF, 0x553BAA71,
+		0x1C07D756, 0xC743503F, 0x8E7F2D18, 0x7426281C, 0x3D1A553B,
+		0xE65ED252, 0xAF62AF75, 0x9376A71F, 0xDA4ADA38, 0x010E5D51,
+		0x48322076, 0xB26B2572, 0xFB575855, 0x2013DF3C, 0x692FA21B,
+		0xD14DA3C5, 0x9871DEE2, 0x4335598B, 0x0A0924AC, 0xF05021A8,
+		0xB96C5C8F, 0x6228DBE6, 0x2B14A6C1, 0x34019664, 0x7D3DEB43,
+		0xA6796C2A, 0xEF45110D, 0x151C1409, 0x5C20692E, 0x8764EE47,
+		0xCE589360, 0x763A92BE, 0x3F06EF99, 0xE44268F0, 0xAD7E15D7,
+		0x572710D3, 0x1E1B6DF4, 0xC55FEA9D, 0x8C6397BA, 0xB0779FD0,
+		0xF94BE2F7, 0x220F659E, 0x6B3318B9, 0x916A1DBD, 0xD856609A,
+		0x0312E7F3, 0x4A2E9AD4, 0xF24C9B0A, 0xBB70E62D, 0x60346144,
+		0x29081C63, 0xD3511967, 0x9A6D6440, 0x4129E329, 0x08159E0E,
+		0x3901F3FD, 0x703D8EDA, 0xAB7909B3, 0xE2457494, 0x181C7190,
+		0x51200CB7, 0x8A648BDE, 0xC358F6F9, 0x7B3AF727, 0x32068A00,
+		0xE9420D69, 0xA07E704E, 0x5A27754A, 0x131B086D, 0xC85F8F04,
+		0x8163F223, 0xBD77FA49, 0xF44B876E, 0x2F0F0007, 0x66337D20,
+		0x9C6A7824, 0xD5560503, 0x0E12826A, 0x472EFF4D, 0xFF4CFE93,
+		0xB67083B4, 0x6D3404DD, 0x240879FA, 0xDE517CFE, 0x976D01D9,
+		0x4C2986B0, 0x0515FB97, 0x2E015D56, 0x673D2071, 0xBC79A718,
+		0xF545DA3F, 0x0F1CDF3B, 0x4620A21C, 0x9D642575, 0xD4585852,
+		0x6C3A598C, 0x250624AB, 0xFE42A3C2, 0xB77EDEE5, 0x4D27DBE1,
+		0x041BA6C6, 0xDF5F21AF, 0x96635C88, 0xAA7754E2, 0xE34B29C5,
+		0x380FAEAC, 0x7133D38B, 0x8B6AD68F, 0xC256ABA8, 0x19122CC1,
+		0x502E51E6, 0xE84C5038, 0xA1702D1F, 0x7A34AA76, 0x3308D751,
+		0xC951D255, 0x806DAF72, 0x5B29281B, 0x1215553C, 0x230138CF,
+		0x6A3D45E8, 0xB179C281, 0xF845BFA6, 0x021CBAA2, 0x4B20C785,
+		0x906440EC, 0xD9583DCB, 0x613A3C15, 0x28064132, 0xF342C65B,
+		0xBA7EBB7C, 0x4027BE78, 0x091BC35F, 0xD25F4436, 0x9B633911,
+		0xA777317B, 0xEE4B4C5C, 0x350FCB35, 0x7C33B612, 0x866AB316,
+		0xCF56CE31, 0x14124958, 0x5D2E347F, 0xE54C35A1, 0xAC704886,
+		0x7734CFEF, 0x3E08B2C8, 0xC451B7CC, 0x8D6DCAEB, 0x56294D82,
+		0x1F1530A5,
+	},
+	{
+		0x00000000, 0xF43ED648, 0xED91DA61, 0x19AF0C29, 0xDECFC233,
+		0x2AF1147B, 0x335E1852, 0xC760CE1A, 0xB873F297, 0x4C4D24DF,
+		0x55E228F6, 0xA1DCFEBE, 0x66BC30A4, 0x9282E6EC, 0x8B2DEAC5,
+		0x7F133C8D, 0x750B93DF, 0x81354597, 0x989A49BE, 0x6CA49FF6,
+		0xABC451EC, 0x5FFA87A4, 0x46558B8D, 0xB26B5DC5, 0xCD786148,
+		0x3946B700, 0x20E9BB29, 0xD4D76D61, 0x13B7A37B, 0xE7897533,
+		0xFE26791A, 0x0A18AF52, 0xEA1727BE, 0x1E29F1F6, 0x0786FDDF,
+		0xF3B82B97, 0x34D8E58D, 0xC0E633C5, 0xD9493FEC, 0x2D77E9A4,
+		0x5264D529, 0xA65A0361, 0xBFF50F48, 0x4BCBD900, 0x8CAB171A,
+		0x7895C152, 0x613ACD7B, 0x95041B33, 0x9F1CB461, 0x6B226229,
+		0x728D6E00, 0x86B3B848, 0x41D37652, 0xB5EDA01A, 0xAC42AC33,
+		0x587C7A7B, 0x276F46F6, 0xD35190BE, 0xCAFE9C97, 0x3EC04ADF,
+		0xF9A084C5, 0x0D9E528D, 0x14315EA4, 0xE00F88EC, 0xD1C2398D,
+		0x25FCEFC5, 0x3C53E3EC, 0xC86D35A4, 0x0F0DFBBE, 0xFB332DF6,
+		0xE29C21DF, 0x16A2F797, 0x69B1CB1A, 0x9D8F1D52, 0x8420117B,
+		0x701EC733, 0xB77E0929, 0x4340DF61, 0x5AEFD348, 0xAED10500,
+		0xA4C9AA52, 0x50F77C1A, 0x49587033, 0xBD66A67B, 0x7A066861,
+		0x8E38BE29, 0x9797B200, 0x63A96448, 0x1CBA58C5, 0xE8848E8D,
+		0xF12B82A4, 0x051554EC, 0xC2759AF6, 0x364B4CBE, 0x2FE44097,
+		0xDBDA96DF, 0x3BD51E33, 0xCFEBC87B, 0xD644C452, 0x227A121A,
+		0xE51ADC00, 0x11240A48, 0x088B0661, 0xFCB5D029, 0x83A6ECA4,
+		0x77983AEC, 0x6E3736C5, 0x9A09E08D, 0x5D692E97, 0xA957F8DF,
+		0xB0F8F4F6, 0x44C622BE, 0x4EDE8DEC, 0xBAE05BA4, 0xA34F578D,
+		0x577181C5, 0x90114FDF, 0x642F9997, 0x7D8095BE, 0x89BE43F6,
+		0xF6AD7F7B, 0x0293A933, 0x1B3CA51A, 0xEF027352, 0x2862BD48,
+		0xDC5C6B00, 0xC5F36729, 0x31CDB161, 0xA66805EB, 0x5256D3A3,
+		0x4BF9DF8A, 0xBFC709C2, 0x78A7C7D8, 0x8C991190, 0x95361DB9,
+		0x6108CBF1, 0x1E1BF77C, 0xEA252134, 0xF38A2D1D, 0x07B4FB55,
+		0xC0D4354F, 0x34EAE307, 0x2D45EF2E, 0xD97B3966, 0xD3639634,
+		0x275D407C, 0x3EF24C55, 0xCACC9A1D, 0x0DAC5407, 0xF992824F,
+		0xE03D8E66, 0x1403582E, 0x6B1064A3, 0x9F2EB2EB, 0x8681BEC2,
+		0x72BF688A, 0xB5DFA690, 0x41E170D8, 0x584E7CF1, 0xAC70AAB9,
+		0x4C7F2255, 0xB841F41D, 0xA1EEF834, 0x55D02E7C, 0x92B0E066,
+		0x668E362E, 0x7F213A07, 0x8B1FEC4F, 0xF40CD0C2, 0x0032068A,
+		0x199D0AA3, 0xEDA3DCEB, 0x2AC312F1, 0xDEFDC4B9, 0xC752C890,
+		0x336C1ED8, 0x3974B18A, 0xCD4A67C2, 0xD4E56BEB, 0x20DBBDA3,
+		0xE7BB73B9, 0x1385A5F1, 0x0A2AA9D8, 0xFE147F90, 0x8107431D,
+		0x75399555, 0x6C96997C, 0x98A84F34, 0x5FC8812E, 0xABF65766,
+		0xB2595B4F, 0x46678D07, 0x77AA3C66, 0x8394EA2E, 0x9A3BE607,
+		0x6E05304F, 0xA965FE55, 0x5D5B281D, 0x44F42434, 0xB0CAF27C,
+		0xCFD9CEF1, 0x3BE718B9, 0x22481490, 0xD676C2D8, 0x11160CC2,
+		0xE528DA8A, 0xFC87D6A3, 0x08B900EB, 0x02A1AFB9, 0xF69F79F1,
+		0xEF3075D8, 0x1B0EA390, 0xDC6E6D8A, 0x2850BBC2, 0x31FFB7EB,
+		0xC5C161A3, 0xBAD25D2E, 0x4EEC8B66, 0x5743874F, 0xA37D5107,
+		0x641D9F1D, 0x90234955, 0x898C457C, 0x7DB29334, 0x9DBD1BD8,
+		0x6983CD90, 0x702CC1B9, 0x841217F1, 0x4372D9EB, 0xB74C0FA3,
+		0xAEE3038A, 0x5ADDD5C2, 0x25CEE94F, 0xD1F03F07, 0xC85F332E,
+		0x3C61E566, 0xFB012B7C, 0x0F3FFD34, 0x1690F11D, 0xE2AE2755,
+		0xE8B68807, 0x1C885E4F, 0x05275266, 0xF119842E, 0x36794A34,
+		0xC2479C7C, 0xDBE89055, 0x2FD6461D, 0x50C57A90, 0xA4FBACD8,
+		0xBD54A0F1, 0x496A76B9, 0x8E0AB8A3, 0x7A346EEB, 0x639B62C2,
+		0x97A5B48A,
+	},
+	{
+		0x00000000, 0xCB567BA5, 0x934081BB, 0x5816FA1E, 0x236D7587,
+		0xE83B0E22, 0xB02DF43C, 0x7B7B8F99, 0x46DAEB0E, 0x8D8C90AB,
+		0xD59A6AB5, 0x1ECC1110, 0x65B79E89, 0xAEE1E52C, 0xF6F71F32,
+		0x3DA16497, 0x8DB5D61C, 0x46E3ADB9, 0x1EF557A7, 0xD5A32C02,
+		0xAED8A39B, 0x658ED83E, 0x3D982220, 0xF6CE5985, 0xCB6F3D12,
+		0x003946B7, 0x582FBCA9, 0x9379C70C, 0xE8024895, 0x23543330,
+		0x7B42C92E, 0xB014B28B, 0x1E87DAC9, 0xD5D1A16C, 0x8DC75B72,
+		0x469120D7, 0x3DEAAF4E, 0xF6BCD4EB, 0xAEAA2EF5, 0x65FC5550,
+		0x585D31C7, 0x930B4A62, 0xCB1DB07C, 0x004BCBD9, 0x7B304440,
+		0xB0663FE5, 0xE870C5FB, 0x2326BE5E, 0x93320CD5, 0x58647770,
+		0x00728D6E, 0xCB24F6CB, 0xB05F7952, 0x7B0902F7, 0x231FF8E9,
+		0xE849834C, 0xD5E8E7DB, 0x1EBE9C7E, 0x46A86660, 0x8DFE1DC5,
+		0xF685925C, 0x3DD3E9F9, 0x65C513E7, 0xAE936842, 0x3D0FB592,
+		0xF659CE37, 0xAE4F3429, 0x65194F8C, 0x1E62C015, 0xD534BBB0,
+		0x8D2241AE, 0x46743A0B, 0x7BD55E9C, 0xB0832539, 0xE895DF27,
+		0x23C3A482, 0x58B82B1B, 0x93EE50BE, 0xCBF8AAA0, 0x00AED105,
+		0xB0BA638E, 0x7BEC182B, 0x23FAE235, 0xE8AC9990, 0x93D71609,
+		0x58816DAC, 0x009797B2, 0xCBC1EC17, 0xF6608880, 0x3D36F325,
+		0x6520093B, 0xAE76729E, 0xD50DFD07, 0x1E5B86A2, 0x464D7CBC,
+		0x8D1B0719, 0x23886F5B, 0xE8DE14FE, 0xB0C8EEE0, 0x7B9E9545,
+		0x00E51ADC, 0xCBB36179, 0x93A59B67, 0x58F3E0C2, 0x65528455,
+		0xAE04FFF0, 0xF61205EE, 0x3D447E4B, 0x463FF1D2, 0x8D698A77,
+		0xD57F7069, 0x1E290BCC, 0xAE3DB947, 0x656BC2E2, 0x3D7D38FC,
+		0xF62B4359, 0x8D50CCC0, 0x4606B765, 0x1E104D7B, 0xD54636DE,
+		0xE8E75249, 0x23B129EC, 0x7BA7D3F2, 0xB0F1A857, 0xCB8A27CE,
+		0x00DC5C6B, 0x58CAA675, 0x939CDDD0, 0x7A1F6B24, 0xB1491081,
+		0xE95FEA9F, 0x2209913A, 0x59721EA3, 0x92246506, 0xCA329F18,
+		0x0164E4BD, 0x3CC5802A, 0xF793FB8F, 0xAF850191, 0x64D37A34,
+		0x1FA8F5AD, 0xD4FE8E08, 0x8CE87416, 0x47BE0FB3, 0xF7AABD38,
+		0x3CFCC69D, 0x64EA3C83, 0xAFBC4726, 0xD4C7C8BF, 0x1F91B31A,
+		0x47874904, 0x8CD132A1, 0xB1705636, 0x7A262D93, 0x2230D78D,
+		0xE966AC28, 0x921D23B1, 0x594B5814, 0x015DA20A, 0xCA0BD9AF,
+		0x6498B1ED, 0xAFCECA48, 0xF7D83056, 0x3C8E4BF3, 0x47F5C46A,
+		0x8CA3BFCF, 0xD4B545D1, 0x1FE33E74, 0x22425AE3, 0xE9142146,
+		0xB102DB58, 0x7A54A0FD, 0x012F2F64, 0xCA7954C1, 0x926FAEDF,
+		0x5939D57A, 0xE92D67F1, 0x227B1C54, 0x7A6DE64A, 0xB13B9DEF,
+		0xCA401276, 0x011669D3, 0x590093CD, 0x9256E868, 0xAFF78CFF,
+		0x64A1F75A, 0x3CB70D44, 0xF7E176E1, 0x8C9AF978, 0x47CC82DD,
+		0x1FDA78C3, 0xD48C0366, 0x4710DEB6, 0x8C46A513, 0xD4505F0D,
+		0x1F0624A8, 0x647DAB31, 0xAF2BD094, 0xF73D2A8A, 0x3C6B512F,
+		0x01CA35B8, 0xCA9C4E1D, 0x928AB403, 0x59DCCFA6, 0x22A7403F,
+		0xE9F13B9A, 0xB1E7C184, 0x7AB1BA21, 0xCAA508AA, 0x01F3730F,
+		0x59E58911, 0x92B3F2B4, 0xE9C87D2D, 0x229E0688, 0x7A88FC96,
+		0xB1DE8733, 0x8C7FE3A4, 0x47299801, 0x1F3F621F, 0xD46919BA,
+		0xAF129623, 0x6444ED86, 0x3C521798, 0xF7046C3D, 0x5997047F,
+		0x92C17FDA, 0xCAD785C4, 0x0181FE61, 0x7AFA71F8, 0xB1AC0A5D,
+		0xE9BAF043, 0x22EC8BE6, 0x1F4DEF71, 0xD41B94D4, 0x8C0D6ECA,
+		0x475B156F, 0x3C209AF6, 0xF776E153, 0xAF601B4D, 0x643660E8,
+		0xD422D263, 0x1F74A9C6, 0x476253D8, 0x8C34287D, 0xF74FA7E4,
+		0x3C19DC41, 0x640F265F, 0xAF595DFA, 0x92F8396D, 0x59AE42C8,
+		0x01B8B8D6, 0xCAEEC373, 0xB1954CEA, 0x7AC3374F, 0x22D5CD51,
+		0xE983B6F4,
+	},
+	{
+		0x00000000, 0x9771F7C1, 0x2B0F9973, 0xBC7E6EB2, 0x561F32E6,
+		0xC16EC527, 0x7D10AB95, 0xEA615C54, 0xAC3E65CC, 0x3B4F920D,
+		0x8731FCBF, 0x10400B7E, 0xFA21572A, 0x6D50A0EB, 0xD12ECE59,
+		0x465F3998, 0x5D90BD69, 0xCAE14AA8, 0x769F241A, 0xE1EED3DB,
+		0x0B8F8F8F, 0x9CFE784E, 0x208016FC, 0xB7F1E13D, 0xF1AED8A5,
+		0x66DF2F64, 0xDAA141D6, 0x4DD0B617, 0xA7B1EA43, 0x30C01D82,
+		0x8CBE7330, 0x1BCF84F1, 0xBB217AD2, 0x2C508D13, 0x902EE3A1,
+		0x075F1460, 0xED3E4834, 0x7A4FBFF5, 0xC631D147, 0x51402686,
+		0x171F1F1E, 0x806EE8DF, 0x3C10866D, 0xAB6171AC, 0x41002DF8,
+		0xD671DA39, 0x6A0FB48B, 0xFD7E434A, 0xE6B1C7BB, 0x71C0307A,
+		0xCDBE5EC8, 0x5ACFA909, 0xB0AEF55D, 0x27DF029C, 0x9BA16C2E,
+		0x0CD09BEF, 0x4A8FA277, 0xDDFE55B6, 0x61803B04, 0xF6F1CCC5,
+		0x1C909091, 0x8BE16750, 0x379F09E2, 0xA0EEFE23, 0x73AE8355,
+		0xE4DF7494, 0x58A11A26, 0xCFD0EDE7, 0x25B1B1B3, 0xB2C04672,
+		0x0EBE28C0, 0x99CFDF01, 0xDF90E699, 0x48E11158, 0xF49F7FEA,
+		0x63EE882B, 0x898FD47F, 0x1EFE23BE, 0xA2804D0C, 0x35F1BACD,
+		0x2E3E3E3C, 0xB94FC9FD, 0x0531A74F, 0x9240508E, 0x78210CDA,
+		0xEF50FB1B, 0x532E95A9, 0xC45F6268, 0x82005BF0, 0x1571AC31,
+		0xA90FC283, 0x3E7E3542, 0xD41F6916, 0x436E9ED7, 0xFF10F065,
+		0x686107A4, 0xC88FF987, 0x5FFE0E46, 0xE38060F4, 0x74F19735,
+		0x9E90CB61, 0x09E13CA0, 0xB59F5212, 0x22EEA5D3, 0x64B19C4B,
+		0xF3C06B8A, 0x4FBE0538, 0xD8CFF2F9, 0x32AEAEAD, 0xA5DF596C,
+		0x19A137DE, 0x8ED0C01F, 0x951F44EE, 0x026EB32F, 0xBE10DD9D,
+		0x29612A5C, 0xC3007608, 0x547181C9, 0xE80FEF7B, 0x7F7E18BA,
+		0x39212122, 0xAE50D6E3, 0x122EB851, 0x855F4F90, 0x6F3E13C4,
+		0xF84FE405, 0x44318AB7, 0xD3407D76, 0xE75D06AA, 0x702CF16B,
+		0xCC529FD9, 0x5B236818, 0xB142344C, 0x2633C38D, 0x9A4DAD3F,
+		0x0D3C5AFE, 0x4B636366, 0xDC1294A7, 0x606CFA15, 0xF71D0DD4,
+		0x1D7C5180, 0x8A0DA641, 0x3673C8F3, 0xA1023F32, 0xBACDBBC3,
+		0x2DBC4C02, 0x91C222B0, 0x06B3D571, 0xECD28925, 0x7BA37EE4,
+		0xC7DD1056, 0x50ACE797, 0x16F3DE0F, 0x818229CE, 0x3DFC477C,
+		0xAA8DB0BD, 0x40ECECE9, 0xD79D1B28, 0x6BE3759A, 0xFC92825B,
+		0x5C7C7C78, 0xCB0D8BB9, 0x7773E50B, 0xE00212CA, 0x0A634E9E,
+		0x9D12B95F, 0x216CD7ED, 0xB61D202C, 0xF04219B4, 0x6733EE75,
+		0xDB4D80C7, 0x4C3C7706, 0xA65D2B52, 0x312CDC93, 0x8D52B221,
+		0x1A2345E0, 0x01ECC111, 0x969D36D0, 0x2AE35862, 0xBD92AFA3,
+		0x57F3F3F7, 0xC0820436, 0x7CFC6A84, 0xEB8D9D45, 0xADD2A4DD,
+		0x3AA3531C, 0x86DD3DAE, 0x11ACCA6F, 0xFBCD963B, 0x6CBC61FA,
+		0xD0C20F48, 0x47B3F889, 0x94F385FF, 0x0382723E, 0xBFFC1C8C,
+		0x288DEB4D, 0xC2ECB719, 0x559D40D8, 0xE9E32E6A, 0x7E92D9AB,
+		0x38CDE033, 0xAFBC17F2, 0x13C27940, 0x84B38E81, 0x6ED2D2D5,
+		0xF9A32514, 0x45DD4BA6, 0xD2ACBC67, 0xC9633896, 0x5E12CF57,
+		0xE26CA1E5, 0x751D5624, 0x9F7C0A70, 0x080DFDB1, 0xB4739303,
+		0x230264C2, 0x655D5D5A, 0xF22CAA9B, 0x4E52C429, 0xD92333E8,
+		0x33426FBC, 0xA433987D, 0x184DF6CF, 0x8F3C010E, 0x2FD2FF2D,
+		0xB8A308EC, 0x04DD665E, 0x93AC919F, 0x79CDCDCB, 0xEEBC3A0A,
+		0x52C254B8, 0xC5B3A379, 0x83EC9AE1, 0x149D6D20, 0xA8E30392,
+		0x3F92F453, 0xD5F3A807, 0x42825FC6, 0xFEFC3174, 0x698DC6B5,
+		0x72424244, 0xE533B585, 0x594DDB37, 0xCE3C2CF6, 0x245D70A2,
+		0xB32C8763, 0x0F52E9D1, 0x98231E10, 0xDE7C2788, 0x490DD049,
+		0xF573BEFB, 0x6202493A, 0x8863156E, 0x1F12E2AF, 0xA36C8C1D,
+		0x341D7BDC,
+	},
+	{
+		0x00000000, 0x3171D430, 0x62E3A860, 0x53927C50, 0xC5C750C0,
+		0xF4B684F0, 0xA724F8A0, 0x96552C90, 0x8E62D771, 0xBF130341,
+		0xEC817F11, 0xDDF0AB21, 0x4BA587B1, 0x7AD45381, 0x29462FD1,
+		0x1837FBE1, 0x1929D813, 0x28580C23, 0x7BCA7073, 0x4ABBA443,
+		0xDCEE88D3, 0xED9F5CE3, 0xBE0D20B3, 0x8F7CF483, 0x974B0F62,
+		0xA63ADB52, 0xF5A8A702, 0xC4D97332, 0x528C5FA2, 0x63FD8B92,
+		0x306FF7C2, 0x011E23F2, 0x3253B026, 0x03226416, 0x50B01846,
+		0x61C1CC76, 0xF794E0E6, 0xC6E534D6, 0x95774886, 0xA4069CB6,
+		0xBC316757, 0x8D40B367, 0xDED2CF37, 0xEFA31B07, 0x79F63797,
+		0x4887E3A7, 0x1B159FF7, 0x2A644BC7, 0x2B7A6835, 0x1A0BBC05,
+		0x4999C055, 0x78E81465, 0xEEBD38F5, 0xDFCCECC5, 0x8C5E9095,
+		0xBD2F44A5, 0xA518BF44, 0x94696B74, 0xC7FB1724, 0xF68AC314,
+		0x60DFEF84, 0x51AE3BB4, 0x023C47E4, 0x334D93D4, 0x64A7604C,
+		0x55D6B47C, 0x0644C82C, 0x37351C1C, 0xA160308C, 0x9011E4BC,
+		0xC38398EC, 0xF2F24CDC, 0xEAC5B73D, 0xDBB4630D, 0x88261F5D,
+		0xB957CB6D, 0x2F02E7FD, 0x1E7333CD, 0x4DE14F9D, 0x7C909BAD,
+		0x7D8EB85F, 0x4CFF6C6F, 0x1F6D103F, 0x2E1CC40F, 0xB849E89F,
+		0x89383CAF, 0xDAAA40FF, 0xEBDB94CF, 0xF3EC6F2E, 0xC29DBB1E,
+		0x910FC74E, 0xA07E137E, 0x362B3FEE, 0x075AEBDE, 0x54C8978E,
+		0x65B943BE, 0x56F4D06A, 0x6785045A, 0x3417780A, 0x0566AC3A,
+		0x933380AA, 0xA242549A, 0xF1D028CA, 0xC0A1FCFA, 0xD896071B,
+		0xE9E7D32B, 0xBA75AF7B, 0x8B047B4B, 0x1D5157DB, 0x2C2083EB,
+		0x7FB2FFBB, 0x4EC32B8B, 0x4FDD0879, 0x7EACDC49, 0x2D3EA019,
+		0x1C4F7429, 0x8A1A58B9, 0xBB6B8C89, 0xE8F9F0D9, 0xD98824E9,
+		0xC1BFDF08, 0xF0CE0B38, 0xA35C7768, 0x922DA358, 0x04788FC8,
+		0x35095BF8, 0x669B27A8, 0x57EAF398, 0xC94EC098, 0xF83F14A8,
+		0xABAD68F8, 0x9ADCBCC8, 0x0C899058, 0x3DF84468, 0x6E6A3838,
+		0x5F1BEC08, 0x472C17E9, 0x765DC3D9, 0x25CFBF89, 0x14BE6BB9,
+		0x82EB4729, 0xB39A9319, 0xE008EF49, 0xD1793B79, 0xD067188B,
+		0xE116CCBB, 0xB284B0EB, 0x83F564DB, 0x15A0484B, 0x24D19C7B,
+		0x7743E02B, 0x4632341B, 0x5E05CFFA, 0x6F741BCA, 0x3CE6679A,
+		0x0D97B3AA, 0x9BC29F3A, 0xAAB34B0A, 0xF921375A, 0xC850E36A,
+		0xFB1D70BE, 0xCA6CA48E, 0x99FED8DE, 0xA88F0CEE, 0x3EDA207E,
+		0x0FABF44E, 0x5C39881E, 0x6D485C2E, 0x757FA7CF, 0x440E73FF,
+		0x179C0FAF, 0x26EDDB9F, 0xB0B8F70F, 0x81C9233F, 0xD25B5F6F,
+		0xE32A8B5F, 0xE234A8AD, 0xD3457C9D, 0x80D700CD, 0xB1A6D4FD,
+		0x27F3F86D, 0x16822C5D, 0x4510500D, 0x7461843D, 0x6C567FDC,
+		0x5D27ABEC, 0x0EB5D7BC, 0x3FC4038C, 0xA9912F1C, 0x98E0FB2C,
+		0xCB72877C, 0xFA03534C, 0xADE9A0D4, 0x9C9874E4, 0xCF0A08B4,
+		0xFE7BDC84, 0x682EF014, 0x595F2424, 0x0ACD5874, 0x3BBC8C44,
+		0x238B77A5, 0x12FAA395, 0x4168DFC5, 0x70190BF5, 0xE64C2765,
+		0xD73DF355, 0x84AF8F05, 0xB5DE5B35, 0xB4C078C7, 0x85B1ACF7,
+		0xD623D0A7, 0xE7520497, 0x71072807, 0x4076FC37, 0x13E48067,
+		0x22955457, 0x3AA2AFB6, 0x0BD37B86, 0x584107D6, 0x6930D3E6,
+		0xFF65FF76, 0xCE142B46, 0x9D865716, 0xACF78326, 0x9FBA10F2,
+		0xAECBC4C2, 0xFD59B892, 0xCC286CA2, 0x5A7D4032, 0x6B0C9402,
+		0x389EE852, 0x09EF3C62, 0x11D8C783, 0x20A913B3, 0x733B6FE3,
+		0x424ABBD3, 0xD41F9743, 0xE56E4373, 0xB6FC3F23, 0x878DEB13,
+		0x8693C8E1, 0xB7E21CD1, 0xE4706081, 0xD501B4B1, 0x43549821,
+		0x72254C11, 0x21B73041, 0x10C6E471, 0x08F11F90, 0x3980CBA0,
+		0x6A12B7F0, 0x5B6363C0, 0xCD364F50, 0xFC479B60, 0xAFD5E730,
+		0x9EA43300,
+	},
+	{
+		0x00000000, 0x30D23865, 0x61A470CA, 0x517648AF, 0xC348E194,
+		0xF39AD9F1, 0xA2EC915E, 0x923EA93B, 0x837DB5D9, 0xB3AF8DBC,
+		0xE2D9C513, 0xD20BFD76, 0x4035544D, 0x70E76C28, 0x21912487,
+		0x11431CE2, 0x03171D43, 0x33C52526, 0x62B36D89, 0x526155EC,
+		0xC05FFCD7, 0xF08DC4B2, 0xA1FB8C1D, 0x9129B478, 0x806AA89A,
+		0xB0B890FF, 0xE1CED850, 0xD11CE035, 0x4322490E, 0x73F0716B,
+		0x228639C4, 0x125401A1, 0x062E3A86, 0x36FC02E3, 0x678A4A4C,
+		0x57587229, 0xC566DB12, 0xF5B4E377, 0xA4C2ABD8, 0x941093BD,
+		0x85538F5F, 0xB581B73A, 0xE4F7FF95, 0xD425C7F0, 0x461B6ECB,
+		0x76C956AE, 0x27BF1E01, 0x176D2664, 0x053927C5, 0x35EB1FA0,
+		0x649D570F, 0x544F6F6A, 0xC671C651, 0xF6A3FE34, 0xA7D5B69B,
+		0x97078EFE, 0x8644921C, 0xB696AA79, 0xE7E0E2D6, 0xD732DAB3,
+		0x450C7388, 0x75DE4BED, 0x24A80342, 0x147A3B27, 0x0C5C750C,
+		0x3C8E4D69, 0x6DF805C6, 0x5D2A3DA3, 0xCF149498, 0xFFC6ACFD,
+		0xAEB0E452, 0x9E62DC37, 0x8F21C0D5, 0xBFF3F8B0, 0xEE85B01F,
+		0xDE57887A, 0x4C692141, 0x7CBB1924, 0x2DCD518B, 0x1D1F69EE,
+		0x0F4B684F, 0x3F99502A, 0x6EEF1885, 0x5E3D20E0, 0xCC0389DB,
+		0xFCD1B1BE, 0xADA7F911, 0x9D75C174, 0x8C36DD96, 0xBCE4E5F3,
+		0xED92AD5C, 0xDD409539, 0x4F7E3C02, 0x7FAC0467, 0x2EDA4CC8,
+		0x1E0874AD, 0x0A724F8A, 0x3AA077EF, 0x6BD63F40, 0x5B040725,
+		0xC93AAE1E, 0xF9E8967B, 0xA89EDED4, 0x984CE6B1, 0x890FFA53,
+		0xB9DDC236, 0xE8AB8A99, 0xD879B2FC, 0x4A471BC7, 0x7A9523A2,
+		0x2BE36B0D, 0x1B315368, 0x096552C9, 0x39B76AAC, 0x68C12203,
+		0x58131A66, 0xCA2DB35D, 0xFAFF8B38, 0xAB89C397, 0x9B5BFBF2,
+		0x8A18E710, 0xBACADF75, 0xEBBC97DA, 0xDB6EAFBF, 0x49500684,
+		0x79823EE1, 0x28F4764E, 0x18264E2B, 0x18B8EA18, 0x286AD27D,
+		0x791C9AD2, 0x49CEA2B7, 0xDBF00B8C, 0xEB2233E9, 0xBA547B46,
+		0x8A864323, 0x9BC55FC1, 0xAB1767A4, 0xFA612F0B, 0xCAB3176E,
+		0x588DBE55, 0x685F8630, 0x3929CE9F, 0x09FBF6FA, 0x1BAFF75B,
+		0x2B7DCF3E, 0x7A0B8791, 0x4AD9BFF4, 0xD8E716CF, 0xE8352EAA,
+		0xB9436605, 0x89915E60, 0x98D24282, 0xA8007AE7, 0xF9763248,
+		0xC9A40A2D, 0x5B9AA316, 0x6B489B73, 0x3A3ED3DC, 0x0AECEBB9,
+		0x1E96D09E, 0x2E44E8FB, 0x7F32A054, 0x4FE09831, 0xDDDE310A,
+		0xED0C096F, 0xBC7A41C0, 0x8CA879A5, 0x9DEB6547, 0xAD395D22,
+		0xFC4F158D, 0xCC9D2DE8, 0x5EA384D3, 0x6E71BCB6, 0x3F07F419,
+		0x0FD5CC7C, 0x1D81CDDD, 0x2D53F5B8, 0x7C25BD17, 0x4CF78572,
+		0xDEC92C49, 0xEE1B142C, 0xBF6D5C83, 0x8FBF64E6, 0x9EFC7804,
+		0xAE2E4061, 0xFF5808CE, 0xCF8A30AB, 0x5DB49990, 0x6D66A1F5,
+		0x3C10E95A, 0x0CC2D13F, 0x14E49F14, 0x2436A771, 0x7540EFDE,
+		0x4592D7BB, 0xD7AC7E80, 0xE77E46E5, 0xB6080E4A, 0x86DA362F,
+		0x97992ACD, 0xA74B12A8, 0xF63D5A07, 0xC6EF6262, 0x54D1CB59,
+		0x6403F33C, 0x3575BB93, 0x05A783F6, 0x17F38257, 0x2721BA32,
+		0x7657F29D, 0x4685CAF8, 0xD4BB63C3, 0xE4695BA6, 0xB51F1309,
+		0x85CD2B6C, 0x948E378E, 0xA45C0FEB, 0xF52A4744, 0xC5F87F21,
+		0x57C6D61A, 0x6714EE7F, 0x3662A6D0, 0x06B09EB5, 0x12CAA592,
+		0x22189DF7, 0x736ED558, 0x43BCED3D, 0xD1824406, 0xE1507C63,
+		0xB02634CC, 0x80F40CA9, 0x91B7104B, 0xA165282E, 0xF0136081,
+		0xC0C158E4, 0x52FFF1DF, 0x622DC9BA, 0x335B8115, 0x0389B970,
+		0x11DDB8D1, 0x210F80B4, 0x7079C81B, 0x40ABF07E, 0xD2955945,
+		0xE2476120, 0xB331298F, 0x83E311EA, 0x92A00D08, 0xA272356D,
+		0xF3047DC2, 0xC3D645A7, 0x51E8EC9C, 0x613AD4F9, 0x304C9C56,
+		0x009EA433,
+	},
+	{
+		0x00000000, 0x54075546, 0xA80EAA8C, 0xFC09FFCA, 0x55F123E9,
+		0x01F676AF, 0xFDFF8965, 0xA9F8DC23, 0xABE247D2, 0xFFE51294,
+		0x03ECED5E, 0x57EBB818, 0xFE13643B, 0xAA14317D, 0x561DCEB7,
+		0x021A9BF1, 0x5228F955, 0x062FAC13, 0xFA2653D9, 0xAE21069F,
+		0x07D9DABC, 0x53DE8FFA, 0xAFD77030, 0xFBD02576, 0xF9CABE87,
+		0xADCDEBC1, 0x51C4140B, 0x05C3414D, 0xAC3B9D6E, 0xF83CC828,
+		0x043537E2, 0x503262A4, 0xA451F2AA, 0xF056A7EC, 0x0C5F5826,
+		0x58580D60, 0xF1A0D143, 0xA5A78405, 0x59AE7BCF, 0x0DA92E89,
+		0x0FB3B578, 0x5BB4E03E, 0xA7BD1FF4, 0xF3BA4AB2, 0x5A429691,
+		0x0E45C3D7, 0xF24C3C1D, 0xA64B695B, 0xF6790BFF, 0xA27E5EB9,
+		0x5E77A173, 0x0A70F435, 0xA3882816, 0xF78F7D50, 0x0B86829A,
+		0x5F81D7DC, 0x5D9B4C2D, 0x099C196B, 0xF595E6A1, 0xA192B3E7,
+		0x086A6FC4, 0x5C6D3A82, 0xA064C548, 0xF463900E, 0x4D4F93A5,
+		0x1948C6E3, 0xE5413929, 0xB1466C6F, 0x18BEB04C, 0x4CB9E50A,
+		0xB0B01AC0, 0xE4B74F86, 0xE6ADD477, 0xB2AA8131, 0x4EA37EFB,
+		0x1AA42BBD, 0xB35CF79E, 0xE75BA2D8, 0x1B525D12, 0x4F550854,
+		0x1F676AF0, 0x4B603FB6, 0xB769C07C, 0xE36E953A, 0x4A964919,
+		0x1E911C5F, 0xE298E395, 0xB69FB6D3, 0xB4852D22, 0xE0827864,
+		0x1C8B87AE, 0x488CD2E8, 0xE1740ECB, 0xB5735B8D, 0x497AA447,
+		0x1D7DF101, 0xE91E610F, 0xBD193449, 0x4110CB83, 0x15179EC5,
+		0xBCEF42E6, 0xE8E817A0, 0x14E1E86A, 0x40E6BD2C, 0x42FC26DD,
+		0x16FB739B, 0xEAF28C51, 0xBEF5D917, 0x170D0534, 0x430A5072,
+		0xBF03AFB8, 0xEB04FAFE, 0xBB36985A, 0xEF31CD1C, 0x133832D6,
+		0x473F6790, 0xEEC7BBB3, 0xBAC0EEF5, 0x46C9113F, 0x12CE4479,
+		0x10D4DF88, 0x44D38ACE, 0xB8DA7504, 0xECDD2042, 0x4525FC61,
+		0x1122A927, 0xED2B56ED, 0xB92C03AB, 0x9A9F274A, 0xCE98720C,
+		0x32918DC6, 0x6696D880, 0xCF6E04A3, 0x9B6951E5, 0x6760AE2F,
+		0x3367FB69, 0x317D6098, 0x657A35DE, 0x9973CA14, 0xCD749F52,
+		0x648C4371, 0x308B1637, 0xCC82E9FD, 0x9885BCBB, 0xC8B7DE1F,
+		0x9CB08B59, 0x60B97493, 0x34BE21D5, 0x9D46FDF6, 0xC941A8B0,
+		0x3548577A, 0x614F023C, 0x635599CD, 0x3752CC8B, 0xCB5B3341,
+		0x9F5C6607, 0x36A4BA24, 0x62A3EF62, 0x9EAA10A8, 0xCAAD45EE,
+		0x3ECED5E0, 0x6AC980A6, 0x96C07F6C, 0xC2C72A2A, 0x6B3FF609,
+		0x3F38A34F, 0xC3315C85, 0x973609C3, 0x952C9232, 0xC12BC774,
+		0x3D2238BE, 0x69256DF8, 0xC0DDB1DB, 0x94DAE49D, 0x68D31B57,
+		0x3CD44E11, 0x6CE62CB5, 0x38E179F3, 0xC4E88639, 0x90EFD37F,
+		0x39170F5C, 0x6D105A1A, 0x9119A5D0, 0xC51EF096, 0xC7046B67,
+		0x93033E21, 0x6F0AC1EB, 0x3B0D94AD, 0x92F5488E, 0xC6F21DC8,
+		0x3AFBE202, 0x6EFCB744, 0xD7D0B4EF, 0x83D7E1A9, 0x7FDE1E63,
+		0x2BD94B25, 0x82219706, 0xD626C240, 0x2A2F3D8A, 0x7E2868CC,
+		0x7C32F33D, 0x2835A67B, 0xD43C59B1, 0x803B0CF7, 0x29C3D0D4,
+		0x7DC48592, 0x81CD7A58, 0xD5CA2F1E, 0x85F84DBA, 0xD1FF18FC,
+		0x2DF6E736, 0x79F1B270, 0xD0096E53, 0x840E3B15, 0x7807C4DF,
+		0x2C009199, 0x2E1A0A68, 0x7A1D5F2E, 0x8614A0E4, 0xD213F5A2,
+		0x7BEB2981, 0x2FEC7CC7, 0xD3E5830D, 0x87E2D64B, 0x73814645,
+		0x27861303, 0xDB8FECC9, 0x8F88B98F, 0x267065AC, 0x727730EA,
+		0x8E7ECF20, 0xDA799A66, 0xD8630197, 0x8C6454D1, 0x706DAB1B,
+		0x246AFE5D, 0x8D92227E, 0xD9957738, 0x259C88F2, 0x719BDDB4,
+		0x21A9BF10, 0x75AEEA56, 0x89A7159C, 0xDDA040DA, 0x74589CF9,
+		0x205FC9BF, 0xDC563675, 0x88516333, 0x8A4BF8C2, 0xDE4CAD84,
+		0x2245524E, 0x76420708, 0xDFBADB2B, 0x8BBD8E6D, 0x77B471A7,
+		0x23B324E1,
+	},
+	{
+		0x00000000, 0x678EFD01, 0xCF1DFA02, 0xA8930703, 0x9BD782F5,
+		0xFC597FF4, 0x54CA78F7, 0x334485F6, 0x3243731B, 0x55CD8E1A,
+		0xFD5E8919, 0x9AD07418, 0xA994F1EE, 0xCE1A0CEF, 0x66890BEC,
+		0x0107F6ED, 0x6486E636, 0x03081B37, 0xAB9B1C34, 0xCC15E135,
+		0xFF5164C3, 0x98DF99C2, 0x304C9EC1, 0x57C263C0, 0x56C5952D,
+		0x314B682C, 0x99D86F2F, 0xFE56922E, 0xCD1217D8, 0xAA9CEAD9,
+		0x020FEDDA, 0x658110DB, 0xC90DCC6C, 0xAE83316D, 0x0610366E,
+		0x619ECB6F, 0x52DA4E99, 0x3554B398, 0x9DC7B49B, 0xFA49499A,
+		0xFB4EBF77, 0x9CC04276, 0x34534575, 0x53DDB874, 0x60993D82,
+		0x0717C083, 0xAF84C780, 0xC80A3A81, 0xAD8B2A5A, 0xCA05D75B,
+		0x6296D058, 0x05182D59, 0x365CA8AF, 0x51D255AE, 0xF94152AD,
+		0x9ECFAFAC, 0x9FC85941, 0xF846A440, 0x50D5A343, 0x375B5E42,
+		0x041FDBB4, 0x639126B5, 0xCB0221B6, 0xAC8CDCB7, 0x97F7EE29,
+		0xF0791328, 0x58EA142B, 0x3F64E92A, 0x0C206CDC, 0x6BAE91DD,
+		0xC33D96DE, 0xA4B36BDF, 0xA5B49D32, 0xC23A6033, 0x6AA96730,
+		0x0D279A31, 0x3E631FC7, 0x59EDE2C6, 0xF17EE5C5, 0x96F018C4,
+		0xF371081F, 0x94FFF51E, 0x3C6CF21D, 0x5BE20F1C, 0x68A68AEA,
+		0x0F2877EB, 0xA7BB70E8, 0xC0358DE9, 0xC1327B04, 0xA6BC8605,
+		0x0E2F8106, 0x69A17C07, 0x5AE5F9F1, 0x3D6B04F0, 0x95F803F3,
+		0xF276FEF2, 0x5EFA2245, 0x3974DF44, 0x91E7D847, 0xF6692546,
+		0xC52DA0B0, 0xA2A35DB1, 0x0A305AB2, 0x6DBEA7B3, 0x6CB9515E,
+		0x0B37AC5F, 0xA3A4AB5C, 0xC42A565D, 0xF76ED3AB, 0x90E02EAA,
+		0x387329A9, 0x5FFDD4A8, 0x3A7CC473, 0x5DF23972, 0xF5613E71,
+		0x92EFC370, 0xA1AB4686, 0xC625BB87, 0x6EB6BC84, 0x09384185,
+		0x083FB768, 0x6FB14A69, 0xC7224D6A, 0xA0ACB06B, 0x93E8359D,
+		0xF466C89C, 0x5CF5CF9F, 0x3B7B329E, 0x2A03AAA3, 0x4D8D57A2,
+		0xE51E50A1, 0x8290ADA0, 0xB1D42856, 0xD65AD557, 0x7EC9D254,
+		0x19472F55, 0x1840D9B8, 0x7FCE24B9, 0xD75D23BA, 0xB0D3DEBB,
+		0x83975B4D, 0xE419A64C, 0x4C8AA14F, 0x2B045C4E, 0x4E854C95,
+		0x290BB194, 0x8198B697, 0xE6164B96, 0xD552CE60, 0xB2DC3361,
+		0x1A4F3462, 0x7DC1C963, 0x7CC63F8E, 0x1B48C28F, 0xB3DBC58C,
+		0xD455388D, 0xE711BD7B, 0x809F407A, 0x280C4779, 0x4F82BA78,
+		0xE30E66CF, 0x84809BCE, 0x2C139CCD, 0x4B9D61CC, 0x78D9E43A,
+		0x1F57193B, 0xB7C41E38, 0xD04AE339, 0xD14D15D4, 0xB6C3E8D5,
+		0x1E50EFD6, 0x79DE12D7, 0x4A9A9721, 0x2D146A20, 0x85876D23,
+		0xE2099022, 0x878880F9, 0xE0067DF8, 0x48957AFB, 0x2F1B87FA,
+		0x1C5F020C, 0x7BD1FF0D, 0xD342F80E, 0xB4CC050F, 0xB5CBF3E2,
+		0xD2450EE3, 0x7AD609E0, 0x1D58F4E1, 0x2E1C7117, 0x49928C16,
+		0xE1018B15, 0x868F7614, 0xBDF4448A, 0xDA7AB98B, 0x72E9BE88,
+		0x15674389, 0x2623C67F, 0x41AD3B7E, 0xE93E3C7D, 0x8EB0C17C,
+		0x8FB73791, 0xE839CA90, 0x40AACD93, 0x27243092, 0x1460B564,
+		0x73EE4865, 0xDB7D4F66, 0xBCF3B267, 0xD972A2BC, 0xBEFC5FBD,
+		0x166F58BE, 0x71E1A5BF, 0x42A52049, 0x252BDD48, 0x8DB8DA4B,
+		0xEA36274A, 0xEB31D1A7, 0x8CBF2CA6, 0x242C2BA5, 0x43A2D6A4,
+		0x70E65352, 0x1768AE53, 0xBFFBA950, 0xD8755451, 0x74F988E6,
+		0x137775E7, 0xBBE472E4, 0xDC6A8FE5, 0xEF2E0A13, 0x88A0F712,
+		0x2033F011, 0x47BD0D10, 0x46BAFBFD, 0x213406FC, 0x89A701FF,
+		0xEE29FCFE, 0xDD6D7908, 0xBAE38409, 0x1270830A, 0x75FE7E0B,
+		0x107F6ED0, 0x77F193D1, 0xDF6294D2, 0xB8EC69D3, 0x8BA8EC25,
+		0xEC261124, 0x44B51627, 0x233BEB26, 0x223C1DCB, 0x45B2E0CA,
+		0xED21E7C9, 0x8AAF1AC8, 0xB9EB9F3E, 0xDE65623F, 0x76F6653C,
+		0x1178983D,
+	},
+	{
+		0x00000000, 0xF20C0DFE, 0xE1F46D0D, 0x13F860F3, 0xC604ACEB,
+		0x3408A115, 0x27F0C1E6, 0xD5FCCC18, 0x89E52F27, 0x7BE922D9,
+		0x6811422A, 0x9A1D4FD4, 0x4FE183CC, 0xBDED8E32, 0xAE15EEC1,
+		0x5C19E33F, 0x162628BF, 0xE42A2541, 0xF7D245B2, 0x05DE484C,
+		0xD0228454, 0x222E89AA, 0x31D6E959, 0xC3DAE4A7, 0x9FC30798,
+		0x6DCF0A66, 0x7E376A95, 0x8C3B676B, 0x59C7AB73, 0xABCBA68D,
+		0xB833C67E, 0x4A3FCB80, 0x2C4C517E, 0xDE405C80, 0xCDB83C73,
+		0x3FB4318D, 0xEA48FD95, 0x1844F06B, 0x0BBC9098, 0xF9B09D66,
+		0xA5A97E59, 0x57A573A7, 0x445D1354, 0xB6511EAA, 0x63ADD2B2,
+		0x91A1DF4C, 0x8259BFBF, 0x7055B241, 0x3A6A79C1, 0xC866743F,
+		0xDB9E14CC, 0x29921932, 0xFC6ED52A, 0x0E62D8D4, 0x1D9AB827,
+		0xEF96B5D9, 0xB38F56E6, 0x41835B18, 0x527B3BEB, 0xA0773615,
+		0x758BFA0D, 0x8787F7F3, 0x947F9700, 0x66739AFE, 0x5898A2FC,
+		0xAA94AF02, 0xB96CCFF1, 0x4B60C20F, 0x9E9C0E17, 0x6C9003E9,
+		0x7F68631A, 0x8D646EE4, 0xD17D8DDB, 0x23718025, 0x3089E0D6,
+		0xC285ED28, 0x17792130, 0xE5752CCE, 0xF68D4C3D, 0x048141C3,
+		0x4EBE8A43, 0xBCB287BD, 0xAF4AE74E, 0x5D46EAB0, 0x88BA26A8,
+		0x7AB62B56, 0x694E4BA5, 0x9B42465B, 0xC75BA564, 0x3557A89A,
+		0x26AFC869, 0xD4A3C597, 0x015F098F, 0xF3530471, 0xE0AB6482,
+		0x12A7697C, 0x74D4F382, 0x86D8FE7C, 0x95209E8F, 0x672C9371,
+		0xB2D05F69, 0x40DC5297, 0x53243264, 0xA1283F9A, 0xFD31DCA5,
+		0x0F3DD15B, 0x1CC5B1A8, 0xEEC9BC56, 0x3B35704E, 0xC9397DB0,
+		0xDAC11D43, 0x28CD10BD, 0x62F2DB3D, 0x90FED6C3, 0x8306B630,
+		0x710ABBCE, 0xA4F677D6, 0x56FA7A28, 0x45021ADB, 0xB70E1725,
+		0xEB17F41A, 0x191BF9E4, 0x0AE39917, 0xF8EF94E9, 0x2D1358F1,
+		0xDF1F550F, 0xCCE735FC, 0x3EEB3802, 0xB13145F8, 0x433D4806,
+		0x50C528F5, 0xA2C9250B, 0x7735E913, 0x8539E4ED, 0x96C1841E,
+		0x64CD89E0, 0x38D46ADF, 0xCAD86721, 0xD92007D2, 0x2B2C0A2C,
+		0xFED0C634, 0x0CDCCBCA, 0x1F24AB39, 0xED28A6C7, 0xA7176D47,
+		0x551B60B9, 0x46E3004A, 0xB4EF0DB4, 0x6113C1AC, 0x931FCC52,
+		0x80E7ACA1, 0x72EBA15F, 0x2EF24260, 0xDCFE4F9E, 0xCF062F6D,
+		0x3D0A2293, 0xE8F6EE8B, 0x1AFAE375, 0x09028386, 0xFB0E8E78,
+		0x9D7D1486, 0x6F711978, 0x7C89798B, 0x8E857475, 0x5B79B86D,
+		0xA975B593, 0xBA8DD560, 0x4881D89E, 0x14983BA1, 0xE694365F,
+		0xF56C56AC, 0x07605B52, 0xD29C974A, 0x20909AB4, 0x3368FA47,
+		0xC164F7B9, 0x8B5B3C39, 0x795731C7, 0x6AAF5134, 0x98A35CCA,
+		0x4D5F90D2, 0xBF539D2C, 0xACABFDDF, 0x5EA7F021, 0x02BE131E,
+		0xF0B21EE0, 0xE34A7E13, 0x114673ED, 0xC4BABFF5, 0x36B6B20B,
+		0x254ED2F8, 0xD742DF06, 0xE9A9E704, 0x1BA5EAFA, 0x085D8A09,
+		0xFA5187F7, 0x2FAD4BEF, 0xDDA14611, 0xCE5926E2, 0x3C552B1C,
+		0x604CC823, 0x9240C5DD, 0x81B8A52E, 0x73B4A8D0, 0xA64864C8,
+		0x54446936, 0x47BC09C5, 0xB5B0043B, 0xFF8FCFBB, 0x0D83C245,
+		0x1E7BA2B6, 0xEC77AF48, 0x398B6350, 0xCB876EAE, 0xD87F0E5D,
+		0x2A7303A3, 0x766AE09C, 0x8466ED62, 0x979E8D91, 0x6592806F,
+		0xB06E4C77, 0x42624189, 0x519A217A, 0xA3962C84, 0xC5E5B67A,
+		0x37E9BB84, 0x2411DB77, 0xD61DD689, 0x03E11A91, 0xF1ED176F,
+		0xE215779C, 0x10197A62, 0x4C00995D, 0xBE0C94A3, 0xADF4F450,
+		0x5FF8F9AE, 0x8A0435B6, 0x78083848, 0x6BF058BB, 0x99FC5545,
+		0xD3C39EC5, 0x21CF933B, 0x3237F3C8, 0xC03BFE36, 0x15C7322E,
+		0xE7CB3FD0, 0xF4335F23, 0x063F52DD, 0x5A26B1E2, 0xA82ABC1C,
+		0xBBD2DCEF, 0x49DED111, 0x9C221D09, 0x6E2E10F7, 0x7DD67004,
+		0x8FDA7DFA,
+	},
+};
@@ -0,0 +1,10 @@
+/*
+ * #@"crc_crc32c_slow.c"
+ */
+
+#define CRC_CRC32C
+
+#define crcSlow(a, b) cc_crc32c_crcSlow(a, b)
+
+#include "crc_slow.h"
+
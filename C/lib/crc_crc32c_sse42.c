@@ -0,0 +1,159 @@
+/*
+ * #@ "crc_crc32c_sse42.c"
+ *
+ * Author : Christian CAMIER (chcamier@free.fr)
+ *
+ * CRC-32C division using the SSE4.2 crc32 instruction.
+ *
+ * The instruction has a latency of three cycles but a throughput of
+ * one per cycle, so large buffers are divided as three interleaved
+ * streams whose remainders are merged using precomputed "shift over
+ * zero bytes" tables (see crc_gf2.c). This is Mark Adler's layout.
+ *
+ * History :
+ * ---------
+ *
+ * Oct 18, 2026: Christian CAMIER
+ *	v1.0 :	Creation
+ */
+
+#define CRC_CRC32C
+#include "crc_internal.h"
+
+#if defined(CRC_HAVE_X86_ACCEL)
+
+#include <string.h>
+#include <nmmintrin.h>
+
+#define STREAM_LONG	8192
+#define STREAM_SHORT	256
+
+extern void       cc_crc_crc32c_sse42_init(void);
+extern cc_crc32_t cc_crc_crc32c_sse42     (cc_crc32_t, const uint8_t *, size_t);
+
+static void       shift_init(cc_crc32_t [4][256], size_t);
+static cc_crc32_t shift(const cc_crc32_t [4][256], cc_crc32_t);
+
+static cc_crc32_t shift_long [4][256];
+static cc_crc32_t shift_short[4][256];
+
+/*********************************************************************
+ *
+ * Function:    cc_crc_crc32c_sse42_init()
+ *
+ * Description: Build the stream merging tables.
+ *
+ * Notes:	Must be called once before cc_crc_crc32c_sse42().
+ *
+ *********************************************************************/
+void
+cc_crc_crc32c_sse42_init(void)
+{
+	shift_init(shift_long,  STREAM_LONG);
+	shift_init(shift_short, STREAM_SHORT);
+}
+
+/*********************************************************************
+ *
+ * Function:    cc_crc_crc32c_sse42()
+ *
+ * Description: Divide the message by the CRC-32C polynomial starting
+ *		with the given reflected remainder.
+ *
+ * Returns:	The reflected remainder.
+ *
+ *********************************************************************/
+__attribute__((target("sse4.2"))) cc_crc32_t
+cc_crc_crc32c_sse42(cc_crc32_t remainder, const uint8_t *message, size_t nBytes)
+{
+	const uint8_t *end;
+	uint64_t       crc0;
+	uint64_t       crc1;
+	uint64_t       crc2;
+	uint64_t       word0;
+	uint64_t       word1;
+	uint64_t       word2;
+
+	crc0 = remainder;
+
+	/*
+	 * Bring the message pointer to an 8 bytes boundary.
+	 */
+	for (; nBytes > 0 && 0 != ((uintptr_t)message & 7); nBytes -= 1, message += 1)
+		crc0 = _mm_crc32_u8((uint32_t)crc0, *message);
+
+	/*
+	 * Three interleaved streams of STREAM_LONG, then STREAM_SHORT bytes.
+	 */
+	for (; nBytes >= 3 * STREAM_LONG; nBytes -= 3 * STREAM_LONG, message += 2 * STREAM_LONG)
+	{
+		crc1 = crc2 = 0;
+		for (end = message + STREAM_LONG; message < end; message += 8)
+		{
+			(void)memcpy(&word0, message,                   8);
+			(void)memcpy(&word1, message +     STREAM_LONG, 8);
+			(void)memcpy(&word2, message + 2 * STREAM_LONG, 8);
+			crc0 = _mm_crc32_u64(crc0, word0);
+			crc1 = _mm_crc32_u64(crc1, word1);
+			crc2 = _mm_crc32_u64(crc2, word2);
+		}
+		crc0 = shift(shift_long, (cc_crc32_t)crc0) ^ crc1;
+		crc0 = shift(shift_long, (cc_crc32_t)crc0) ^ crc2;
+	}
+
+	for (; nBytes >= 3 * STREAM_SHORT; nBytes -= 3 * STREAM_SHORT, message += 2 * STREAM_SHORT)
+	{
+		crc1 = crc2 = 0;
+		for (end = message + STREAM_SHORT; message < end; message += 8)
+		{
+			(void)memcpy(&word0, message,                    8);
+			(void)memcpy(&word1, message +     STREAM_SHORT, 8);
+			(void)memcpy(&word2, message + 2 * STREAM_SHORT, 8);
+			crc0 = _mm_crc32_u64(crc0, word0);
+			crc1 = _mm_crc32_u64(crc1, word1);
+			crc2 = _mm_crc32_u64(crc2, word2);
+		}
+		crc0 = shift(shift_short, (cc_crc32_t)crc0) ^ crc1;
+		crc0 = shift(shift_short, (cc_crc32_t)crc0) ^ crc2;
+	}
+
+	/*
+	 * Remaining words, then remaining bytes.
+	 */
+	for (; nBytes >= 8; nBytes -= 8, message += 8)
+	{
+		(void)memcpy(&word0, message, 8);
+		crc0 = _mm_crc32_u64(crc0, word0);
+	}
+
+	for (; nBytes > 0; nBytes -= 1, message += 1)
+		crc0 = _mm_crc32_u8((uint32_t)crc0, *message);
+
+	return (cc_crc32_t)crc0;
+}
+
+/*
+ * Tables applying the "append nBytes zero bytes" operator to each
+ * byte of a remainder.
+ */
+static void
+shift_init(cc_crc32_t table[4][256], size_t nBytes)
+{
+	uint64_t op[32];
+	unsigned byte;
+	unsigned n;
+
+	cc_crc_gf2_zeros(op, 32, POLYNOMIAL, 1, nBytes);
+	for (n = 0; n < 256; n += 1)
+		for (byte = 0; byte < 4; byte += 1)
+			table[byte][n] = (cc_crc32_t)cc_crc_gf2_times(op, (uint64_t)n << (8 * byte));
+}
+
+static cc_crc32_t
+shift(const cc_crc32_t table[4][256], cc_crc32_t crc)
+{
+	return table[0][ crc        & 0xFF] ^ table[1][(crc >>  8) & 0xFF] ^
+	       table[2][(crc >> 16) & 0xFF] ^ table[3][ crc >> 24        ];
+}
+
+#endif /* CRC_HAVE_X86_ACCEL */
@@ -0,0 +1,59 @@
+/*
+ * #@ "crc_crc64xz.c"
+ *
+ * Author : Christian CAMIER (chcamier@free.fr)
+ *
+ * CRC-64/XZ, on top of the generic engine (crc_engine.c).
+ *
+ * History :
+ * ---------
+ *
+ * Oct 18, 2026: Christian CAMIER
+ *	v1.0 :	Creation
+ */
+
+#include <CCA/crc.h>
+
+static cc_crc_engine_t engine;
+
+static __attribute__((constructor)) void crc64xz_ctor(void)
+{
+	(void)cc_crc_engine_init(&engine, &cc_crc_model_crc64xz);
+	return;
+}
+
+cc_crc64_t
+cc_crc64xz_crcSlow(const void *data, size_t nBytes)
+{
+	return cc_crc_engine_crcSlow(&engine, data, nBytes);
+}
+
+cc_crc64_t
+cc_crc64xz_crcFast(const void *data, size_t nBytes)
+{
+	return cc_crc_engine_crcFast(&engine, data, nBytes);
+}
+
+cc_crc64_t *
+cc_crc64xz_crcStart(cc_crc64_t *context)
+{
+	return cc_crc_engine_crcStart(&engine, context);
+}
+
+cc_crc64_t *
+cc_crc64xz_crcAppnd(cc_crc64_t *context, const void *data, size_t nBytes)
+{
+	return cc_crc_engine_crcAppnd(&engine, context, data, nBytes);
+}
+
+cc_crc64_t
+cc_crc64xz_crcClose(cc_crc64_t *context)
+{
+	return cc_crc_engine_crcClose(&engine, context);
+}
+
+cc_crc64_t
+cc_crc64xz_combine(cc_crc64_t crcA, cc_crc64_t crcB, size_t lenB)
+{
+	return cc_crc_engine_combine(&engine, crcA, crcB, lenB);
+}
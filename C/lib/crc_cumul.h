@@ -19,10 +19,19 @@
 
 #include "crc_internal.h"
 
+#if defined(CRC_SLICE_TABLE)
+#include "crc_slice.h"
+#endif
+
+/*
+ * The context holds the division register : the reflected remainder
+ * for reflected families, the plain remainder otherwise.
+ */
+
 CRC_TYPE *
 crcStart(CRC_TYPE *context)
 {
-	*context = INITIAL_REMAINDER;
+	*context = CRC_REGISTER_INIT;
 	return context;
 }
 
@@ -31,21 +40,39 @@ crcAppnd(CRC_TYPE *context, const void *data, size_t nBytes)
 {
 	register uint8_t  *message;
 	register CRC_TYPE  remainder;
-	register uint8_t   cdat;
 	register size_t    byte;
 
 	remainder = *context;
 
 	message = (uint8_t *)data;
 
+#if defined(CRC_ACCEL)
 	/*
-	 * Divide the message by the polynomial, a byte at a time.
+	 * Use the CPU specific division when available.
 	 */
-	for (byte = 0; byte < nBytes; byte += 1, message += 1)
+	if (nBytes >= CRC_ACCEL_MINIMUM && NULL != CRC_ACCEL)
+	{
+		*context = CRC_ACCEL(remainder, message, nBytes);
+		return context;
+	}
+#endif
+
+#if defined(CRC_SLICE_TABLE)
+	/*
+	 * Large messages are divided several bytes at a time.
+	 */
+	if (nBytes >= CRC_SLICE_MINIMUM)
 	{
-		cdat = REFLECT_DATA(*message) ^ (remainder >> (WIDTH - 8));
-		remainder = CRC_TABLE[cdat] ^ (remainder << 8);
+		*context = crcSlice(remainder, message, nBytes);
+		return context;
 	}
+#endif
+
+	/*
+	 * Divide the message by the polynomial, a byte at a time.
+	 */
+	for (byte = 0; byte < nBytes; byte += 1, message += 1)
+		remainder = CRC_BYTE_STEP(remainder, *message);
 
 	*context = remainder;
 	return context;
@@ -54,5 +81,5 @@ crcAppnd(CRC_TYPE *context, const void *data, size_t nBytes)
 CRC_TYPE
 crcClose(CRC_TYPE *context)
 {
-	return (REFLECT_REMAINDER(*context) ^ FINAL_XOR_VALUE);
+	return CRC_REGISTER_FINAL(*context);
 }
@@ -0,0 +1,321 @@
+/*
+ * #@ "crc_engine.c"
+ *
+ * Author : Christian CAMIER (chcamier@free.fr)
+ *
+ * Generic CRC engine working from the Rocksoft model parameters.
+ *
+ * The division table is computed by cc_crc_engine_init, so a new CRC
+ * only needs its model. The register is held in the smallest unsigned
+ * type of 8, 16, 32 or 64 bits able to contain it, and the division
+ * loop specialised for that type (see crc_engine.h) is selected at
+ * initialization.
+ *
+ * History :
+ * ---------
+ *
+ * Oct 18, 2026: Christian CAMIER
+ *	v1.0 :	Creation
+ */
+
+#include <errno.h>
+
+#define CRC_CRC32
+#include "crc_internal.h"
+
+#define ENGINE_TYPE	uint8_t
+#define ENGINE_TABLE	t08
+#define ENGINE_DIVIDE	engine_divide08
+#include "crc_engine.h"
+
+#define ENGINE_TYPE	uint16_t
+#define ENGINE_TABLE	t16
+#define ENGINE_DIVIDE	engine_divide16
+#include "crc_engine.h"
+
+#define ENGINE_TYPE	uint32_t
+#define ENGINE_TABLE	t32
+#define ENGINE_DIVIDE	engine_divide32
+#include "crc_engine.h"
+
+#define ENGINE_TYPE	uint64_t
+#define ENGINE_TABLE	t64
+#define ENGINE_DIVIDE	engine_divide64
+#include "crc_engine.h"
+
+/*
+ * Predefined models.
+ */
+const cc_crc_model_t cc_crc_model_ccitt = {
+	"CRC-CCITT", 16, 0x1021, 0xFFFF, 0, 0, 0x0000, 0x29B1
+};
+const cc_crc_model_t cc_crc_model_crc16 = {
+	"CRC-16", 16, 0x8005, 0x0000, 1, 1, 0x0000, 0xBB3D
+};
+const cc_crc_model_t cc_crc_model_crc32 = {
+	"CRC-32", 32, 0x04C11DB7, 0xFFFFFFFF, 1, 1, 0xFFFFFFFF, 0xCBF43926
+};
+const cc_crc_model_t cc_crc_model_crc32c = {
+	"CRC-32C", 32, 0x1EDC6F41, 0xFFFFFFFF, 1, 1, 0xFFFFFFFF, 0xE3069283
+};
+const cc_crc_model_t cc_crc_model_crc64ecma = {
+	"CRC-64/ECMA-182", 64, 0x42F0E1EBA9EA3693ULL, 0x0000000000000000ULL,
+	0, 0, 0x0000000000000000ULL, 0x6C40DF5F0B497347ULL
+};
+const cc_crc_model_t cc_crc_model_crc64xz = {
+	"CRC-64/XZ", 64, 0x42F0E1EBA9EA3693ULL, 0xFFFFFFFFFFFFFFFFULL,
+	1, 1, 0xFFFFFFFFFFFFFFFFULL, 0x995DC9BBDF1939FAULL
+};
+
+static uint64_t engine_mask   (unsigned);
+static uint64_t engine_reflect(uint64_t, unsigned);
+static uint64_t engine_to_crc (const cc_crc_engine_t *, uint64_t);
+static uint64_t engine_from_crc(const cc_crc_engine_t *, uint64_t);
+
+/*********************************************************************
+ *
+ * Function:    cc_crc_engine_init()
+ *
+ * Description: Build the engine of a model.
+ *
+ * Returns:	0 on success, -1 with errno set to EINVAL when the
+ *		width is out of range or a parameter does not fit in it.
+ *
+ *********************************************************************/
+int
+cc_crc_engine_init(cc_crc_engine_t *engine, const cc_crc_model_t *model)
+{
+	uint64_t mask;
+	uint64_t poly;
+	uint64_t top;
+	uint64_t remainder;
+	unsigned bits;
+	unsigned n;
+	unsigned bit;
+
+	if (model->cm_width < 1 || model->cm_width > 64)
+		goto invalid;
+	mask = engine_mask(model->cm_width);
+	if (0 != (model->cm_poly   & ~mask) ||
+	    0 != (model->cm_init   & ~mask) ||
+	    0 != (model->cm_xorout & ~mask))
+		goto invalid;
+
+	engine->ce_model = *model;
+
+	if      (model->cm_width <=  8) { bits =  8; engine->ce_divide = engine_divide08; }
+	else if (model->cm_width <= 16) { bits = 16; engine->ce_divide = engine_divide16; }
+	else if (model->cm_width <= 32) { bits = 32; engine->ce_divide = engine_divide32; }
+	else                            { bits = 64; engine->ce_divide = engine_divide64; }
+
+	/*
+	 * Reflected registers are aligned on the low bit, the other ones
+	 * on the high bit of the register type.
+	 */
+	if (model->cm_refin)
+	{
+		engine->ce_shift = 0;
+		engine->ce_init  = engine_reflect(model->cm_init, model->cm_width);
+		poly             = engine_reflect(model->cm_poly, model->cm_width);
+	}
+	else
+	{
+		engine->ce_shift = bits - model->cm_width;
+		engine->ce_init  = model->cm_init << engine->ce_shift;
+		poly             = model->cm_poly << engine->ce_shift;
+	}
+
+	/*
+	 * Divide every byte value by the polynomial.
+	 */
+	mask = engine_mask(bits);
+	top  = (uint64_t)1 << (bits - 1);
+	for (n = 0; n < 256; n += 1)
+	{
+		if (model->cm_refin)
+		{
+			remainder = n;
+			for (bit = 8; bit > 0; bit -= 1)
+				remainder = (remainder & 1) ? (remainder >> 1) ^ poly : (remainder >> 1);
+		}
+		else
+		{
+			remainder = (uint64_t)n << (bits - 8);
+			for (bit = 8; bit > 0; bit -= 1)
+				remainder = ((remainder & top) ? (remainder << 1) ^ poly : (remainder << 1)) & mask;
+		}
+
+		switch (bits)
+		{
+		case  8: engine->ce_table.t08[n] = (uint8_t )remainder; break;
+		case 16: engine->ce_table.t16[n] = (uint16_t)remainder; break;
+		case 32: engine->ce_table.t32[n] = (uint32_t)remainder; break;
+		default: engine->ce_table.t64[n] = (uint64_t)remainder; break;
+		}
+	}
+	return 0;
+
+ invalid:
+	errno = EINVAL;
+	return -1;
+}
+
+/*********************************************************************
+ *
+ * Function:    cc_crc_engine_crcSlow()
+ *
+ * Description: Compute the CRC of a given message, a bit at a time.
+ *
+ * Notes:	Does not use the table : it is the reference the table
+ *		driven functions are checked against.
+ *
+ * Returns:	The CRC of the message.
+ *
+ *********************************************************************/
+cc_crc64_t
+cc_crc_engine_crcSlow(const cc_crc_engine_t *engine, const void *data, size_t nBytes)
+{
+	const cc_crc_model_t *model = &(engine->ce_model);
+	const uint8_t        *message;
+	uint64_t              mask;
+	uint64_t              remainder;
+	uint8_t               byte;
+	int                   bit;
+
+	mask      = engine_mask(model->cm_width);
+	remainder = model->cm_init;
+	message   = (const uint8_t *)data;
+	for (; nBytes > 0; nBytes -= 1, message += 1)
+	{
+		byte = model->cm_refin ? cc_crc_reflect8[*message] : *message;
+		for (bit = 7; bit >= 0; bit -= 1)
+		{
+			if (((byte >> bit) ^ (remainder >> (model->cm_width - 1))) & 1)
+				remainder = ((remainder << 1) ^ model->cm_poly) & mask;
+			else
+				remainder = (remainder << 1) & mask;
+		}
+	}
+
+	if (model->cm_refout)
+		remainder = engine_reflect(remainder, model->cm_width);
+	return remainder ^ model->cm_xorout;
+}
+
+/*********************************************************************
+ *
+ * Function:    cc_crc_engine_crcFast()
+ *
+ * Description: Compute the CRC of a given message.
+ *
+ * Notes:	cc_crc_engine_init() must be called first.
+ *
+ * Returns:	The CRC of the message.
+ *
+ *********************************************************************/
+cc_crc64_t
+cc_crc_engine_crcFast(const cc_crc_engine_t *engine, const void *data, size_t nBytes)
+{
+	return engine_to_crc(engine, engine->ce_divide(engine, engine->ce_init, (const uint8_t *)data, nBytes));
+}
+
+/*
+ * The context holds the division register of the engine.
+ */
+
+cc_crc64_t *
+cc_crc_engine_crcStart(const cc_crc_engine_t *engine, cc_crc64_t *context)
+{
+	*context = engine->ce_init;
+	return context;
+}
+
+cc_crc64_t *
+cc_crc_engine_crcAppnd(const cc_crc_engine_t *engine, cc_crc64_t *context, const void *data, size_t nBytes)
+{
+	*context = engine->ce_divide(engine, *context, (const uint8_t *)data, nBytes);
+	return context;
+}
+
+cc_crc64_t
+cc_crc_engine_crcClose(const cc_crc_engine_t *engine, cc_crc64_t *context)
+{
+	return engine_to_crc(engine, *context);
+}
+
+/*********************************************************************
+ *
+ * Function:    cc_crc_engine_combine()
+ *
+ * Description: Compute the CRC of A followed by B.
+ *
+ * Notes:	See crcCombine() in crc_combine.h.
+ *
+ * Returns:	The CRC of the concatenated message.
+ *
+ *********************************************************************/
+cc_crc64_t
+cc_crc_engine_combine(const cc_crc_engine_t *engine, cc_crc64_t crcA, cc_crc64_t crcB, size_t lenB)
+{
+	const cc_crc_model_t *model = &(engine->ce_model);
+	uint64_t              op[64];
+	uint64_t              shifted;
+
+	if (0 == lenB)
+		return crcA;
+
+	cc_crc_gf2_zeros(op, model->cm_width, model->cm_poly, model->cm_refin, lenB);
+	shifted = cc_crc_gf2_times(op, engine_from_crc(engine, crcA) ^ (engine->ce_init >> engine->ce_shift));
+	return engine_to_crc(engine, (shifted ^ engine_from_crc(engine, crcB)) << engine->ce_shift);
+}
+
+/*
+ * Mask of the `width' low bits.
+ */
+static uint64_t
+engine_mask(unsigned width)
+{
+	return (64 == width) ? ~(uint64_t)0 : (((uint64_t)1 << width) - 1);
+}
+
+/*
+ * Reflection of the `width' low bits, a byte at a time.
+ */
+static uint64_t
+engine_reflect(uint64_t data, unsigned width)
+{
+	uint64_t reflection;
+	unsigned byte;
+
+	for (reflection = 0, byte = 0; byte < 8; byte += 1, data >>= 8)
+		reflection = (reflection << 8) | cc_crc_reflect8[data & 0xFF];
+	return reflection >> (64 - width);
+}
+
+/*
+ * CRC value from an engine register.
+ */
+static uint64_t
+engine_to_crc(const cc_crc_engine_t *engine, uint64_t reg)
+{
+	const cc_crc_model_t *model = &(engine->ce_model);
+
+	reg >>= engine->ce_shift;
+	if (!model->cm_refin != !model->cm_refout)
+		reg = engine_reflect(reg, model->cm_width);
+	return reg ^ model->cm_xorout;
+}
+
+/*
+ * Engine register (without its alignment shift) giving a CRC value.
+ */
+static uint64_t
+engine_from_crc(const cc_crc_engine_t *engine, uint64_t crc)
+{
+	const cc_crc_model_t *model = &(engine->ce_model);
+
+	crc ^= model->cm_xorout;
+	if (!model->cm_refin != !model->cm_refout)
+		crc = engine_reflect(crc, model->cm_width);
+	return crc;
+}
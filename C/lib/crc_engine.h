@@ -0,0 +1,53 @@
+/*
+ * #@ "crc_engine.h"
+ *
+ * Author : Christian CAMIER (chcamier@free.fr)
+ *
+ * Table driven division loops of the generic CRC engine, specialised
+ * for one register size.
+ *
+ * This file is included by crc_engine.c once per register size, with :
+ *  - ENGINE_TYPE:   Register type (uint8_t ... uint64_t).
+ *  - ENGINE_TABLE:  Table member of the engine (t08 ... t64).
+ *  - ENGINE_DIVIDE: Name of the division function.
+ *
+ * Reflected models keep the reflected remainder in the low bits of the
+ * register. The other ones keep the remainder in its high bits, so the
+ * same loop works for widths which are not a multiple of 8.
+ *
+ * History :
+ * ---------
+ *
+ * Oct 18, 2026: Christian CAMIER
+ *	v1.0 :	Creation
+ */
+
+#define ENGINE_BITS	(8 * sizeof(ENGINE_TYPE))
+
+static cc_crc64_t
+ENGINE_DIVIDE(const cc_crc_engine_t *engine, cc_crc64_t reg, const uint8_t *message, size_t nBytes)
+{
+	const ENGINE_TYPE *table;
+	ENGINE_TYPE        remainder;
+
+	table     = engine->ce_table.ENGINE_TABLE;
+	remainder = (ENGINE_TYPE)reg;
+
+	if (engine->ce_model.cm_refin)
+	{
+		for (; nBytes > 0; nBytes -= 1, message += 1)
+			remainder = table[(remainder ^ *message) & 0xFF] ^ (ENGINE_TYPE)((uint64_t)remainder >> 8);
+	}
+	else
+	{
+		for (; nBytes > 0; nBytes -= 1, message += 1)
+			remainder = table[(remainder >> (ENGINE_BITS - 8)) ^ *message] ^ (ENGINE_TYPE)((uint64_t)remainder << 8);
+	}
+
+	return (cc_crc64_t)remainder;
+}
+
+#undef ENGINE_BITS
+#undef ENGINE_DIVIDE
+#undef ENGINE_TABLE
+#undef ENGINE_TYPE
@@ -19,6 +19,10 @@
 
 #include "crc_internal.h"
 
+#if defined(CRC_SLICE_TABLE)
+#include "crc_slice.h"
+#endif
+
 /*********************************************************************
  *
  * Function:    crcFast()
@@ -35,23 +39,35 @@ crcFast(const void *data, size_t nBytes)
 {
 	register uint8_t  *message;
 	register CRC_TYPE  remainder;
-	register uint8_t   cdat;
 	register size_t    byte;
 
-	remainder = INITIAL_REMAINDER;
+	remainder = CRC_REGISTER_INIT;
 	message   = (uint8_t *)data;
 
+#if defined(CRC_ACCEL)
+	/*
+	 * Use the CPU specific division when available.
+	 */
+	if (nBytes >= CRC_ACCEL_MINIMUM && NULL != CRC_ACCEL)
+		return CRC_REGISTER_FINAL(CRC_ACCEL(remainder, message, nBytes));
+#endif
+
+#if defined(CRC_SLICE_TABLE)
+	/*
+	 * Large messages are divided several bytes at a time.
+	 */
+	if (nBytes >= CRC_SLICE_MINIMUM)
+		return CRC_REGISTER_FINAL(crcSlice(remainder, message, nBytes));
+#endif
+
 	/*
 	 * Divide the message by the polynomial, a byte at a time.
 	 */
 	for (byte = 0; byte < nBytes; byte += 1, message += 1)
-	{
-		cdat = REFLECT_DATA(*message) ^ (remainder >> (WIDTH - 8));
-		remainder = CRC_TABLE[cdat] ^ (remainder << 8);
-	}
+		remainder = CRC_BYTE_STEP(remainder, *message);
 
 	/*
 	 * The final remainder is the CRC.
 	 */
-	return (REFLECT_REMAINDER(remainder) ^ FINAL_XOR_VALUE);
+	return CRC_REGISTER_FINAL(remainder);
 }
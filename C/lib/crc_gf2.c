@@ -0,0 +1,134 @@
+/*
+ * #@ "crc_gf2.c"
+ *
+ * Author : Christian CAMIER (chcamier@free.fr)
+ *
+ * GF(2) matrix helpers used to move a CRC division register over a run
+ * of zero bytes without reading them.
+ *
+ * A matrix is an array of `width' columns : column N is the image of
+ * the register holding only bit N. Appending zero bytes to a message is
+ * a linear operation on the register, so it can be represented by such
+ * a matrix and raised to any power by repeated squaring.
+ *
+ * History :
+ * ---------
+ *
+ * Oct 18, 2026: Christian CAMIER
+ *	v1.0 :	Creation
+ */
+
+#include <string.h>
+
+#define CRC_CRC32
+#include "crc_internal.h"
+
+extern uint64_t cc_crc_gf2_times (const uint64_t *, uint64_t);
+extern void     cc_crc_gf2_zeros (uint64_t *, unsigned, uint64_t, int, uint64_t);
+
+static void gf2_multiply(uint64_t *, const uint64_t *, const uint64_t *, unsigned);
+
+/*********************************************************************
+ *
+ * Function:    cc_crc_gf2_times()
+ *
+ * Description: Apply the matrix `mat' to the vector `vec'.
+ *
+ * Returns:	The transformed vector.
+ *
+ *********************************************************************/
+uint64_t
+cc_crc_gf2_times(const uint64_t *mat, uint64_t vec)
+{
+	uint64_t sum;
+
+	for (sum = 0; vec; vec >>= 1, mat += 1)
+		if (vec & 1)
+			sum ^= *mat;
+	return sum;
+}
+
+/*********************************************************************
+ *
+ * Function:    cc_crc_gf2_zeros()
+ *
+ * Description: Build in `op' the operator appending `nBytes' zero bytes
+ *		to a `width' bits division register.
+ *
+ * Notes:	`poly' is the polynomial in its normal (MSB first) form.
+ *		When `reflected' is set, the operator works on the
+ *		reflected register of the reflected families.
+ *		`op' must have room for `width' columns (at most 64).
+ *
+ *********************************************************************/
+void
+cc_crc_gf2_zeros(uint64_t *op, unsigned width, uint64_t poly, int reflected, uint64_t nBytes)
+{
+	uint64_t power[64];
+	uint64_t tmp[64];
+	uint64_t mask;
+	unsigned bit;
+
+	mask = (64 == width) ? ~(uint64_t)0 : (((uint64_t)1 << width) - 1);
+
+	/*
+	 * Operator for one zero bit.
+	 */
+	if (reflected)
+	{
+		uint64_t rpoly;
+		for (rpoly = 0, bit = 0; bit < width; bit += 1)
+			if (poly & ((uint64_t)1 << bit))
+				rpoly |= (uint64_t)1 << (width - 1 - bit);
+		power[0] = rpoly;
+		for (bit = 1; bit < width; bit += 1)
+			power[bit] = (uint64_t)1 << (bit - 1);
+	}
+	else
+	{
+		for (bit = 0; bit < width - 1; bit += 1)
+			power[bit] = (uint64_t)1 << (bit + 1);
+		power[width - 1] = poly & mask;
+	}
+
+	/*
+	 * Operator for one zero byte.
+	 */
+	for (bit = 0; bit < 3; bit += 1)
+	{
+		gf2_multiply(tmp, power, power, width);
+		(void)memcpy(power, tmp, width * sizeof(uint64_t));
+	}
+
+	/*
+	 * Raise it to the nBytes power.
+	 */
+	for (bit = 0; bit < width; bit += 1)
+		op[bit] = (uint64_t)1 << bit;
+	while (nBytes)
+	{
+		if (nBytes & 1)
+		{
+			gf2_multiply(tmp, power, op, width);
+			(void)memcpy(op, tmp, width * sizeof(uint64_t));
+		}
+		nBytes >>= 1;
+		if (nBytes)
+		{
+			gf2_multiply(tmp, power, power, width);
+			(void)memcpy(power, tmp, width * sizeof(uint64_t));
+		}
+	}
+}
+
+/*
+ * res = a x b (b applied first).
+ */
+static void
+gf2_multiply(uint64_t *res, const uint64_t *a, const uint64_t *b, unsigned width)
+{
+	unsigned col;
+
+	for (col = 0; col < width; col += 1)
+		res[col] = cc_crc_gf2_times(a, b[col]);
+}
@@ -26,11 +26,21 @@
 #if !defined(CRC_CCITT)
 # if !defined(CRC_CRC16)
 #  if !defined(CRC_CRC32)
-#   error "CRC_CCITT or CRC_16 or CRC_32 must be defined"
+#   if !defined(CRC_CRC32C)
+#    error "CRC_CCITT or CRC_16 or CRC_32 or CRC_32C must be defined"
+#   endif
 #  endif
 # endif
 #endif
 
+/*
+ * Hardware accelerated kernels are only built for x86-64 with a
+ * compiler knowing the target function attribute.
+ */
+#if defined(__GNUC__) && defined(__x86_64__)
+# define CRC_HAVE_X86_ACCEL
+#endif
+
 #if defined(CRC_CCITT)
 
 #define CRC_TYPE		cc_crc16_t
@@ -56,6 +66,7 @@
 #define DO_REFLECT_REMAINDER
 #define CHECK_VALUE		0xBB3D
 #define CRC_TABLE		cc_crc_crc16_table
+#define CRC_RTABLE		cc_crc_crc16_rtable
 
 #elif defined(CRC_CRC32)
 
@@ -69,33 +80,155 @@
 #define DO_REFLECT_REMAINDER
 #define CHECK_VALUE		0xCBF43926
 #define CRC_TABLE		cc_crc_crc32_table
+#define CRC_RTABLE		cc_crc_crc32_slice[0]
+#define CRC_SLICE_TABLE		cc_crc_crc32_slice
+#define CRC_ACCEL		cc_crc_crc32_accel
+#define CRC_ACCEL_MINIMUM	64
+
+#elif defined(CRC_CRC32C)
+
+#define CRC_TYPE		cc_crc32_t
+#define CRC_PRFX		cc_crc32c
+#define CRC_NAME		"CRC-32C"
+#define POLYNOMIAL		0x1EDC6F41
+#define INITIAL_REMAINDER	0xFFFFFFFF
+#define FINAL_XOR_VALUE		0xFFFFFFFF
+#define DO_REFLECT_DATA
+#define DO_REFLECT_REMAINDER
+#define CHECK_VALUE		0xE3069283
+#define CRC_RTABLE		cc_crc_crc32c_slice[0]
+#define CRC_SLICE_TABLE		cc_crc_crc32c_slice
+#define CRC_ACCEL		cc_crc_crc32c_accel
+#define CRC_ACCEL_MINIMUM	16
 
 #else
 
-#error "One of CRC_CCITT, CRC16, or CRC32 must be #define'd."
+#error "One of CRC_CCITT, CRC16, CRC32 or CRC32C must be #define'd."
 
 #endif
 
 /* Global entities*/
 extern uint32_t cc_crc_reflect(uint32_t data, uint8_t nBits);
+extern uint8_t    const cc_crc_reflect8[256];
 extern cc_crc16_t const cc_crc_ccitt_table[256];
 extern cc_crc16_t const cc_crc_crc16_table[256];
+extern cc_crc16_t const cc_crc_crc16_rtable[256];
 extern cc_crc32_t const cc_crc_crc32_table[256];
+extern cc_crc32_t const cc_crc_crc32_slice[16][256];
+extern cc_crc32_t const cc_crc_crc32c_slice[16][256];
+
+/*
+ * Accelerated division of a reflected register, selected at startup
+ * (see crc_accel.c). NULL when the CPU has no suitable instructions.
+ */
+extern cc_crc32_t (*cc_crc_crc32_accel )(cc_crc32_t, const uint8_t *, size_t);
+extern cc_crc32_t (*cc_crc_crc32c_accel)(cc_crc32_t, const uint8_t *, size_t);
+
+/* GF(2) helpers (crc_gf2.c) */
+extern uint64_t cc_crc_gf2_times(const uint64_t *, uint64_t);
+extern void     cc_crc_gf2_zeros(uint64_t *, unsigned, uint64_t, int, uint64_t);
 
 #define WIDTH    (8 * sizeof(CRC_TYPE))
 #define TOPBIT   (1 << (WIDTH - 1))
 
 
+/*
+ * Reflection of the whole remainder, a byte at a time.
+ */
+static inline CRC_TYPE
+crc_reflect_remainder(CRC_TYPE data)
+{
+	CRC_TYPE reflection;
+	size_t   byte;
+
+	for (reflection = 0, byte = 0; byte < sizeof(CRC_TYPE); byte += 1, data >>= 8)
+		reflection = (reflection << 8) | cc_crc_reflect8[data & 0xFF];
+	return reflection;
+}
+
 #if defined(DO_REFLECT_DATA)
-#define REFLECT_DATA(X)		((uint8_t)cc_crc_reflect((X), 8))
+#define REFLECT_DATA(X)		(cc_crc_reflect8[(uint8_t)(X)])
 #else
 #define REFLECT_DATA(X)		(X)
 #endif
 
 #if defined(DO_REFLECT_REMAINDER)
-#define REFLECT_REMAINDER(X)	((CRC_TYPE)cc_crc_reflect((X), WIDTH))
+#define REFLECT_REMAINDER(X)	crc_reflect_remainder(X)
 #else
 #define REFLECT_REMAINDER(X)	(X)
 #endif
 
+/*
+ * Table driven division register:
+ *  - CRC_REGISTER_INIT:      Initial register value.
+ *  - CRC_BYTE_STEP(R, B):    Divide register R by the byte B.
+ *  - CRC_REGISTER_FINAL(R):  CRC value from register R.
+ *  - CRC_REGISTER_FROM(C):   Register value giving the CRC value C.
+ *  - CRC_REFLECTED:          1 if the register is reflected, else 0.
+ *
+ * For reflected families the register holds the reflected remainder
+ * and is updated with the reflected table, so input bytes are never
+ * reflected.
+ */
+#if defined(DO_REFLECT_DATA)
+# if !defined(CRC_RTABLE)
+#  error "Reflected CRC family without reflected table"
+# endif
+# define CRC_REFLECTED		1
+# define CRC_REGISTER_INIT	crc_reflect_remainder(INITIAL_REMAINDER)
+# define CRC_BYTE_STEP(R, B)	(CRC_RTABLE[((R) ^ (B)) & 0xFF] ^ ((R) >> 8))
+# if defined(DO_REFLECT_REMAINDER)
+#  define CRC_REGISTER_FINAL(R)	((R) ^ FINAL_XOR_VALUE)
+#  define CRC_REGISTER_FROM(C)	((C) ^ FINAL_XOR_VALUE)
+# else
+#  define CRC_REGISTER_FINAL(R)	(crc_reflect_remainder(R) ^ FINAL_XOR_VALUE)
+#  define CRC_REGISTER_FROM(C)	crc_reflect_remainder((C) ^ FINAL_XOR_VALUE)
+# endif
+#else
+# define CRC_REFLECTED		0
+# define CRC_REGISTER_INIT	INITIAL_REMAINDER
+# define CRC_BYTE_STEP(R, B)	(CRC_TABLE[((B) ^ ((R) >> (WIDTH - 8))) & 0xFF] ^ ((R) << 8))
+# define CRC_REGISTER_FINAL(R)	(REFLECT_REMAINDER(R) ^ FINAL_XOR_VALUE)
+# define CRC_REGISTER_FROM(C)	REFLECT_REMAINDER((CRC_TYPE)((C) ^ FINAL_XOR_VALUE))
+#endif
+
+/*
+ * Merge the CRC `crcB' of a message B into the CRC `crcA' of the
+ * message it follows. `op' is the operator appending |B| zero bytes to
+ * the register (see cc_crc_gf2_zeros).
+ */
+static inline CRC_TYPE
+crc_combine_op(CRC_TYPE crcA, CRC_TYPE crcB, const uint64_t *op)
+{
+	CRC_TYPE shifted;
+
+	shifted = (CRC_TYPE)cc_crc_gf2_times(op, (CRC_TYPE)(CRC_REGISTER_FROM(crcA) ^ CRC_REGISTER_INIT));
+	return CRC_REGISTER_FINAL((CRC_TYPE)(shifted ^ CRC_REGISTER_FROM(crcB)));
+}
+
+/*
+ * Slicing thresholds (in bytes) :
+ *  - CRC_SLICE_MINIMUM:   under this size, the byte per byte loop is used.
+ *  - CRC_SLICE16_MINIMUM: from this size, slicing-by-16 is used instead
+ *                         of slicing-by-8.
+ */
+#if defined(CRC_SLICE_TABLE)
+# if !defined(DO_REFLECT_DATA)
+#  error "Slicing is only implemented for reflected CRC families"
+# endif
+# if !defined(CRC_SLICE_MINIMUM)
+#  define CRC_SLICE_MINIMUM	64
+# endif
+# if !defined(CRC_SLICE16_MINIMUM)
+#  define CRC_SLICE16_MINIMUM	4096
+# endif
+#endif
+
+/*
+ * Smallest share (in bytes) given to a thread by crcParallel.
+ */
+#if !defined(CRC_PARALLEL_MINIMUM)
+# define CRC_PARALLEL_MINIMUM	(1024 * 1024)
+#endif
+
 #endif /* !__DHPU_CRC_INTERNAL_H__ */
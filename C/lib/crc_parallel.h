@@ -0,0 +1,108 @@
+/*
+ * #@ "crc_parallel.h"
+ *
+ * Author : Christian CAMIER (chcamier@free.fr)
+ *
+ * CRC of a large buffer computed by several threads.
+ *
+ * The buffer is cut into nThreads shares of equal size (the last one
+ * takes the rest). Each share goes through crcFast on its own thread,
+ * the calling thread taking the first one, and the partial CRCs are
+ * merged with the zero bytes operators of crc_combine.h. The result is
+ * the one crcFast would give for the whole buffer.
+ *
+ * History :
+ * ---------
+ *
+ * Oct 18, 2026: Christian CAMIER
+ *	v1.0 :	Creation
+ */
+
+#include <pthread.h>
+
+#include <CCA/memory.h>
+
+#include "crc_internal.h"
+
+struct crc_share_st {
+	pthread_t      sh_thread;
+	int            sh_started;
+	const uint8_t *sh_data;
+	size_t         sh_size;
+	CRC_TYPE       sh_crc;
+};
+
+static void *crcShare(void *);
+
+/*********************************************************************
+ *
+ * Function:    crcParallel()
+ *
+ * Description: Compute the CRC of a given message with up to
+ *		nThreads threads.
+ *
+ * Notes:	Shares smaller than CRC_PARALLEL_MINIMUM are not worth
+ *		a thread : the number of threads is reduced accordingly.
+ *		If a thread cannot be created, its share is computed by
+ *		the calling thread.
+ *
+ * Returns:	The CRC of the message.
+ *
+ *********************************************************************/
+CRC_TYPE
+crcParallel(const void *data, size_t nBytes, unsigned nThreads)
+{
+	struct crc_share_st *shares;
+	uint64_t             op[WIDTH];
+	uint64_t             oplast[WIDTH];
+	size_t               share;
+	unsigned             ix;
+	CRC_TYPE             crc;
+
+	if (nThreads > nBytes / CRC_PARALLEL_MINIMUM)
+		nThreads = (unsigned)(nBytes / CRC_PARALLEL_MINIMUM);
+	if (nThreads < 2)
+		return crcFast(data, nBytes);
+	if (NULL == (shares = CC_TALLOC(struct crc_share_st, nThreads)))
+		return crcFast(data, nBytes);
+
+	share = nBytes / nThreads;
+	for (ix = 0; ix < nThreads; ix += 1)
+	{
+		shares[ix].sh_data    = (const uint8_t *)data + ix * share;
+		shares[ix].sh_size    = (ix == nThreads - 1) ? nBytes - ix * share : share;
+		shares[ix].sh_started = 0;
+	}
+
+	for (ix = 1; ix < nThreads; ix += 1)
+		shares[ix].sh_started = (0 == pthread_create(&(shares[ix].sh_thread), NULL, crcShare, shares + ix));
+	(void)crcShare(shares);
+
+	/*
+	 * Merge the partial CRCs while the other threads are running.
+	 */
+	cc_crc_gf2_zeros(op,     WIDTH, POLYNOMIAL, CRC_REFLECTED, share);
+	cc_crc_gf2_zeros(oplast, WIDTH, POLYNOMIAL, CRC_REFLECTED, shares[nThreads - 1].sh_size);
+
+	crc = shares[0].sh_crc;
+	for (ix = 1; ix < nThreads; ix += 1)
+	{
+		if (shares[ix].sh_started)
+			(void)pthread_join(shares[ix].sh_thread, NULL);
+		else
+			(void)crcShare(shares + ix);
+		crc = crc_combine_op(crc, shares[ix].sh_crc, (ix == nThreads - 1) ? oplast : op);
+	}
+
+	cc_free(shares);
+	return crc;
+}
+
+static void *
+crcShare(void *arg)
+{
+	struct crc_share_st *sh = (struct crc_share_st *)arg;
+
+	sh->sh_crc = crcFast(sh->sh_data, sh->sh_size);
+	return NULL;
+}
@@ -20,6 +20,22 @@
 #define CRC_CRC32
 #include "crc_internal.h"
 
+/*
+ * Bit reversal of every byte value, expanded by the preprocessor two
+ * bits at a time.
+ */
+#define R2(n)	(n), (n) + 2 * 64, (n) + 1 * 64, (n) + 3 * 64
+#define R4(n)	R2(n), R2((n) + 2 * 16), R2((n) + 1 * 16), R2((n) + 3 * 16)
+#define R6(n)	R4(n), R4((n) + 2 *  4), R4((n) + 1 *  4), R4((n) + 3 *  4)
+
+uint8_t const cc_crc_reflect8[256] = {
+	R6(0), R6(2), R6(1), R6(3)
+};
+
+#undef R6
+#undef R4
+#undef R2
+
 /*********************************************************************
  *
  * Function:    __dhpu_crc_reflect()
@@ -37,26 +53,19 @@ uint32_t
 cc_crc_reflect(uint32_t data, uint8_t nBits)
 {
 	uint32_t reflection;
-	uint8_t  bit;
 
-	reflection = 0x00000000;
+	if (0 == nBits)
+		return 0;
 
 	/*
-	 * Reflect the data about the center bit.
+	 * Reflect the 32 bits a byte at a time, then drop the bits
+	 * that were not part of the sequence.
 	 */
-	for (bit = 0; bit < nBits; bit += 1)
-	{
-		/*
-		 * If the LSB bit is set, set the reflection of it.
-		 */
-		if (data & 0x01)
-		{
-			reflection |= (1 << ((nBits - 1) - bit));
-		}
-
-		data = (data >> 1);
-	}
-
-	return reflection;
+	reflection = ((uint32_t)cc_crc_reflect8[ data        & 0xFF] << 24) |
+		     ((uint32_t)cc_crc_reflect8[(data >>  8) & 0xFF] << 16) |
+		     ((uint32_t)cc_crc_reflect8[(data >> 16) & 0xFF] <<  8) |
+		     ((uint32_t)cc_crc_reflect8[(data >> 24) & 0xFF]      );
+
+	return reflection >> (32 - nBits);
 
 } /* reflect() */
@@ -0,0 +1,92 @@
+/*
+ * #@ "crc_slice.h"
+ *
+ * Author : Christian CAMIER (chcamier@free.fr)
+ *
+ * Slicing-by-8 and slicing-by-16 division loops for the 32 bits
+ * reflected CRC families.
+ *
+ * The remainder handled by these functions is the reflected one, as
+ * held in the division register of reflected families (see
+ * CRC_REGISTER_INIT in crc_internal.h).
+ *
+ * Input words are assembled byte per byte so the code does not depend
+ * on the host byte order nor on the buffer alignment.
+ *
+ * History :
+ * ---------
+ *
+ * Oct 18, 2026: Christian CAMIER
+ *	v1.0 :	Creation
+ */
+
+#ifndef __CRC_SLICE_H__
+#define __CRC_SLICE_H__
+
+#include "crc_internal.h"
+
+#if !defined(CRC_SLICE_TABLE)
+# error "crc_slice.h included for a CRC family without slicing tables"
+#endif
+
+#define SLICE_WORD(M)	((uint32_t)(M)[0]         | ((uint32_t)(M)[1] <<  8) | \
+			((uint32_t)(M)[2] << 16) | ((uint32_t)(M)[3] << 24))
+
+#define SLICE_WORD_STEP(W, K)			\
+	(CRC_SLICE_TABLE[(K) + 3][ (W)        & 0xFF] ^	\
+	 CRC_SLICE_TABLE[(K) + 2][((W) >>  8) & 0xFF] ^	\
+	 CRC_SLICE_TABLE[(K) + 1][((W) >> 16) & 0xFF] ^	\
+	 CRC_SLICE_TABLE[(K)    ][((W) >> 24) & 0xFF])
+
+/*********************************************************************
+ *
+ * Function:    crcSlice()
+ *
+ * Description: Divide the message by the polynomial, 16 or 8 bytes at
+ *		a time, starting with the given reflected remainder.
+ *
+ * Notes:	Slicing-by-16 is only used for buffers of at least
+ *		CRC_SLICE16_MINIMUM bytes : its 16 Kb of tables do not pay
+ *		for themselves on shorter messages.
+ *
+ * Returns:	The reflected remainder.
+ *
+ *********************************************************************/
+static CRC_TYPE
+crcSlice(CRC_TYPE remainder, const uint8_t *message, size_t nBytes)
+{
+	register uint32_t w0;
+	register uint32_t w1;
+	register uint32_t w2;
+	register uint32_t w3;
+
+	if (nBytes >= CRC_SLICE16_MINIMUM)
+	{
+		for (; nBytes >= 16; nBytes -= 16, message += 16)
+		{
+			w0 = remainder ^ SLICE_WORD(message);
+			w1 = SLICE_WORD(message +  4);
+			w2 = SLICE_WORD(message +  8);
+			w3 = SLICE_WORD(message + 12);
+			remainder = SLICE_WORD_STEP(w0, 12) ^
+				    SLICE_WORD_STEP(w1,  8) ^
+				    SLICE_WORD_STEP(w2,  4) ^
+				    SLICE_WORD_STEP(w3,  0);
+		}
+	}
+
+	for (; nBytes >= 8; nBytes -= 8, message += 8)
+	{
+		w0 = remainder ^ SLICE_WORD(message);
+		w1 = SLICE_WORD(message + 4);
+		remainder = SLICE_WORD_STEP(w0, 4) ^
+			    SLICE_WORD_STEP(w1, 0);
+	}
+
+	for (; nBytes > 0; nBytes -= 1, message += 1)
+		remainder = CRC_SLICE_TABLE[0][(remainder ^ *message) & 0xFF] ^ (remainder >> 8);
+
+	return remainder;
+}
+
+#endif /* !__CRC_SLICE_H__ */
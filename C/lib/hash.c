@@ -0,0 +1,142 @@
+/*-                                               -*- c -*-
+ * Copyright (c) 2026
+ *      Christian CAMIER <chcamier@free.fr>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Description :
+ *	64 bits hash function for lookup tables (see hash_internal.h)
+ */
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "hash_internal.h"
+
+extern uint64_t cc_hash64    (const void *, size_t, uint64_t);
+extern uint64_t cc_hash64_str(const char *, uint64_t);
+extern uint64_t cc_hash64_key(const void *);
+
+static size_t str_word(const uint8_t *, uint64_t *);
+
+/*
+ * str_word reads the string by aligned words, which never cross a page
+ * but may hold bytes past its end : AddressSanitizer must not check
+ * them, as for the strlen of the C libraries.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+# define STR_NO_SANITIZE	__attribute__((__no_sanitize_address__))
+#else
+# define STR_NO_SANITIZE
+#endif
+
+#define STR_ONES	0x0101010101010101ULL
+#define STR_HIGHS	0x8080808080808080ULL
+
+typedef uint64_t str_word_t __attribute__((__may_alias__));
+
+uint64_t cc_hash64(const void *data, size_t len, uint64_t seed)
+{
+	register const uint8_t *k;
+	register       uint64_t h;
+	register       size_t   rest;
+
+	k = (const uint8_t *)data;
+	h = seed ^ HASH_K0;
+
+	for (rest = len; rest >= 16; rest -= 16, k += 16)
+		h = hash_block(h, k);
+
+	return hash_finish(h, k, rest, len);
+}
+
+uint64_t cc_hash64_str(const char *str, uint64_t seed)
+{
+	register const uint8_t *k;
+	register       uint64_t h;
+	register       size_t   len;
+	size_t                  rest;
+	uint64_t                a;
+	uint64_t                b;
+
+	k   = (const uint8_t *)str;
+	h   = seed ^ HASH_K0;
+	len = 0;
+
+	/*
+	 * Blocks of 16 bytes until one of them holds the final NUL.
+	 */
+	for (;;)
+	{
+		if (8 != (rest = str_word(k, &a)))
+			break;
+		if (8 != (rest = str_word(k + 8, &b)))
+		{
+			rest += 8;
+			break;
+		}
+		h    = hash_mum(a ^ HASH_K1, b ^ h);
+		k   += 16;
+		len += 16;
+	}
+
+	return hash_finish(h, k, rest, len + rest);
+}
+
+uint64_t cc_hash64_key(const void *str)
+{
+	return cc_hash64_str((const char *)str, 0);
+}
+
+/*
+ * Load the word at `p' in `w' and return the index of its first NUL
+ * byte, or 8 if there is none. The bytes of `w' after the NUL are
+ * undefined.
+ *
+ * The aligned word holding `p' is read first, and the next one only if
+ * the string goes on past it. The lowest flag of `zeros' is always the
+ * one of the first NUL.
+ */
+static STR_NO_SANITIZE size_t str_word(const uint8_t *p, uint64_t *w)
+{
+	const str_word_t *q;
+	uint64_t          lo;
+	uint64_t          hi;
+	uint64_t          zeros;
+	unsigned          shift;
+
+	q     = (const str_word_t *)((uintptr_t)p & ~(uintptr_t)7);
+	shift = 8 * (unsigned)((uintptr_t)p & 7);
+	lo    = q[0];
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	lo    = __builtin_bswap64(lo);
+#endif
+	*w    = lo >> shift;
+	if (0 != shift)
+	{
+		zeros = (*w - STR_ONES) & ~*w & STR_HIGHS & (~0ULL >> shift);
+		if (0 != zeros)
+			return (size_t)__builtin_ctzll(zeros) / 8;
+		hi = q[1];
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		hi = __builtin_bswap64(hi);
+#endif
+		*w |= hi << (64 - shift);
+	}
+
+	zeros = (*w - STR_ONES) & ~*w & STR_HIGHS;
+	if (0 == zeros)
+		return 8;
+	return (size_t)__builtin_ctzll(zeros) / 8;
+}
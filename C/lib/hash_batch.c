@@ -0,0 +1,121 @@
+/*-                                               -*- c -*-
+ * Copyright (c) 2026
+ *      Christian CAMIER <chcamier@free.fr>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Description :
+ *	Hash of many keys at once.
+ *
+ *	Keys are taken by groups of 4. The 16 bytes blocks the keys of a
+ *	group have in common are folded in lockstep, then each key is
+ *	finished alone, so the gain is the largest when the keys have
+ *	close lengths. The result is always the one of
+ *	cc_hash64(key, len, 0).
+ *
+ *	The fold is a 64 x 64 -> 128 bits multiply, which SSE2 and AVX2
+ *	lack : building it from 32 bits vector products was measured
+ *	slower than independent scalar multiplies, which are used here.
+ */
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <CCA/util.h>
+
+#include "hash_internal.h"
+
+extern void cc_hash_batch(const void **, const size_t *, size_t, uint64_t *);
+
+#define GROUP	4
+
+static void batch_group (const void **, const size_t *, uint64_t *);
+static void batch_finish(const uint8_t *, size_t, size_t, uint64_t, uint64_t *);
+
+/*
+ * cc_hash_batch:
+ *	out[i] = cc_hash64(keys[i], lens[i], 0) for i in [0, n[.
+ *	When lens is NULL, keys are NUL terminated strings and
+ *	out[i] = cc_hash64_key(keys[i]).
+ */
+void cc_hash_batch(const void **keys, const size_t *lens, size_t n, uint64_t *out)
+{
+	size_t slens[GROUP];
+	size_t ix;
+	size_t j;
+
+	if (NULL == lens)
+	{
+		/* Strings : their lengths first, then the same groups */
+		for (ix = 0; ix + GROUP <= n; ix += GROUP)
+		{
+			for (j = 0; j < GROUP; j += 1)
+				slens[j] = strlen((const char *)keys[ix + j]);
+			batch_group(keys + ix, slens, out + ix);
+		}
+		for (; ix < n; ix += 1)
+			out[ix] = cc_hash64_key(keys[ix]);
+		return;
+	}
+
+	for (ix = 0; ix + GROUP <= n; ix += GROUP)
+		batch_group(keys + ix, lens + ix, out + ix);
+	for (; ix < n; ix += 1)
+		out[ix] = cc_hash64(keys[ix], lens[ix], 0);
+	return;
+}
+
+/*
+ * Hash GROUP keys : the blocks they have in common are folded as four
+ * independent multiply chains, which the CPU overlaps.
+ */
+static inline void batch_group(const void **keys, const size_t *lens, uint64_t *out)
+{
+	const uint8_t *k0 = (const uint8_t *)keys[0];
+	const uint8_t *k1 = (const uint8_t *)keys[1];
+	const uint8_t *k2 = (const uint8_t *)keys[2];
+	const uint8_t *k3 = (const uint8_t *)keys[3];
+	uint64_t       h0,  h1,  h2,  h3;
+	size_t         common;
+	size_t         done;
+
+	h0 = h1 = h2 = h3 = HASH_K0;
+
+	common  = CC_MIN(CC_MIN(lens[0], lens[1]), CC_MIN(lens[2], lens[3]));
+	common &= ~(size_t)15;
+	for (done = 0; done < common; done += 16)
+	{
+		h0 = hash_block(h0, k0 + done);
+		h1 = hash_block(h1, k1 + done);
+		h2 = hash_block(h2, k2 + done);
+		h3 = hash_block(h3, k3 + done);
+	}
+
+	batch_finish(k0, lens[0], common, h0, out + 0);
+	batch_finish(k1, lens[1], common, h1, out + 1);
+	batch_finish(k2, lens[2], common, h2, out + 2);
+	batch_finish(k3, lens[3], common, h3, out + 3);
+}
+
+/*
+ * Finish the hash of one key whose first `done' bytes are folded in `h'.
+ */
+static inline void batch_finish(const uint8_t *k, size_t len, size_t done, uint64_t h, uint64_t *out)
+{
+	size_t rest;
+
+	for (k += done, rest = len - done; rest >= 16; rest -= 16, k += 16)
+		h = hash_block(h, k);
+	*out = hash_finish(h, k, rest, len);
+}
@@ -0,0 +1,124 @@
+/*-                                               -*- c -*-
+ * Copyright (c) 2026
+ *      Christian CAMIER <chcamier@free.fr>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ * Description :
+ *	Building blocks of the 64 bits hash function.
+ *
+ *	The key is read as 16 bytes blocks of two little endian words
+ *	(a, b), each block being folded into the state h by
+ *		h = mum(a ^ K1, b ^ h)
+ *	where mum(x, y) is the xor of the two halves of the 128 bits
+ *	product x * y. The last 0 to 15 bytes are read with overlapping
+ *	loads, and the key length is only mixed in at the end, so a
+ *	string can be hashed before its length is known.
+ */
+
+#ifndef __HASH_INTERNAL_H__
+#define __HASH_INTERNAL_H__
+
+#include <stdint.h>
+#include <string.h>
+
+#include <CCA/hash.h>
+
+#define HASH_K0	0xA0761D6478BD642FULL
+#define HASH_K1	0xE7037ED1A0B428DBULL
+#define HASH_K2	0x8EBC6AF09C88C6E3ULL
+#define HASH_K3	0x589965CC75374CC3ULL
+
+static inline uint64_t
+hash_mum(uint64_t x, uint64_t y)
+{
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 r = (unsigned __int128)x * y;
+
+	return (uint64_t)r ^ (uint64_t)(r >> 64);
+#else
+	uint64_t xh = x >> 32, xl = (uint32_t)x;
+	uint64_t yh = y >> 32, yl = (uint32_t)y;
+	uint64_t hh = xh * yh, hl = xh * yl, lh = xl * yh, ll = xl * yl;
+	uint64_t mid = (ll >> 32) + (uint32_t)hl + (uint32_t)lh;
+	uint64_t lo  = (mid << 32) | (uint32_t)ll;
+	uint64_t hi  = hh + (hl >> 32) + (lh >> 32) + (mid >> 32);
+
+	return lo ^ hi;
+#endif
+}
+
+static inline uint64_t
+hash_rd64(const uint8_t *p)
+{
+	uint64_t v;
+
+	(void)memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	v = __builtin_bswap64(v);
+#endif
+	return v;
+}
+
+static inline uint64_t
+hash_rd32(const uint8_t *p)
+{
+	uint32_t v;
+
+	(void)memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	v = __builtin_bswap32(v);
+#endif
+	return v;
+}
+
+static inline uint64_t
+hash_block(uint64_t h, const uint8_t *p)
+{
+	return hash_mum(hash_rd64(p) ^ HASH_K1, hash_rd64(p + 8) ^ h);
+}
+
+/*
+ * Fold the last `rest' (0 to 15) bytes at `p' and the key length.
+ */
+static inline uint64_t
+hash_finish(uint64_t h, const uint8_t *p, size_t rest, size_t len)
+{
+	uint64_t a;
+	uint64_t b;
+
+	if (rest > 8)
+	{
+		a = hash_rd64(p);
+		b = hash_rd64(p + rest - 8);
+	}
+	else if (rest >= 4)
+	{
+		a = (hash_rd32(p) << 32) | hash_rd32(p + rest - 4);
+		b = 0;
+	}
+	else if (rest > 0)
+	{
+		a = ((uint64_t)p[0] << 16) | ((uint64_t)p[rest >> 1] << 8) | (uint64_t)p[rest - 1];
+		b = 0;
+	}
+	else
+	{
+		a = b = 0;
+	}
+
+	h = hash_mum(a ^ HASH_K2, b ^ h);
+	return hash_mum(h ^ HASH_K3, (uint64_t)len ^ HASH_K1);
+}
+
+#endif /* !__HASH_INTERNAL_H__ */
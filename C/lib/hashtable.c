@@ -18,47 +18,95 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <CCA/hash.h>
 #include <CCA/hashtable.h>
-#include <CCA/jenkin.h>
 #include <CCA/memory.h>
+#include <CCA/util.h>
 
 /* Global functions */
-extern CC_HASHTABLE cc_hashtable_create(size_t, cc_hashtable_comp_t, cc_hashtable_hash_t);
-extern int          cc_hashtable_add   (CC_HASHTABLE, CC_HASHTABLE_HDR);
-extern int          cc_hashtable_del   (CC_HASHTABLE, void *, CC_HASHTABLE_HDR *);
-extern int          cc_hashtable_search(CC_HASHTABLE, void *, CC_HASHTABLE_HDR *);
+extern CC_HASHTABLE cc_hashtable_create    (size_t, cc_hashtable_comp_t, cc_hashtable_hash_t);
+extern void         cc_hashtable_destroy   (CC_HASHTABLE);
+extern int          cc_hashtable_add       (CC_HASHTABLE, CC_HASHTABLE_HDR);
+extern int          cc_hashtable_del       (CC_HASHTABLE, void *, CC_HASHTABLE_HDR *);
+extern int          cc_hashtable_search    (CC_HASHTABLE, void *, CC_HASHTABLE_HDR *);
+extern int          cc_hashtable_reserve   (CC_HASHTABLE, size_t);
+extern void         cc_hashtable_autoshrink(CC_HASHTABLE, int);
+extern void             cc_hashtable_cursor_open (CC_HASHTABLE, cc_hashtable_cursor_t *);
+extern CC_HASHTABLE_HDR cc_hashtable_cursor_next (cc_hashtable_cursor_t *);
+extern void             cc_hashtable_cursor_close(cc_hashtable_cursor_t *);
+extern int              cc_hashtable_snapshot    (CC_HASHTABLE, CC_HASHTABLE_HDR **, size_t *);
+
+/*
+ * Buckets moved by each add or del while the table is resized, and
+ * number of empty buckets that may be crossed for each of them.
+ */
+#define REHASH_STEP	4
+#define REHASH_EMPTY	10
 
 /* Local functions */
-static int search(CC_HASHTABLE, const void *, CC_HASHTABLE_HDR **, CC_HASHTABLE_HDR *);
+static int               search(CC_HASHTABLE, const void *, CC_HASHTABLE_HDR **, CC_HASHTABLE_HDR *);
+static CC_HASHTABLE_HDR *bucket(CC_HASHTABLE, uint32_t);
+static int               resize(CC_HASHTABLE, size_t);
+static void              rehash(CC_HASHTABLE, size_t);
+static void              rehash_bucket(CC_HASHTABLE);
+static uint32_t          hash_key(const void *);
 
 CC_HASHTABLE cc_hashtable_create(size_t size, cc_hashtable_comp_t comp, cc_hashtable_hash_t hash)
 {
-	size_t       rsz = CC_HASHTABLE_HDR_SZ + size * sizeof(CC_HASHTABLE_HDR);
 	CC_HASHTABLE ret;
 
-	if(NULL != (ret = (CC_HASHTABLE)cc_malloc(rsz)))
+	if(size < 1)
+		size = 1;
+	if(NULL != (ret = (CC_HASHTABLE)cc_malloc(CC_HASHTABLE_HDR_SZ)))
 	{
+		if(NULL == (ret->ht_heads = CC_TALLOC(CC_HASHTABLE_HDR, size)))
+		{
+			cc_free(ret);
+			return NULL;
+		}
 		ret->fn_comp = comp ? comp : (cc_hashtable_comp_t)strcmp;
-		ret->fn_hash = hash ? hash : (cc_hashtable_hash_t)jenkin_str;
+		ret->fn_hash = hash ? hash : hash_key;
+		ret->ht_size = size;
+		ret->ht_min  = size;
 	}
 	return ret;
 }
 
+void cc_hashtable_destroy(CC_HASHTABLE T)
+{
+	if(T->ht_oheads)
+		cc_free(T->ht_oheads);
+	cc_free(T->ht_heads);
+	cc_free(T);
+	return;
+}
+
 int cc_hashtable_add(CC_HASHTABLE T, CC_HASHTABLE_HDR H)
 {
-	uint32_t          hshval = T->fn_hash(H->key);
-	CC_HASHTABLE_HDR *header = T->ht_heads + (hshval % T->ht_size);
-	CC_HASHTABLE_HDR  p      = *header;
+	uint32_t          hshval;
+	CC_HASHTABLE_HDR *header;
+	CC_HASHTABLE_HDR  p;
+
+	if(T->ht_oheads && 0 == T->ht_cursors)
+		rehash(T, REHASH_STEP);
 
 	if(CC_HASHTABLE_ERR_NOERROR == search(T, H->key, NULL, NULL))
 		return CC_HASHTABLE_ERR_EXISTS;
 
+	hshval = T->fn_hash(H->key);
+	header = bucket(T, hshval);
+	p      = *header;
+
 	H->cc_ht_val = hshval;
 	H->prev      = NULL;
 	H->next      = p;
 	if(p)
 		p->prev = H;
 	*header      = H;
+
+	/* Failing to grow only makes the chains longer */
+	if(++T->ht_count > T->ht_size && NULL == T->ht_oheads && 0 == T->ht_cursors)
+		(void)resize(T, 2 * T->ht_size + 1);
 	return CC_HASHTABLE_ERR_NOERROR;
 }
 
@@ -67,6 +115,10 @@ int cc_hashtable_del(CC_HASHTABLE T, void *K, CC_HASHTABLE_HDR *H)
 	int                r;
 	CC_HASHTABLE_HDR  *e;
 	CC_HASHTABLE_HDR   p;
+
+	if(T->ht_oheads && 0 == T->ht_cursors)
+		rehash(T, REHASH_STEP);
+
 	if(CC_HASHTABLE_ERR_NOERROR != (r = search(T, K, &e, &p)))
 		return r;
 	if(p->next)
@@ -76,6 +128,10 @@ int cc_hashtable_del(CC_HASHTABLE T, void *K, CC_HASHTABLE_HDR *H)
 	else
 		*e = p->next;
 	*H = p;
+
+	T->ht_count -= 1;
+	if(T->ht_shrink && NULL == T->ht_oheads && 0 == T->ht_cursors && T->ht_size > T->ht_min && T->ht_count < T->ht_size / 8)
+		(void)resize(T, CC_MAX(T->ht_min, T->ht_size / 2));
 	return r;
 }
 
@@ -84,17 +140,98 @@ int cc_hashtable_search(CC_HASHTABLE T, void *K, CC_HASHTABLE_HDR *H)
 	return search(T, K, NULL, H);
 }
 
+int cc_hashtable_reserve(CC_HASHTABLE T, size_t count)
+{
+	if(count > T->ht_min)
+		T->ht_min = count;
+	if(0 != T->ht_cursors)
+		return CC_HASHTABLE_ERR_NOERROR;
+	rehash(T, SIZE_MAX);
+	if(count > T->ht_size)
+	{
+		if(0 != resize(T, count))
+			return CC_HASHTABLE_ERR_SYSERR;
+		rehash(T, SIZE_MAX);
+	}
+	return CC_HASHTABLE_ERR_NOERROR;
+}
+
+void cc_hashtable_autoshrink(CC_HASHTABLE T, int enable)
+{
+	T->ht_shrink = enable;
+	return;
+}
+
+void cc_hashtable_cursor_open(CC_HASHTABLE T, cc_hashtable_cursor_t *C)
+{
+	C->hc_table  = T;
+	C->hc_phase  = T->ht_oheads ? 0 : 1;
+	C->hc_bucket = T->ht_oheads ? T->ht_move : 0;
+	C->hc_next   = NULL;
+	T->ht_cursors += 1;
+	return;
+}
+
+CC_HASHTABLE_HDR cc_hashtable_cursor_next(cc_hashtable_cursor_t *C)
+{
+	CC_HASHTABLE     T = C->hc_table;
+	CC_HASHTABLE_HDR p;
+
+	while(NULL == C->hc_next)
+	{
+		if(0 == C->hc_phase)
+		{
+			if(C->hc_bucket < T->ht_osize)
+			{
+				C->hc_next = T->ht_oheads[C->hc_bucket++];
+				continue;
+			}
+			C->hc_phase  = 1;
+			C->hc_bucket = 0;
+		}
+		if(C->hc_bucket >= T->ht_size)
+			return NULL;
+		C->hc_next = T->ht_heads[C->hc_bucket++];
+	}
+	p          = C->hc_next;
+	C->hc_next = p->next;
+	return p;
+}
+
+void cc_hashtable_cursor_close(cc_hashtable_cursor_t *C)
+{
+	C->hc_table->ht_cursors -= 1;
+	C->hc_table = NULL;
+	return;
+}
+
+int cc_hashtable_snapshot(CC_HASHTABLE T, CC_HASHTABLE_HDR **E, size_t *N)
+{
+	cc_hashtable_cursor_t C;
+	CC_HASHTABLE_HDR     *r;
+	CC_HASHTABLE_HDR      p;
+	size_t                n;
+
+	if(NULL == (r = CC_TALLOC(CC_HASHTABLE_HDR, CC_MAX(T->ht_count, 1))))
+		return CC_HASHTABLE_ERR_SYSERR;
+	cc_hashtable_cursor_open(T, &C);
+	for(n = 0; NULL != (p = cc_hashtable_cursor_next(&C)); r[n++] = p);
+	cc_hashtable_cursor_close(&C);
+	*E = r;
+	*N = n;
+	return CC_HASHTABLE_ERR_NOERROR;
+}
 
 static int search(CC_HASHTABLE T, const void *K, CC_HASHTABLE_HDR **H, CC_HASHTABLE_HDR *E)
 {
 	uint32_t          hshval = T->fn_hash(K);
-	CC_HASHTABLE_HDR *header = T->ht_heads + (hshval % T->ht_size);
+	CC_HASHTABLE_HDR *header = bucket(T, hshval);
 	CC_HASHTABLE_HDR  p;
 	if(*header)
 	{
 		for(p = *header; p; p = p->next)
 		{
-			if(p->cc_ht_val == hshval && T->fn_comp(K, p->key))
+			if(p->cc_ht_val == hshval && 0 == T->fn_comp(K, p->key))
 			{
 				if(H) *H = header;
 				if(E) *E = p;
@@ -105,3 +242,88 @@ static int search(CC_HASHTABLE T, const void *K, CC_HASHTABLE_HDR **H, CC_HASHTA
 	return CC_HASHTABLE_ERR_NOTFOUND;
 }
 
+/*
+ * Bucket of a hash value : the one of the old table while it is not
+ * moved yet.
+ */
+static CC_HASHTABLE_HDR *bucket(CC_HASHTABLE T, uint32_t hshval)
+{
+	size_t ix;
+
+	if(T->ht_oheads && (ix = hshval % T->ht_osize) >= T->ht_move)
+		return T->ht_oheads + ix;
+	return T->ht_heads + hshval % T->ht_size;
+}
+
+/*
+ * Start moving the elements to a table of `size' entries.
+ */
+static int resize(CC_HASHTABLE T, size_t size)
+{
+	CC_HASHTABLE_HDR *heads;
+
+	if(NULL == (heads = CC_TALLOC(CC_HASHTABLE_HDR, size)))
+		return -1;
+	T->ht_oheads = T->ht_heads;
+	T->ht_osize  = T->ht_size;
+	T->ht_move   = 0;
+	T->ht_heads  = heads;
+	T->ht_size   = size;
+	return 0;
+}
+
+/*
+ * Move up to `count' non empty buckets of the old table.
+ */
+static void rehash(CC_HASHTABLE T, size_t count)
+{
+	size_t empty = count < SIZE_MAX / REHASH_EMPTY ? count * REHASH_EMPTY : SIZE_MAX;
+
+	while(T->ht_oheads && count > 0 && empty > 0)
+	{
+		if(NULL == T->ht_oheads[T->ht_move])
+		{
+			T->ht_move += 1;
+			empty      -= 1;
+		}
+		else
+		{
+			rehash_bucket(T);
+			count -= 1;
+		}
+		if(T->ht_move == T->ht_osize)
+		{
+			cc_free(T->ht_oheads);
+			T->ht_oheads = NULL;
+			T->ht_osize  = 0;
+			T->ht_move   = 0;
+		}
+	}
+	return;
+}
+
+static void rehash_bucket(CC_HASHTABLE T)
+{
+	CC_HASHTABLE_HDR  p;
+	CC_HASHTABLE_HDR  n;
+	CC_HASHTABLE_HDR *header;
+
+	for(p = T->ht_oheads[T->ht_move]; p; p = n)
+	{
+		n       = p->next;
+		header  = T->ht_heads + p->cc_ht_val % T->ht_size;
+		p->prev = NULL;
+		p->next = *header;
+		if(*header)
+			(*header)->prev = p;
+		*header = p;
+	}
+	T->ht_oheads[T->ht_move] = NULL;
+	T->ht_move += 1;
+	return;
+}
+
+static uint32_t hash_key(const void *K)
+{
+	return (uint32_t)cc_hash64_key(K);
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026
+ *     Christian CAMIER <christian.c at promethee dot services>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * #@ "cc_io_writev.c"
+ *	-- CC Utilities: force complete writev except if an error occurs
+ */
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <errno.h>
+#include <unistd.h>
+#include <CCA/io.h>
+
+extern ssize_t cc_io_writev(int, struct iovec *, int);
+
+ssize_t cc_io_writev(int fd, struct iovec *iov, int iovcnt)
+{
+	ssize_t wcount;
+	size_t  total;
+	size_t  done;
+
+	for(total = 0; iovcnt > 0 && 0 == iov->iov_len; iov += 1, iovcnt -= 1);
+	while(iovcnt > 0)
+	{
+		if(-1 == (wcount = writev(fd, iov, iovcnt)))
+		{
+			if(EINTR == errno)
+				continue;
+			return -1;
+		}
+		total += (size_t)wcount;
+		for(done = (size_t)wcount; iovcnt > 0 && done >= iov->iov_len; done -= iov->iov_len, iov += 1, iovcnt -= 1);
+		if(iovcnt > 0)
+		{
+			iov->iov_base = (char *)iov->iov_base + done;
+			iov->iov_len -= done;
+		}
+	}
+	return (ssize_t)total;
+}
@@ -37,12 +37,18 @@ extern int    cc_log_config         (const char *, const char *);
 extern void   cc_log_crit           (const char *, ...);
 extern void   cc_log_debug          (const char *, ...);
 extern void   cc_log_emerg          (const char *, ...);
+extern void   cc_log_emit           (int, const char *, ...);
 extern void   cc_log_err            (const char *, ...);
+extern int    cc_log_find_level     (const char *);
+extern void   cc_log_flush          (void);
 extern size_t cc_log_format_message (char *, size_t, int, const char *, va_list);
+extern size_t cc_log_format_prefix  (char *, size_t, int, const struct timespec *);
+extern size_t cc_log_format_line    (char *, size_t, int, const char *, ...);
 extern void   cc_log_info           (const char *, ...);
 extern void   cc_log_notice         (const char *, ...);
 extern void   cc_log_perror         (const char *);
 extern void   cc_log_register_driver(struct cc_log_driver_st *);
+extern void   cc_log_register_module(cc_log_module_t *);
 extern void   cc_log_reinit         (void);
 extern void   cc_log_start          (void);
 extern void   cc_log_valert         (const char *, va_list);
@@ -55,31 +61,54 @@ extern void   cc_log_vnotice        (const char *, va_list);
 extern void   cc_log_vwarning       (const char *, va_list);
 extern void   cc_log_warning        (const char *, ...);
 
-extern const struct cc_log_code_st *cc_log_search_name(const char *, const struct cc_log_code_st *, size_t);
+extern const struct cc_log_code_st *cc_log_search_name(const char *, const struct cc_log_code_st *, const cc_mph_t *);
 extern const struct cc_log_code_st *cc_log_search_code(int,          const struct cc_log_code_st *, size_t);
 
 /* Local functions */
 static void        do_log(int, const char *, va_list);
+static void        log_write(int, const char *, va_list);
+static void        log_levels_update(void);
+static size_t      log_stamp(char *, size_t, const struct timespec *);
+
+/*
+ * The time prefix of the lines is formatted once per second and per
+ * thread : localtime_r may take the timezone lock and stat the zone
+ * file. ls_gen follows timegen, changed with the time format.
+ */
+#define LOG_STAMP	128
+
+struct log_stamp_st {
+	time_t   ls_sec;
+	unsigned ls_gen;
+	size_t   ls_len;
+	char     ls_text[LOG_STAMP];
+};
+
+#if CC_LOG_LEVEL_EMERG != LOG_EMERG || CC_LOG_LEVEL_ERR != LOG_ERR || CC_LOG_LEVEL_DEBUG != LOG_DEBUG
+# error "CC_LOG_LEVEL_ values differ from the syslog ones"
+#endif
+
+/* Global variables */
+int cc_log_level = default_lvl;
 
 /* Local variables */
 static const char    tfmt_def[] = default_tfm;
-static int           loglevel   = default_lvl;
 static const char   *timefmt    = tfmt_def;
+static unsigned      timegen    = 1;		/* Changed with timefmt    */
+static int           timeprec   = 0;		/* Digits of the fractions */
+
+static __thread struct log_stamp_st stamp;
 
 static struct cc_log_driver_st *drivers = NULL; /* Defined drivers */
 static struct cc_log_driver_st *curdrvr = NULL; /* Current driver  */
 static struct cc_log_driver_st *nextdrv = NULL; /* Futur driver    */
+static cc_log_module_t         *modules = NULL; /* Defined modules */
 
-static struct cc_log_code_st log_priorities[] = {
-	LOC_CODE_ENTRY("ALERT",    LOG_ALERT   ),
-	LOC_CODE_ENTRY("CRIT",     LOG_CRIT    ),
-	LOC_CODE_ENTRY("DEBUG",    LOG_DEBUG   ),
-	LOC_CODE_ENTRY("EMERG",    LOG_EMERG   ),
-	LOC_CODE_ENTRY("ERR",      LOG_ERR     ),
-	LOC_CODE_ENTRY("INFO",     LOG_INFO    ),
-	LOC_CODE_ENTRY("NOTICE",   LOG_NOTICE  ),
-	LOC_CODE_ENTRY("WARNING",  LOG_WARNING ),
-};
+/* log_priorities, generated from log_priorities.mph */
+#include "log_priorities.h"
+
+/* log_priorities by level, filled by drv_ctor */
+static const struct cc_log_code_st *log_levels[LOG_DEBUG + 1];
 
 /* Local global definitions */
 
@@ -105,24 +134,83 @@ VLOGGER(notice,  LOG_NOTICE  );
 VLOGGER(warning, LOG_WARNING );
 #undef VLOGGER
 
+void cc_log_emit(int level, const char *format, ...)
+{
+	va_list ap;
+
+	va_start(ap, format);
+	log_write(level, format, ap);
+	va_end(ap);
+	return;
+}
+
 void cc_log_close(void)
 {
+	cc_log_async_stop();
 	if(curdrvr)
 		curdrvr->ld_close();
 	return;
 }
 
+/*
+ * Write the lines the driver buffers. Those still queued for the async
+ * writer are not.
+ */
+void cc_log_flush(void)
+{
+	if(curdrvr && curdrvr->ld_flush)
+		curdrvr->ld_flush(LOG_EMERG);
+	return;
+}
+
+/*
+ * Level of a name, -1 if unknown.
+ */
+int cc_log_find_level(const char *name)
+{
+	const struct cc_log_code_st *ptr;
+
+	return NULL == (ptr = cc_log_find_name(name, log_priorities)) ? -1 : ptr->c_val;
+}
+
 int cc_log_config(const char *attribute, const char *value)
 {
 	if(0 == strcasecmp("level", attribute))
 	{
-		const struct cc_log_code_st *ptr;
-		if(NULL == (ptr = cc_log_find_name(value, log_priorities)))
+		int level;
+		if(0 > (level = cc_log_find_level(value)))
 		{
 			cc_log_err("cc_log_config: Unknown level name '%s'", value);
 			return -1;
 		}
-		loglevel = ptr->c_val;
+		cc_log_level = level;
+		log_levels_update();
+		return 0;
+	}
+
+	if(0 == strncasecmp("level.", attribute, 6))
+	{
+		cc_log_module_t *mod;
+		int              level;
+		for(mod = modules; mod && 0 != strcasecmp(mod->lm_name, attribute + 6); mod = mod->lm_next);
+		if(NULL == mod)
+		{
+			cc_log_err("cc_log_config: Unknown log module '%s'", attribute + 6);
+			return -1;
+		}
+		if(0 == strcasecmp("default", value))
+			mod->lm_set = 0;
+		else if(0 > (level = cc_log_find_level(value)))
+		{
+			cc_log_err("cc_log_config: Unknown level name '%s'", value);
+			return -1;
+		}
+		else
+		{
+			mod->lm_set   = 1;
+			mod->lm_level = level;
+		}
+		log_levels_update();
 		return 0;
 	}
 
@@ -137,18 +225,33 @@ int cc_log_config(const char *attribute, const char *value)
 		if(tfmt_def != timefmt)
 			cc_free((void *)timefmt);
 		timefmt = ptr;
+		(void)__atomic_add_fetch(&timegen, 1, __ATOMIC_RELEASE);
 		return 0;
 	}
 
+	if(0 == strcasecmp("timeprecision", attribute))
+	{
+		if(0 != strcmp("0", value) && 0 != strcmp("3", value) && 0 != strcmp("6", value))
+		{
+			cc_log_err("cc_log_config: bad time precision '%s' (0, 3 or 6)", value);
+			return -1;
+		}
+		timeprec = *value - '0';
+		return 0;
+	}
+
+	if(0 == strncasecmp("async", attribute, 5))
+		return cc_log_async_config(attribute, value);
+
 	if(0 == strcasecmp("type", attribute))
 	{
 		struct cc_log_driver_st *ptr;
 		for(ptr = drivers; ptr; ptr = ptr->ld_next)
 		{
-			if(0 == strcasecmp(ptr->ld_name, attribute))
+			if(0 == strcasecmp(ptr->ld_name, value))
 				goto found;
 		}
-		cc_log_err("cc_log_config: Unknown log type '%s'", attribute);
+		cc_log_err("cc_log_config: Unknown log type '%s'", value);
 		return -1;
 	found:
 		nextdrv = ptr;
@@ -159,25 +262,44 @@ int cc_log_config(const char *attribute, const char *value)
 }
 
 size_t cc_log_format_message (char *buffer, size_t bufsiz, int level, const char *format, va_list ap)
+{
+	struct timespec     ts;
+	char               *bufptr = buffer;
+	size_t              buffre = bufsiz;
+	size_t              wrtsiz;
+
+	(void)clock_gettime(LOG_CLOCK, &ts);
+	wrtsiz = cc_log_format_prefix(bufptr, buffre, level, &ts);
+	bufptr += wrtsiz, buffre -= wrtsiz;
+	if(buffre)
+	{
+		/* vsnprintf returns the length of the whole message */
+		wrtsiz = vsnprintf(bufptr, buffre, format, ap);
+		wrtsiz = CC_MIN(wrtsiz, buffre - 1);
+		bufptr += wrtsiz, buffre -= wrtsiz;
+	}
+	return bufsiz - buffre;
+}
+
+/*
+ * Time and level of a line logged at *ts.
+ */
+size_t cc_log_format_prefix(char *buffer, size_t bufsiz, int level, const struct timespec *ts)
 {
 	static const struct cc_log_code_st lvl_default[] = { LOC_CODE_ENTRY("UNKNOWN", 0) };
 
-	struct tm           tm[1];
-	time_t              curtime;
 	char               *bufptr = buffer;
 	size_t              buffre = bufsiz;
 	size_t              wrtsiz;
 
-	time(&curtime);
-	(void)localtime_r(&curtime, tm);
-	wrtsiz = strftime(bufptr, buffre, timefmt, tm);
+	wrtsiz = log_stamp(bufptr, buffre, ts);
 	bufptr += wrtsiz, buffre -= wrtsiz;
 	if(buffre) *(bufptr++) = ' ', buffre -= 1;
 	if(buffre) *(bufptr++) = '[', buffre -= 1;
 	if(buffre)
 	{
 		const struct cc_log_code_st *plvl;
-		if(NULL == (plvl = cc_log_find_code(level, log_priorities)))
+		if(level < 0 || level >= (int)CC_ARRAY_COUNT(log_levels) || NULL == (plvl = log_levels[level]))
 			plvl = lvl_default;
 		wrtsiz = CC_MIN(plvl->c_nlen, buffre);
 		(void)memcpy(bufptr, plvl->c_name, wrtsiz);
@@ -185,20 +307,34 @@ size_t cc_log_format_message (char *buffer, size_t bufsiz, int level, const char
 	}
 	if(buffre) *(bufptr++) = ']', buffre -= 1;
 	if(buffre) *(bufptr++) = ' ', buffre -= 1;
-	if(buffre)
-	{
-		wrtsiz = vsnprintf(bufptr, buffre, format, ap);
-		bufptr += wrtsiz, buffre -= wrtsiz;
-	}
 	return bufsiz - buffre;
 }
 
+size_t cc_log_format_line(char *buffer, size_t bufsiz, int level, const char *format, ...)
+{
+	va_list ap;
+	size_t  len;
+
+	va_start(ap, format);
+	len = cc_log_format_message(buffer, bufsiz, level, format, ap);
+	va_end(ap);
+	return len;
+}
+
 void cc_log_reinit(void)
 {
-	loglevel   = default_lvl;
+	cc_log_module_t *mod;
+
+	cc_log_level = default_lvl;
+	for(mod = modules; mod; mod = mod->lm_next)
+		mod->lm_set = 0;
+	log_levels_update();
 	if(tfmt_def != timefmt)
 		cc_free((void *)timefmt);
 	timefmt    = tfmt_def;
+	timeprec   = 0;
+	(void)__atomic_add_fetch(&timegen, 1, __ATOMIC_RELEASE);
+	cc_log_async_reinit();
 	nextdrv->ld_reinit();
 	cc_log_start();
 	return;
@@ -206,9 +342,11 @@ void cc_log_reinit(void)
 
 void cc_log_start(void)
 {
+	cc_log_async_stop();
 	curdrvr->ld_close();
 	curdrvr = nextdrv;
 	curdrvr->ld_open();
+	cc_log_async_start(curdrvr);
 	return;
 }
 
@@ -218,6 +356,14 @@ void cc_log_register_driver(struct cc_log_driver_st *driver)
 	return;
 }
 
+void cc_log_register_module(cc_log_module_t *module)
+{
+	module->lm_next = modules, modules = module;
+	if(!module->lm_set)
+		module->lm_level = cc_log_level;
+	return;
+}
+
 
 const struct cc_log_code_st *cc_log_search_code(int code, const struct cc_log_code_st *table, size_t tabsz)
 {
@@ -230,45 +376,95 @@ const struct cc_log_code_st *cc_log_search_code(int code, const struct cc_log_co
 	return NULL;
 }
 
-const struct cc_log_code_st *cc_log_search_name(const char *name, const struct cc_log_code_st *table, size_t tabsz)
+const struct cc_log_code_st *cc_log_search_name(const char *name, const struct cc_log_code_st *table, const cc_mph_t *mph)
 {
-	register const struct cc_log_code_st *curptr;
-	register const struct cc_log_code_st *endptr;
+	uint32_t index;
 
-	for(curptr = table, endptr = table + tabsz; curptr < endptr; curptr += 1)
-		if(0 == strcasecmp(curptr->c_name, name))
-			return curptr;
+	index = cc_mph_index_str(mph, name);
+	if(index < mph->mp_count && 0 == strcasecmp(table[index].c_name, name))
+		return table + index;
 	return NULL;
 }
 
 static void do_log(int level, const char *format, va_list ap)
 {
-	if(level <= loglevel)
+	if(level <= cc_log_level)
+		log_write(level, format, ap);
+	return;
+}
+
+static void log_write(int level, const char *format, va_list ap)
+{
+	if(0 != cc_log_async_write(level, format, ap))
 		curdrvr->ld_write(level, format, ap);
 	return;
 }
 
+/*
+ * The modules without a level of their own follow cc_log_level.
+ */
+static void log_levels_update(void)
+{
+	cc_log_module_t *mod;
+
+	for(mod = modules; mod; mod = mod->lm_next)
+		if(!mod->lm_set)
+			mod->lm_level = cc_log_level;
+	return;
+}
+
+/*
+ * Time prefix of a line, with timeprec digits of fractions of second.
+ * CLOCK_REALTIME_COARSE is read without a system call, but only moves
+ * at each clock tick (a few ms).
+ */
+static size_t log_stamp(char *buffer, size_t bufsiz, const struct timespec *ts)
+{
+	struct tm       tm[1];
+	unsigned        gen;
+	unsigned long   frac;
+	size_t          len;
+	int             i;
+
+	gen = __atomic_load_n(&timegen, __ATOMIC_ACQUIRE);
+	if(ts->tv_sec != stamp.ls_sec || gen != stamp.ls_gen)
+	{
+		(void)localtime_r(&ts->tv_sec, tm);
+		stamp.ls_len = strftime(stamp.ls_text, sizeof(stamp.ls_text), timefmt, tm);
+		stamp.ls_sec = ts->tv_sec;
+		stamp.ls_gen = gen;
+	}
+	len = CC_MIN(stamp.ls_len, bufsiz);
+	(void)memcpy(buffer, stamp.ls_text, len);
+	if(0 != timeprec && len + 1 + timeprec <= bufsiz)
+	{
+		frac = (unsigned long)ts->tv_nsec / (3 == timeprec ? 1000000UL : 1000UL);
+		buffer[len] = '.';
+		for(i = timeprec; i > 0; i -= 1, frac /= 10)
+			buffer[len + i] = (char)('0' + frac % 10);
+		len += 1 + timeprec;
+	}
+	return len;
+}
+
 /* STDERR driver */
 static void stderr_open  (void) { return; }
 static void stderr_close (void) __attribute__ ((weakref ("stderr_open")));
 static void stderr_reinit(void) __attribute__ ((weakref ("stderr_open")));
 static void stderr_write(int level, const char *format, va_list ap) {
-	char   wbuffer[128];
+	char   wbuffer[LOG_LINE];
 	size_t towrite;
-	towrite = cc_log_format_message(wbuffer, sizeof(wbuffer), level, format, ap);
-	if(towrite < sizeof(wbuffer))
-	{
-		wbuffer[towrite++] = '\n';
-		(void)CC_IO_WRITE(STDERR_FILENO, wbuffer, towrite);
-	}
-	else
-	{
-		(void)CC_IO_WRITE(STDERR_FILENO, wbuffer, towrite);
-		(void)CC_IO_WRITE(STDERR_FILENO, "\n", 1);
-	}
+	towrite = cc_log_format_message(wbuffer, sizeof(wbuffer) - 1, level, format, ap);
+	wbuffer[towrite++] = '\n';
+	(void)CC_IO_WRITE(STDERR_FILENO, wbuffer, towrite);
 	return;
 }
 
+static int stderr_writev(struct iovec *iov, int iovcnt)
+{
+	return -1 == cc_io_writev(STDERR_FILENO, iov, iovcnt) ? -1 : 0;
+}
+
 static int stderr_config(const char *attribute, const char *value)
 {
 	(void)attribute;
@@ -283,11 +479,16 @@ static struct cc_log_driver_st serrdrv = {
 	.ld_close   = stderr_close,
 	.ld_write   = stderr_write,
 	.ld_config  = stderr_config,
-	.ld_reinit  = stderr_reinit
+	.ld_reinit  = stderr_reinit,
+	.ld_writev  = stderr_writev
 };
 
 static __attribute__((constructor)) void drv_ctor(void)
 {
+	size_t ix;
+
+	for(ix = 0; ix < CC_ARRAY_COUNT(log_priorities); ix += 1)
+		log_levels[log_priorities[ix].c_val] = log_priorities + ix;
 	curdrvr = nextdrv = &serrdrv;
 	cc_log_register_driver(&serrdrv);
 	return;
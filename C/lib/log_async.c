@@ -0,0 +1,637 @@
+/*
+ * Copyright (c) 2026
+ *     Christian CAMIER <christian.c at promethee dot services>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Asynchronous logging.
+ *
+ * The logging threads format their line in a slot of a ring shared by
+ * all of them, and a writer thread hands the lines to the driver, up to
+ * ASYNC_BATCH lines by call of ld_writev. The ring is a bounded lock
+ * free queue : every slot holds a sequence number telling whether it is
+ * free for position p (p), or holds the line of position p (p + 1). A
+ * logging thread claims a position with one compare and swap on
+ * ay_head, and seldom has to wake the writer (see ASYNC_URGENT).
+ *
+ * When the ring is full, the logging thread waits for a free slot
+ * (block), or drops its line (drop), or drops it and the writer logs
+ * the number of lines dropped (count).
+ *
+ * The writer is started by cc_log_start when the "async" attribute is
+ * set and the driver has an ld_writev, and stopped by cc_log_close
+ * after it has written all the lines queued. Rings are never freed : a
+ * line logged while cc_log_close runs may be lost, but is never written
+ * to freed memory.
+ *
+ * In binary mode ("async_binary"), the logging threads only record the
+ * address of the format and the arguments (see log_binary.c), and the
+ * writer formats the lines. With "async_binfile", it does not even
+ * format them : the records are appended to the file, the driver is
+ * not used, and cc_logdecode formats them offline. The text of every
+ * format is written once, before its first event.
+ */
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <syslog.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <CCA/hash.h>
+#include <CCA/io.h>
+#include <CCA/memory.h>
+#include <CCA/swisstable.h>
+#include <CCA/util.h>
+
+#include "log_internal.h"
+
+#define ASYNC_SLOTS	1024		/* Default slots of the ring        */
+#define ASYNC_SLOTS_MIN	16
+#define ASYNC_LINE	LOG_LINE	/* Bytes of a line, newline included, */
+					/* or of a binary record              */
+#define ASYNC_BATCH	64		/* Lines by ld_writev               */
+#define ASYNC_IDLE	10		/* Milliseconds the writer sleeps   */
+
+/*
+ * A sleeping writer is woken for errors and every ay_every lines, the
+ * smaller of ASYNC_BATCH and half the ring, so that the ring does not
+ * fill before it is woken. Other lines wait for its next round,
+ * ASYNC_IDLE ms at most.
+ */
+#define ASYNC_URGENT(ay, level, pos) ((level) <= LOG_ERR || 0 == ((pos) + 1) % (ay)->ay_every)
+
+#define ASYNC_LOAD(p)	  __atomic_load_n(&(p), __ATOMIC_ACQUIRE)
+#define ASYNC_STORE(p, v) __atomic_store_n(&(p), v, __ATOMIC_RELEASE)
+
+enum async_policy_en {
+	ASYNC_BLOCK,
+	ASYNC_DROP,
+	ASYNC_COUNT
+};
+
+/* Local datatypes definition */
+struct async_slot_st {
+	uint64_t  as_seq;
+	uint32_t  as_len;
+	int32_t   as_level;
+	union {
+		char                 as_text[ASYNC_LINE];
+		struct cc_log_bin_st as_rec;
+	} as_u;
+};
+
+struct async_st {
+	uint64_t                  ay_head;	/* Next position to claim           */
+	char                      ay_pad1[56];
+	uint64_t                  ay_tail;	/* Next position to write           */
+	int                       ay_sleeping;	/* Writer waits on ay_wake          */
+	int                       ay_stop;
+	uint64_t                  ay_dropped;	/* Lines dropped, not reported yet  */
+	char                      ay_pad2[40];
+	uint64_t                  ay_mask;
+	uint64_t                  ay_every;	/* Lines between two wakes          */
+	int                       ay_policy;
+	int                       ay_binary;	/* Slots hold binary records        */
+	int                       ay_fd;	/* Binary file, -1 if none          */
+	CC_SWISSTABLE             ay_formats;	/* Formats written in ay_fd         */
+	struct async_slot_st     *ay_slots;
+	struct cc_log_driver_st  *ay_driver;
+	pthread_t                 ay_thread;
+	pthread_mutex_t           ay_lock;
+	pthread_cond_t            ay_wake;
+};
+
+/* Global functions */
+extern int           cc_log_async_config(const char *, const char *);
+extern unsigned long cc_log_async_dropped(void);
+extern void          cc_log_async_reinit(void);
+extern void          cc_log_async_start (struct cc_log_driver_st *);
+extern void          cc_log_async_stop  (void);
+extern int           cc_log_async_write (int, const char *, va_list);
+
+/* Local defined functions */
+static void         *async_writer(void *);
+static int           async_flag  (const char *, const char *, int *);
+static int           async_open  (struct async_st *);
+static void          async_close (struct async_st *);
+static size_t        async_batch (struct async_st *);
+static void          async_lines (struct async_st *, size_t);
+static void          async_binary(struct async_st *, const struct cc_log_bin_st **, size_t);
+static void          async_report(struct async_st *);
+static size_t        async_record(void *, size_t, int, const char *, ...);
+static int           async_comp  (const void *, const void *);
+static uint64_t      async_hash  (const void *);
+static void          async_wake  (struct async_st *);
+static void          async_init  (void);
+
+/* LOcal data */
+static struct async_st  async_ring;
+static struct async_st *async_running = NULL;	/* &async_ring while started */
+static int              async_enable  = 0;
+static size_t           async_nslots  = ASYNC_SLOTS;
+static int              async_policy  = ASYNC_BLOCK;
+static int              async_bin     = 0;
+static char            *async_binfile = NULL;
+static unsigned long    async_drops   = 0;	/* Total of lines dropped   */
+static pthread_once_t   async_once    = PTHREAD_ONCE_INIT;
+
+/* Lines of a batch formatted by the writer in binary mode */
+static char             async_render[ASYNC_BATCH][ASYNC_LINE];
+
+static const struct cc_log_code_st async_policies[] = {
+	LOC_CODE_ENTRY("block", ASYNC_BLOCK),
+	LOC_CODE_ENTRY("drop",  ASYNC_DROP ),
+	LOC_CODE_ENTRY("count", ASYNC_COUNT),
+};
+
+int cc_log_async_config(const char *attribute, const char *value)
+{
+	if(0 == strcasecmp("async", attribute))
+		return async_flag(attribute, value, &async_enable);
+
+	if(0 == strcasecmp("async_binary", attribute))
+		return async_flag(attribute, value, &async_bin);
+
+	if(0 == strcasecmp("async_binfile", attribute))
+	{
+		char *path = NULL;
+		if('\0' != *value && NULL == (path = cc_strdup(value)))
+		{
+			cc_log_err("cc_log_config: Cannot copy async_binfile value '%s'", value);
+			return -1;
+		}
+		cc_free(async_binfile);
+		async_binfile = path;
+		return 0;
+	}
+
+	if(0 == strcasecmp("async_slots", attribute))
+	{
+		char          *r;
+		unsigned long  v;
+		v = strtoul(value, &r, 0);
+		if((r && *r) || v < ASYNC_SLOTS_MIN || v > (1UL << 24))
+		{
+			cc_log_err("cc_log_config: bad async_slots value '%s'", value);
+			return -1;
+		}
+		for(async_nslots = ASYNC_SLOTS_MIN; async_nslots < v; async_nslots <<= 1);
+		return 0;
+	}
+
+	if(0 == strcasecmp("async_overflow", attribute))
+	{
+		size_t i;
+		for(i = 0; i < CC_ARRAY_COUNT(async_policies); i += 1)
+		{
+			if(0 == strcasecmp(async_policies[i].c_name, value))
+			{
+				async_policy = async_policies[i].c_val;
+				return 0;
+			}
+		}
+		cc_log_err("cc_log_config: bad async_overflow value '%s'", value);
+		return -1;
+	}
+
+	cc_log_err("cc_log_config: Unknown attribute '%s'", attribute);
+	return -1;
+}
+
+unsigned long cc_log_async_dropped(void)
+{
+	return __atomic_load_n(&async_drops, __ATOMIC_RELAXED);
+}
+
+void cc_log_async_reinit(void)
+{
+	async_enable = 0;
+	async_nslots = ASYNC_SLOTS;
+	async_policy = ASYNC_BLOCK;
+	async_bin    = 0;
+	cc_free(async_binfile);
+	async_binfile = NULL;
+	return;
+}
+
+void cc_log_async_start(struct cc_log_driver_st *driver)
+{
+	struct async_st *ay = &async_ring;
+	sigset_t         all;
+	sigset_t         old;
+	uint64_t         i;
+
+	if(NULL != async_running || !async_enable || (NULL == async_binfile && NULL == driver->ld_writev))
+		return;
+
+	(void)pthread_once(&async_once, async_init);
+	if(NULL == ay->ay_slots || ay->ay_mask + 1 != async_nslots)
+	{
+		/* The previous ring, if any, is left to late logging threads */
+		if(NULL == (ay->ay_slots = CC_TALLOC(struct async_slot_st, async_nslots)))
+		{
+			cc_log_err("cc_log_start: Cannot allocate the async ring, logging synchronously");
+			return;
+		}
+		ay->ay_mask = async_nslots - 1;
+	}
+	ay->ay_every    = CC_MIN(ASYNC_BATCH, (ay->ay_mask + 1) / 2);
+	if(NULL != async_binfile && 0 != async_open(ay))
+		return;
+	for(i = 0; i <= ay->ay_mask; i += 1)
+		ay->ay_slots[i].as_seq = i;
+	ay->ay_head     = 0;
+	ay->ay_tail     = 0;
+	ay->ay_sleeping = 0;
+	ay->ay_stop     = 0;
+	ay->ay_dropped  = 0;
+	ay->ay_policy   = async_policy;
+	ay->ay_binary   = async_bin || NULL != async_binfile;
+	ay->ay_driver   = driver;
+
+	/* Signals are for the threads of the application */
+	(void)sigfillset(&all);
+	(void)pthread_sigmask(SIG_SETMASK, &all, &old);
+	if(0 != pthread_create(&ay->ay_thread, NULL, async_writer, ay))
+	{
+		(void)pthread_sigmask(SIG_SETMASK, &old, NULL);
+		async_close(ay);
+		cc_log_err("cc_log_start: Cannot create the async writer, logging synchronously");
+		return;
+	}
+	(void)pthread_sigmask(SIG_SETMASK, &old, NULL);
+	__atomic_store_n(&async_running, ay, __ATOMIC_RELEASE);
+	return;
+}
+
+void cc_log_async_stop(void)
+{
+	struct async_st *ay;
+
+	if(NULL == (ay = __atomic_exchange_n(&async_running, NULL, __ATOMIC_ACQ_REL)))
+		return;
+	__atomic_store_n(&ay->ay_stop, 1, __ATOMIC_SEQ_CST);
+	async_wake(ay);
+	(void)pthread_join(ay->ay_thread, NULL);
+	async_close(ay);
+	return;
+}
+
+/*
+ * Queue the line, or return -1 when the writer is not started or is
+ * stopped while the line waits for a slot.
+ */
+int cc_log_async_write(int level, const char *format, va_list ap)
+{
+	struct async_st      *ay;
+	struct async_slot_st *slot;
+	uint64_t              pos;
+	uint64_t              seq;
+	size_t                len;
+
+	if(NULL == (ay = __atomic_load_n(&async_running, __ATOMIC_ACQUIRE)))
+		return -1;
+
+	pos = __atomic_load_n(&ay->ay_head, __ATOMIC_RELAXED);
+	for(;;)
+	{
+		slot = ay->ay_slots + (pos & ay->ay_mask);
+		seq  = ASYNC_LOAD(slot->as_seq);
+		if(seq == pos)
+		{
+			if(__atomic_compare_exchange_n(&ay->ay_head, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+				break;
+		}
+		else if((int64_t)(seq - pos) < 0)
+		{
+			/* Full : the slot still holds the line of pos - size */
+			if(ASYNC_BLOCK != ay->ay_policy)
+			{
+				(void)__atomic_add_fetch(&async_drops, 1, __ATOMIC_RELAXED);
+				if(ASYNC_COUNT == ay->ay_policy)
+					(void)__atomic_add_fetch(&ay->ay_dropped, 1, __ATOMIC_RELAXED);
+				if(__atomic_load_n(&ay->ay_sleeping, __ATOMIC_SEQ_CST))
+					async_wake(ay);
+				return 0;
+			}
+			/* Stopped : nobody drains the ring any more */
+			if(ay != __atomic_load_n(&async_running, __ATOMIC_ACQUIRE))
+				return -1;
+			async_wake(ay);
+			(void)sched_yield();
+			pos = __atomic_load_n(&ay->ay_head, __ATOMIC_RELAXED);
+		}
+		else
+			pos = __atomic_load_n(&ay->ay_head, __ATOMIC_RELAXED);
+	}
+
+	if(ay->ay_binary)
+		len = cc_log_bin_capture(&slot->as_u.as_rec, ASYNC_LINE, level, format, ap);
+	else
+	{
+		len = cc_log_format_message(slot->as_u.as_text, ASYNC_LINE - 1, level, format, ap);
+		slot->as_u.as_text[len++] = '\n';
+	}
+	slot->as_len   = (uint32_t)len;
+	slot->as_level = level;
+	__atomic_store_n(&slot->as_seq, pos + 1, __ATOMIC_SEQ_CST);
+	if(ASYNC_URGENT(ay, level, pos) && __atomic_load_n(&ay->ay_sleeping, __ATOMIC_SEQ_CST))
+		async_wake(ay);
+	return 0;
+}
+
+static void *async_writer(void *arg)
+{
+	struct async_st            *ay = (struct async_st *)arg;
+	const struct cc_log_bin_st *rec[ASYNC_BATCH];
+	struct timespec             ts;
+	size_t                      n;
+	size_t                      i;
+	int                         level;
+
+	for(;;)
+	{
+		if(0 != (n = async_batch(ay)))
+		{
+			if(ay->ay_fd < 0)
+			{
+				/* A buffering driver writes at once the severe lines */
+				async_lines(ay, n);
+				for(level = LOG_DEBUG, i = 0; i < n; i += 1)
+					level = CC_MIN(level, ay->ay_slots[(ay->ay_tail + i) & ay->ay_mask].as_level);
+				if(NULL != ay->ay_driver->ld_flush)
+					ay->ay_driver->ld_flush(level);
+			}
+			else
+			{
+				for(i = 0; i < n; i += 1)
+					rec[i] = &ay->ay_slots[(ay->ay_tail + i) & ay->ay_mask].as_u.as_rec;
+				async_binary(ay, rec, n);
+			}
+			for(i = 0; i < n; i += 1, ay->ay_tail += 1)
+				ASYNC_STORE(ay->ay_slots[ay->ay_tail & ay->ay_mask].as_seq, ay->ay_tail + ay->ay_mask + 1);
+			continue;
+		}
+		if(0 != __atomic_load_n(&ay->ay_dropped, __ATOMIC_RELAXED))
+			async_report(ay);
+		if(__atomic_load_n(&ay->ay_stop, __ATOMIC_SEQ_CST))
+			break;
+		/* Idle : the driver writes the lines buffered for too long */
+		if(ay->ay_fd < 0 && NULL != ay->ay_driver->ld_flush)
+			ay->ay_driver->ld_flush(LOG_DEBUG + 1);
+
+		(void)pthread_mutex_lock(&ay->ay_lock);
+		__atomic_store_n(&ay->ay_sleeping, 1, __ATOMIC_SEQ_CST);
+		if(ay->ay_tail + 1 != __atomic_load_n(&ay->ay_slots[ay->ay_tail & ay->ay_mask].as_seq, __ATOMIC_SEQ_CST)
+		&& !__atomic_load_n(&ay->ay_stop, __ATOMIC_SEQ_CST))
+		{
+			(void)clock_gettime(CLOCK_REALTIME, &ts);
+			ts.tv_nsec += ASYNC_IDLE * 1000000L;
+			ts.tv_sec  += ts.tv_nsec / 1000000000L;
+			ts.tv_nsec %= 1000000000L;
+			(void)pthread_cond_timedwait(&ay->ay_wake, &ay->ay_lock, &ts);
+		}
+		__atomic_store_n(&ay->ay_sleeping, 0, __ATOMIC_RELAXED);
+		(void)pthread_mutex_unlock(&ay->ay_lock);
+	}
+	return NULL;
+}
+
+static int async_flag(const char *attribute, const char *value, int *flag)
+{
+	if(0 == strcasecmp("on", value) || 0 == strcasecmp("yes", value) || 0 == strcmp("1", value))
+		*flag = 1;
+	else if(0 == strcasecmp("off", value) || 0 == strcasecmp("no", value) || 0 == strcmp("0", value))
+		*flag = 0;
+	else
+	{
+		cc_log_err("cc_log_config: bad %s value '%s'", attribute, value);
+		return -1;
+	}
+	return 0;
+}
+
+/*
+ * Open the binary file, and start it again with a head : the addresses
+ * of the formats written before are not valid any more.
+ */
+static int async_open(struct async_st *ay)
+{
+	struct cc_log_bin_head_st head;
+	struct iovec              iov[1];
+
+	if(NULL == ay->ay_formats && NULL == (ay->ay_formats = cc_swisstable_create(64, async_comp, async_hash, NULL)))
+	{
+		cc_log_err("cc_log_start: Cannot allocate the async formats, logging synchronously");
+		return -1;
+	}
+	if(0 > (ay->ay_fd = open(async_binfile, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0640)))
+	{
+		cc_log_err("cc_log_start: Cannot open %s (%m), logging synchronously", async_binfile);
+		return -1;
+	}
+	(void)memset(&head, 0x00, sizeof(head));
+	(void)memcpy(head.lh_magic, LOG_BIN_MAGIC, sizeof(head.lh_magic));
+	head.lh_order   = LOG_BIN_ORDER;
+	head.lh_version = LOG_BIN_VERSION;
+	iov[0].iov_base = &head;
+	iov[0].iov_len  = sizeof(head);
+	if(0 > cc_io_writev(ay->ay_fd, iov, 1))
+	{
+		cc_log_err("cc_log_start: Cannot write %s (%m), logging synchronously", async_binfile);
+		async_close(ay);
+		return -1;
+	}
+	return 0;
+}
+
+static void async_close(struct async_st *ay)
+{
+	if(ay->ay_fd >= 0)
+		(void)close(ay->ay_fd);
+	ay->ay_fd = -1;
+	if(NULL != ay->ay_formats)
+		cc_swisstable_destroy(ay->ay_formats);
+	ay->ay_formats = NULL;
+	return;
+}
+
+/*
+ * Number of lines queued from ay_tail, ASYNC_BATCH at most.
+ */
+static size_t async_batch(struct async_st *ay)
+{
+	size_t n;
+
+	for(n = 0; n < ASYNC_BATCH; n += 1)
+		if(ASYNC_LOAD(ay->ay_slots[(ay->ay_tail + n) & ay->ay_mask].as_seq) != ay->ay_tail + n + 1)
+			break;
+	return n;
+}
+
+/*
+ * Hand the n lines from ay_tail to the driver, formatting the binary
+ * records first.
+ */
+static void async_lines(struct async_st *ay, size_t n)
+{
+	struct async_slot_st *slot;
+	struct iovec          iov[ASYNC_BATCH];
+	size_t                i;
+	size_t                len;
+
+	for(i = 0; i < n; i += 1)
+	{
+		slot = ay->ay_slots + ((ay->ay_tail + i) & ay->ay_mask);
+		if(ay->ay_binary)
+		{
+			len = cc_log_bin_render(async_render[i], ASYNC_LINE - 1, &slot->as_u.as_rec, (const char *)(uintptr_t)slot->as_u.as_rec.lb_format);
+			async_render[i][len++] = '\n';
+			iov[i].iov_base = async_render[i];
+			iov[i].iov_len  = len;
+		}
+		else
+		{
+			iov[i].iov_base = slot->as_u.as_text;
+			iov[i].iov_len  = slot->as_len;
+		}
+	}
+	(void)ay->ay_driver->ld_writev(iov, (int)n);
+	return;
+}
+
+/*
+ * Append the n records to the binary file, each one preceded by the
+ * text of its format the first time it is seen.
+ */
+static void async_binary(struct async_st *ay, const struct cc_log_bin_st **rec, size_t n)
+{
+	static const char    zero[8];
+	struct cc_log_bin_st fmt[ASYNC_BATCH];
+	struct iovec         iov[4 * ASYNC_BATCH];
+	const char          *text;
+	size_t               len;
+	size_t               i;
+	int                  c;
+
+	for(c = 0, i = 0; i < n; i += 1)
+	{
+		text = (const char *)(uintptr_t)rec[i]->lb_format;
+		if(CC_SWISSTABLE_NOENT == cc_swisstable_search(ay->ay_formats, text, NULL)
+		&& CC_SWISSTABLE_OK    == cc_swisstable_add(ay->ay_formats, text, NULL))
+		{
+			len = strlen(text) + 1;
+			(void)memset(fmt + i, 0x00, sizeof(fmt[i]));
+			fmt[i].lb_size   = (uint32_t)(sizeof(fmt[i]) + LOG_BIN_ROUND(len));
+			fmt[i].lb_type   = LOG_BIN_FORMAT;
+			fmt[i].lb_format = rec[i]->lb_format;
+			iov[c].iov_base   = fmt + i;
+			iov[c++].iov_len  = sizeof(fmt[i]);
+			iov[c].iov_base   = (void *)text;
+			iov[c++].iov_len  = len;
+			iov[c].iov_base   = (void *)zero;
+			iov[c++].iov_len  = LOG_BIN_ROUND(len) - len;
+		}
+		iov[c].iov_base  = (void *)rec[i];
+		iov[c++].iov_len = rec[i]->lb_size;
+	}
+	(void)cc_io_writev(ay->ay_fd, iov, c);
+	return;
+}
+
+static void async_report(struct async_st *ay)
+{
+	static const char           *format = "cc_log: %lu lines dropped, async ring full";
+	union {
+		char                 text[128];
+		struct cc_log_bin_st rec;
+	}                            line;
+	const struct cc_log_bin_st  *rec[1];
+	struct iovec                 iov[1];
+	unsigned long                count;
+	size_t                       len;
+
+	count = (unsigned long)__atomic_exchange_n(&ay->ay_dropped, 0, __ATOMIC_RELAXED);
+	if(ay->ay_fd >= 0)
+	{
+		(void)async_record(&line.rec, sizeof(line), LOG_WARNING, format, count);
+		rec[0] = &line.rec;
+		async_binary(ay, rec, 1);
+		return;
+	}
+	len = cc_log_format_line(line.text, sizeof(line) - 1, LOG_WARNING, format, count);
+	line.text[len++] = '\n';
+	iov[0].iov_base = line.text;
+	iov[0].iov_len  = len;
+	(void)ay->ay_driver->ld_writev(iov, 1);
+	return;
+}
+
+static void async_wake(struct async_st *ay)
+{
+	(void)pthread_mutex_lock(&ay->ay_lock);
+	(void)pthread_cond_signal(&ay->ay_wake);
+	(void)pthread_mutex_unlock(&ay->ay_lock);
+	return;
+}
+
+static size_t async_record(void *buffer, size_t size, int level, const char *format, ...)
+{
+	va_list ap;
+	size_t  len;
+
+	va_start(ap, format);
+	len = cc_log_bin_capture(buffer, size, level, format, ap);
+	va_end(ap);
+	return len;
+}
+
+/*
+ * The formats are keyed by address.
+ */
+static int async_comp(const void *a, const void *b)
+{
+	return a != b;
+}
+
+static uint64_t async_hash(const void *key)
+{
+	uintptr_t value = (uintptr_t)key;
+
+	return cc_hash64(&value, sizeof(value), 0);
+}
+
+/*
+ * Lines still queued at exit are written.
+ */
+static void async_init(void)
+{
+	async_ring.ay_fd = -1;
+	(void)pthread_mutex_init(&async_ring.ay_lock, NULL);
+	(void)pthread_cond_init(&async_ring.ay_wake, NULL);
+	(void)atexit(cc_log_async_stop);
+	return;
+}
@@ -0,0 +1,488 @@
+/*
+ * Copyright (c) 2026
+ *     Christian CAMIER <christian.c at promethee dot services>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Deferred formatting : cc_log_bin_capture only copies the arguments a
+ * format consumes into a binary record (see log_internal.h), and
+ * cc_log_bin_render formats the record later, conversion by conversion,
+ * in the async writer or in cc_logdecode.
+ *
+ * Positional arguments (%1$d) are not supported : the record stops at
+ * the first one, as when it has no room left, and the rest of the
+ * format is rendered as is.
+ */
+
+#include <sys/types.h>
+#include <errno.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <wchar.h>
+
+#include <CCA/util.h>
+
+#include "log_internal.h"
+
+enum bin_kind_en {
+	BIN_NONE,			/* No argument : %%, unknown ones   */
+	BIN_INT,
+	BIN_DOUBLE,
+	BIN_LDOUBLE,
+	BIN_STRING,
+	BIN_WSTRING,			/* %ls, recorded as a string        */
+	BIN_POINTER,
+	BIN_ERRNO,			/* %m                               */
+	BIN_COUNT,			/* %n, ignored                      */
+	BIN_POSITION			/* %1$d, not supported              */
+};
+
+enum bin_len_en {
+	BIN_LEN_NONE,
+	BIN_LEN_HH,
+	BIN_LEN_H,
+	BIN_LEN_L,
+	BIN_LEN_LL,
+	BIN_LEN_J,
+	BIN_LEN_Z,
+	BIN_LEN_T,
+	BIN_LEN_BIGL
+};
+
+#define BIN_SPEC	32		/* Longest conversion rendered      */
+
+/* snprintf of one conversion, with its '*' arguments */
+#define BIN_EMIT(o, n, spec, c, w, pr, val)					\
+	((c)->bc_wstar								\
+	 ? ((c)->bc_pstar ? snprintf(o, n, spec, w, pr, val) : snprintf(o, n, spec, w, val))	\
+	 : ((c)->bc_pstar ? snprintf(o, n, spec, pr, val)    : snprintf(o, n, spec, val)))
+
+/* Local datatypes definition */
+struct bin_conv_st {
+	const char *bc_start;		/* The '%'                          */
+	const char *bc_end;		/* After the conversion character   */
+	const char *bc_dot;		/* Precision, or what follows width */
+	int         bc_wstar;		/* Width given by an argument       */
+	int         bc_pstar;		/* Precision given by an argument   */
+	int         bc_prec;		/* Precision, -1 if none            */
+	int         bc_len;
+	int         bc_kind;
+	int         bc_unsigned;
+};
+
+/* Global functions */
+extern size_t cc_log_bin_capture(void *, size_t, int, const char *, va_list);
+extern size_t cc_log_bin_render (char *, size_t, const struct cc_log_bin_st *, const char *);
+
+/* Local defined functions */
+static int    bin_conv  (const char *, struct bin_conv_st *);
+static int    bin_put   (unsigned char **, const unsigned char *, const void *, size_t);
+static int    bin_get   (const unsigned char **, const unsigned char *, void *, size_t);
+static void   bin_out   (char **, size_t *, const char *, size_t);
+static int    bin_int   (char *, size_t, const char *, const struct bin_conv_st *, int, int, uint64_t);
+static int    bin_str   (char *, size_t, const struct bin_conv_st *, int, const char *, size_t);
+
+/*
+ * Record in buffer (size bytes, a multiple of 8) an event of level for
+ * format and the arguments of ap. Returns the size of the record.
+ */
+size_t cc_log_bin_capture(void *buffer, size_t size, int level, const char *format, va_list ap)
+{
+	struct cc_log_bin_st *rec = (struct cc_log_bin_st *)buffer;
+	const unsigned char  *end = (const unsigned char *)buffer + size;
+	unsigned char        *p   = rec->lb_args;
+	struct bin_conv_st    c;
+	struct timespec       ts;
+	const char           *f;
+	const char           *s;
+	const wchar_t        *ws;
+	uint64_t              v;
+	uint32_t              n;
+	double                d;
+	long double           ld;
+	int                   star;
+	int                   prec;
+	int                   w;
+
+	(void)clock_gettime(LOG_CLOCK, &ts);
+	rec->lb_type   = LOG_BIN_EVENT;
+	rec->lb_level  = (int16_t)level;
+	rec->lb_errno  = errno;
+	rec->lb_flags  = 0;
+	rec->lb_pad    = 0;
+	rec->lb_format = (uint64_t)(uintptr_t)format;
+	rec->lb_sec    = (int64_t)ts.tv_sec;
+	rec->lb_nsec   = (int64_t)ts.tv_nsec;
+
+	for(f = format; bin_conv(f, &c); f = c.bc_end)
+	{
+		if(BIN_POSITION == c.bc_kind)
+			goto trunc;
+		prec = c.bc_prec;
+		if(c.bc_wstar)
+		{
+			star = va_arg(ap, int);
+			if(!bin_put(&p, end, &star, sizeof(star)))
+				goto trunc;
+		}
+		if(c.bc_pstar)
+		{
+			star = prec = va_arg(ap, int);
+			if(!bin_put(&p, end, &star, sizeof(star)))
+				goto trunc;
+		}
+		switch(c.bc_kind)
+		{
+		case BIN_INT:
+			switch(c.bc_len)
+			{
+			case BIN_LEN_L:  v = c.bc_unsigned ? (uint64_t)va_arg(ap, unsigned long)      : (uint64_t)va_arg(ap, long);      break;
+			case BIN_LEN_LL: v = c.bc_unsigned ? (uint64_t)va_arg(ap, unsigned long long) : (uint64_t)va_arg(ap, long long); break;
+			case BIN_LEN_J:  v = c.bc_unsigned ? (uint64_t)va_arg(ap, uintmax_t)          : (uint64_t)va_arg(ap, intmax_t);  break;
+			case BIN_LEN_Z:  v = (uint64_t)va_arg(ap, size_t);    break;
+			case BIN_LEN_T:  v = (uint64_t)va_arg(ap, ptrdiff_t); break;
+			default:         v = c.bc_unsigned ? (uint64_t)va_arg(ap, unsigned int)       : (uint64_t)va_arg(ap, int);       break;
+			}
+			if(!bin_put(&p, end, &v, sizeof(v)))
+				goto trunc;
+			break;
+		case BIN_DOUBLE:
+			d = va_arg(ap, double);
+			if(!bin_put(&p, end, &d, sizeof(d)))
+				goto trunc;
+			break;
+		case BIN_LDOUBLE:
+			ld = va_arg(ap, long double);
+			if(!bin_put(&p, end, &ld, sizeof(ld)))
+				goto trunc;
+			break;
+		case BIN_POINTER:
+			v = (uint64_t)(uintptr_t)va_arg(ap, void *);
+			if(!bin_put(&p, end, &v, sizeof(v)))
+				goto trunc;
+			break;
+		case BIN_COUNT:
+			(void)va_arg(ap, void *);
+			break;
+		case BIN_STRING:
+		case BIN_WSTRING:
+			if(p + LOG_BIN_ROUND(sizeof(n)) > end)
+				goto trunc;
+			w = (int)(end - p - sizeof(n));
+			if(BIN_STRING == c.bc_kind)
+			{
+				if(NULL == (s = va_arg(ap, const char *)))
+					n = LOG_BIN_NULL;
+				else
+				{
+					n = (uint32_t)(prec >= 0 ? strnlen(s, (size_t)prec) : strlen(s));
+					n = CC_MIN(n, (uint32_t)w);
+					(void)memcpy(p + sizeof(n), s, n);
+				}
+			}
+			else
+			{
+				if(NULL == (ws = va_arg(ap, const wchar_t *)))
+					n = LOG_BIN_NULL;
+				else
+				{
+					/* snprintf needs the room of its terminating NUL */
+					w = prec >= 0 ? CC_MIN(w - 1, prec) : w - 1;
+					n = (uint32_t)CC_MAX(snprintf((char *)p + sizeof(n), (size_t)w + 1, "%ls", ws), 0);
+					n = CC_MIN(n, (uint32_t)w);
+				}
+			}
+			(void)memcpy(p, &n, sizeof(n));
+			w  = LOG_BIN_NULL == n ? 0 : (int)n;
+			(void)memset(p + sizeof(n) + w, 0x00, LOG_BIN_ROUND(sizeof(n) + w) - sizeof(n) - w);
+			p += LOG_BIN_ROUND(sizeof(n) + w);
+			break;
+		default:
+			break;
+		}
+	}
+	rec->lb_size = (uint32_t)(p - (unsigned char *)buffer);
+	return rec->lb_size;
+trunc:
+	rec->lb_flags |= LOG_BIN_TRUNC;
+	rec->lb_size   = (uint32_t)(p - (unsigned char *)buffer);
+	return rec->lb_size;
+}
+
+/*
+ * Format in buffer (prefix included, newline excluded) the event rec
+ * of format. Returns the length of the line, which is terminated.
+ */
+size_t cc_log_bin_render(char *buffer, size_t bufsiz, const struct cc_log_bin_st *rec, const char *format)
+{
+	const unsigned char *p   = rec->lb_args;
+	const unsigned char *end = (const unsigned char *)rec + rec->lb_size;
+	struct bin_conv_st   c;
+	struct timespec      ts;
+	char                 spec[BIN_SPEC];
+	const char          *f;
+	const char          *e;
+	char                *o;
+	size_t               n;
+	size_t               sl;
+	uint64_t             v;
+	uint32_t             l;
+	double               d;
+	long double          ld;
+	int                  w;
+	int                  pr;
+	int                  r;
+
+	if(0 == bufsiz)
+		return 0;
+	ts.tv_sec  = (time_t)rec->lb_sec;
+	ts.tv_nsec = (long)rec->lb_nsec;
+	n  = cc_log_format_prefix(buffer, bufsiz - 1, rec->lb_level, &ts);
+	o  = buffer + n;
+	n  = bufsiz - n;
+	w  = pr = 0;
+
+	for(f = format; n > 1 && bin_conv(f, &c); f = c.bc_end)
+	{
+		bin_out(&o, &n, f, (size_t)(c.bc_start - f));
+		f  = c.bc_start;
+		sl = (size_t)(c.bc_end - c.bc_start);
+		if(BIN_POSITION == c.bc_kind || sl >= sizeof(spec))
+			break;
+		/* bin_str appends ".*s" to the flags and width */
+		if((BIN_STRING == c.bc_kind || BIN_WSTRING == c.bc_kind || BIN_ERRNO == c.bc_kind) && (size_t)(c.bc_dot - c.bc_start) + 4 > sizeof(spec))
+			break;
+		if(BIN_NONE == c.bc_kind || BIN_COUNT == c.bc_kind)
+		{
+			if('%' == c.bc_end[-1] && 2 == sl)
+				bin_out(&o, &n, "%", 1);
+			else if(BIN_NONE == c.bc_kind)
+				bin_out(&o, &n, c.bc_start, sl);
+			continue;
+		}
+		if((c.bc_wstar && !bin_get(&p, end, &w, sizeof(w))) || (c.bc_pstar && !bin_get(&p, end, &pr, sizeof(pr))))
+			break;
+		(void)memcpy(spec, c.bc_start, sl);
+		spec[sl] = '\0';
+
+		switch(c.bc_kind)
+		{
+		case BIN_INT:
+			if(!bin_get(&p, end, &v, sizeof(v)))
+				goto rest;
+			r = bin_int(o, n, spec, &c, w, pr, v);
+			break;
+		case BIN_DOUBLE:
+			if(!bin_get(&p, end, &d, sizeof(d)))
+				goto rest;
+			r = BIN_EMIT(o, n, spec, &c, w, pr, d);
+			break;
+		case BIN_LDOUBLE:
+			if(!bin_get(&p, end, &ld, sizeof(ld)))
+				goto rest;
+			r = BIN_EMIT(o, n, spec, &c, w, pr, ld);
+			break;
+		case BIN_POINTER:
+			if(!bin_get(&p, end, &v, sizeof(v)))
+				goto rest;
+			r = BIN_EMIT(o, n, spec, &c, w, pr, (void *)(uintptr_t)v);
+			break;
+		case BIN_ERRNO:
+			e = strerror(rec->lb_errno);
+			r = bin_str(o, n, &c, w, e, strlen(e));
+			break;
+		default:
+			/* The precision was applied when the string was recorded */
+			if(p + LOG_BIN_ROUND(sizeof(l)) > end)
+				goto rest;
+			(void)memcpy(&l, p, sizeof(l));
+			if(LOG_BIN_NULL == l)
+			{
+				r  = bin_str(o, n, &c, w, "(null)", 6);
+				p += LOG_BIN_ROUND(sizeof(l));
+			}
+			else
+			{
+				if((size_t)(end - p) < LOG_BIN_ROUND(sizeof(l) + (size_t)l))
+					goto rest;
+				r  = bin_str(o, n, &c, w, (const char *)p + sizeof(l), l);
+				p += LOG_BIN_ROUND(sizeof(l) + (size_t)l);
+			}
+			break;
+		}
+		r  = (int)CC_MIN((size_t)CC_MAX(r, 0), n - 1);
+		o += r;
+		n -= (size_t)r;
+	}
+	/* The tail of the format, or what the record lacks the arguments of */
+rest:
+	bin_out(&o, &n, f, strlen(f));
+	*o = '\0';
+	return (size_t)(o - buffer);
+}
+
+/*
+ * Next conversion from fmt, 0 if none.
+ */
+static int bin_conv(const char *fmt, struct bin_conv_st *c)
+{
+	const char *p;
+
+	if(NULL == (p = strchr(fmt, '%')))
+		return 0;
+	c->bc_start    = p++;
+	c->bc_wstar    = 0;
+	c->bc_pstar    = 0;
+	c->bc_prec     = -1;
+	c->bc_len      = BIN_LEN_NONE;
+	c->bc_kind     = BIN_NONE;
+	c->bc_unsigned = 0;
+
+	if('%' == *p)
+	{
+		c->bc_end = p + 1;
+		return 1;
+	}
+	for(; '\0' != *p && NULL != strchr("-+ #0'I", *p); p += 1);
+	if('*' == *p)
+		c->bc_wstar = 1, p += 1;
+	else
+		for(; *p >= '0' && *p <= '9'; p += 1);
+	if('$' == *p)
+	{
+		c->bc_kind = BIN_POSITION;
+		c->bc_end  = p + 1;
+		return 1;
+	}
+	c->bc_dot = p;
+	if('.' == *p)
+	{
+		p += 1;
+		if('*' == *p)
+			c->bc_pstar = 1, p += 1;
+		else
+			for(c->bc_prec = 0; *p >= '0' && *p <= '9'; c->bc_prec = 10 * c->bc_prec + (*p - '0'), p += 1);
+	}
+	switch(*p)
+	{
+	case 'h': p += 1; c->bc_len = ('h' == *p) ? (p += 1, BIN_LEN_HH) : BIN_LEN_H; break;
+	case 'l': p += 1; c->bc_len = ('l' == *p) ? (p += 1, BIN_LEN_LL) : BIN_LEN_L; break;
+	case 'q': p += 1; c->bc_len = BIN_LEN_LL;   break;
+	case 'L': p += 1; c->bc_len = BIN_LEN_BIGL; break;
+	case 'j': p += 1; c->bc_len = BIN_LEN_J;    break;
+	case 'z': p += 1; c->bc_len = BIN_LEN_Z;    break;
+	case 't': p += 1; c->bc_len = BIN_LEN_T;    break;
+	default:                                    break;
+	}
+	switch(*p)
+	{
+	case 'o': case 'u': case 'x': case 'X':
+		c->bc_unsigned = 1;
+		/* Falls through */
+	case 'd': case 'i': case 'c':
+		c->bc_kind = BIN_INT;
+		break;
+	case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+		c->bc_kind = (BIN_LEN_BIGL == c->bc_len) ? BIN_LDOUBLE : BIN_DOUBLE;
+		break;
+	case 's':
+		c->bc_kind = (BIN_LEN_L == c->bc_len) ? BIN_WSTRING : BIN_STRING;
+		break;
+	case 'p':
+		c->bc_kind = BIN_POINTER;
+		break;
+	case 'm':
+		c->bc_kind = BIN_ERRNO;
+		break;
+	case 'n':
+		c->bc_kind = BIN_COUNT;
+		break;
+	default:
+		break;
+	}
+	c->bc_end = ('\0' == *p) ? p : p + 1;
+	return 1;
+}
+
+/*
+ * Copy a value of len bytes at *p, each value taking a multiple of 8.
+ */
+static int bin_put(unsigned char **p, const unsigned char *end, const void *value, size_t len)
+{
+	if(*p + LOG_BIN_ROUND(len) > end)
+		return 0;
+	(void)memcpy(*p, value, len);
+	(void)memset(*p + len, 0x00, LOG_BIN_ROUND(len) - len);
+	*p += LOG_BIN_ROUND(len);
+	return 1;
+}
+
+static int bin_get(const unsigned char **p, const unsigned char *end, void *value, size_t len)
+{
+	if(*p + LOG_BIN_ROUND(len) > end)
+		return 0;
+	(void)memcpy(value, *p, len);
+	*p += LOG_BIN_ROUND(len);
+	return 1;
+}
+
+static void bin_out(char **o, size_t *n, const char *text, size_t len)
+{
+	len = CC_MIN(len, *n - 1);
+	(void)memcpy(*o, text, len);
+	*o += len;
+	*n -= len;
+	return;
+}
+
+/*
+ * An integer, converted back to the type of its length modifier.
+ */
+static int bin_int(char *o, size_t n, const char *spec, const struct bin_conv_st *c, int w, int pr, uint64_t v)
+{
+	switch(c->bc_len)
+	{
+	case BIN_LEN_L:
+		return c->bc_unsigned ? BIN_EMIT(o, n, spec, c, w, pr, (unsigned long)v)      : BIN_EMIT(o, n, spec, c, w, pr, (long)v);
+	case BIN_LEN_LL:
+		return c->bc_unsigned ? BIN_EMIT(o, n, spec, c, w, pr, (unsigned long long)v) : BIN_EMIT(o, n, spec, c, w, pr, (long long)v);
+	case BIN_LEN_J:
+		return c->bc_unsigned ? BIN_EMIT(o, n, spec, c, w, pr, (uintmax_t)v)          : BIN_EMIT(o, n, spec, c, w, pr, (intmax_t)v);
+	case BIN_LEN_Z:
+		return BIN_EMIT(o, n, spec, c, w, pr, (size_t)v);
+	case BIN_LEN_T:
+		return BIN_EMIT(o, n, spec, c, w, pr, (ptrdiff_t)v);
+	default:
+		return c->bc_unsigned ? BIN_EMIT(o, n, spec, c, w, pr, (unsigned int)v)       : BIN_EMIT(o, n, spec, c, w, pr, (int)v);
+	}
+}
+
+/*
+ * A string of len bytes, not terminated, with the flags and width of c,
+ * which leave room for ".*s" in a spec (checked by cc_log_bin_render).
+ */
+static int bin_str(char *o, size_t n, const struct bin_conv_st *c, int w, const char *text, size_t len)
+{
+	char   spec[BIN_SPEC];
+	size_t sl = (size_t)(c->bc_dot - c->bc_start);
+
+	(void)memcpy(spec, c->bc_start, sl);
+	(void)memcpy(spec + sl, ".*s", 4);
+	return c->bc_wstar ? snprintf(o, n, spec, w, (int)len, text) : snprintf(o, n, spec, (int)len, text);
+}
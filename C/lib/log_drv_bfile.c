@@ -0,0 +1,479 @@
+/*
+ * Copyright (c) 2026
+ *     Christian CAMIER <christian.c at promethee dot services>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Buffered file driver ("bfile").
+ *
+ * The lines are formatted in a buffer of buffer_size bytes, written to
+ * the file by one write when it is full, when a line of flush_level or
+ * more severe is logged, or when the oldest line waits for more than
+ * flush_interval ms (checked when a line is logged, and by the async
+ * writer when it is idle). The lines of the async writer are written
+ * with the buffer by one writev when they do not fit in it.
+ *
+ * After a write, the file is rotated when it reaches rotate_size bytes
+ * or rotate_interval seconds : file.N-1 is renamed file.N, ..., file is
+ * renamed file.1 and a new file is created. Each rename is atomic, so
+ * the file always exists for readers. If the new file cannot be created,
+ * the lines go on to file.1 until the next rotation.
+ *
+ * The datasync attribute makes fdatasync run after every write (flush),
+ * before a rotation and at close (rotate), or never (none).
+ */
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <syslog.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <CCA/io.h>
+#include <CCA/memory.h>
+#include <CCA/util.h>
+
+#include "log_internal.h"
+
+#define BFILE_BATCH	64		/* iovecs of a writev               */
+
+#ifdef CLOCK_MONOTONIC_COARSE
+# define BFILE_CLOCK	CLOCK_MONOTONIC_COARSE
+#else
+# define BFILE_CLOCK	CLOCK_MONOTONIC
+#endif
+
+enum bfile_sync_en {
+	BFILE_SYNC_NONE,
+	BFILE_SYNC_FLUSH,
+	BFILE_SYNC_ROTATE
+};
+
+static void   bfile_open   (void);
+static void   bfile_close  (void);
+static void   bfile_write  (int , const char *, va_list);
+static int    bfile_writev (struct iovec *, int);
+static void   bfile_flush  (int);
+static int    bfile_config (const char *, const char *);
+static void   bfile_reinit (void);
+static void   bfile_exit   (void);
+static int    bfile_reopen (void);
+static void   bfile_output (struct iovec *, int);
+static void   bfile_rotate (void);
+static long   bfile_now    (void);
+static int    bfile_number (const char *, const char *, unsigned long, unsigned long *);
+
+static const struct cc_log_code_st bfile_syncs[] = {
+	LOC_CODE_ENTRY("none",   BFILE_SYNC_NONE  ),
+	LOC_CODE_ENTRY("flush",  BFILE_SYNC_FLUSH ),
+	LOC_CODE_ENTRY("rotate", BFILE_SYNC_ROTATE),
+};
+
+/* Configuration */
+static const char   *filename_default = "/tmp/cc_log.log";
+static const char   *filename  = NULL;
+static int           filemode  = 0640;
+static size_t        bufsize   = 64 * 1024;
+static long          flushms   = 1000;		/* flush_interval           */
+static int           flushlvl  = LOG_ERR;	/* flush_level              */
+static unsigned long rotsize   = 0;		/* rotate_size, 0 : never   */
+static long          rotsecs   = 0;		/* rotate_interval          */
+static unsigned long rotkeep   = 5;		/* rotate_keep              */
+static int           syncmode  = BFILE_SYNC_NONE;
+
+/* State, under lock */
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static int             filedesc  = -1;
+static char           *buffer    = NULL;
+static size_t          buflen    = 0;		/* Size of buffer           */
+static size_t          used      = 0;
+static long            firstline = 0;		/* ms, oldest line buffered */
+static unsigned long   filesize  = 0;
+static long            opened    = 0;		/* ms, file creation        */
+static int             exithook  = 0;
+
+static void bfile_open(void)
+{
+	bfile_close();
+
+	if(NULL == filename)
+	{
+		cc_log_warning("bfile_open: No filename given ... assuming '%s'", filename_default);
+		filename = filename_default;
+	}
+	if(NULL == (buffer = (char *)cc_malloc(bufsize)))
+	{
+		cc_log_err("bfile_open: Cannot allocate a buffer of %lu bytes", (unsigned long)bufsize);
+		exit(1);
+	}
+	buflen = bufsize;
+	if(0 != bfile_reopen())
+	{
+		cc_log_err("bfile_open: Cannot open '%s' for write ... errno = %d (%s)", filename, errno, strerror(errno));
+		exit(1);
+	}
+	/* Lines are still buffered at exit */
+	if(!exithook)
+		exithook = (0 == atexit(bfile_exit));
+	return;
+}
+
+static void bfile_close(void)
+{
+	pthread_mutex_lock(&lock);
+	if(-1 != filedesc)
+	{
+		bfile_output(NULL, 0);
+		if(BFILE_SYNC_NONE != syncmode)
+			(void)fdatasync(filedesc);
+		close(filedesc);
+	}
+	filedesc = -1;
+	cc_free(buffer);
+	buffer = NULL;
+	buflen = 0;
+	used   = 0;
+	pthread_mutex_unlock(&lock);
+	return;
+}
+
+static void bfile_write(int level, const char *format, va_list ap)
+{
+	char   wbuffer[LOG_LINE];
+	size_t towrite;
+
+	pthread_mutex_lock(&lock);
+	if(-1 == filedesc)
+	{
+		/* Not opened yet, or closed : the line would be lost */
+		pthread_mutex_unlock(&lock);
+		towrite = cc_log_format_message(wbuffer, sizeof(wbuffer) - 1, level, format, ap);
+		wbuffer[towrite++] = '\n';
+		(void)CC_IO_WRITE(STDERR_FILENO, wbuffer, towrite);
+		return;
+	}
+	if(used + LOG_LINE > buflen)
+		bfile_output(NULL, 0);
+	if(0 == used)
+		firstline = bfile_now();
+	towrite = cc_log_format_message(buffer + used, LOG_LINE - 1, level, format, ap);
+	buffer[used + towrite++] = '\n';
+	used += towrite;
+	if(level <= flushlvl || bfile_now() - firstline >= flushms)
+		bfile_output(NULL, 0);
+	pthread_mutex_unlock(&lock);
+	return;
+}
+
+static int bfile_writev(struct iovec *iov, int iovcnt)
+{
+	size_t total;
+	int    i;
+
+	for(total = 0, i = 0; i < iovcnt; i += 1)
+		total += iov[i].iov_len;
+
+	pthread_mutex_lock(&lock);
+	if(-1 == filedesc)
+	{
+		pthread_mutex_unlock(&lock);
+		return -1;
+	}
+	if(used + total > buflen)
+		bfile_output(iov, iovcnt);
+	else
+	{
+		if(0 == used)
+			firstline = bfile_now();
+		for(i = 0; i < iovcnt; used += iov[i].iov_len, i += 1)
+			(void)memcpy(buffer + used, iov[i].iov_base, iov[i].iov_len);
+	}
+	pthread_mutex_unlock(&lock);
+	return 0;
+}
+
+/*
+ * Write the buffer if lines of level were written, or if it is due.
+ */
+static void bfile_flush(int level)
+{
+	pthread_mutex_lock(&lock);
+	if(-1 != filedesc && 0 != used && (level <= flushlvl || bfile_now() - firstline >= flushms))
+		bfile_output(NULL, 0);
+	pthread_mutex_unlock(&lock);
+	return;
+}
+
+static int bfile_config(const char *attribute, const char *value)
+{
+	unsigned long v;
+
+	if(0 == strcasecmp("file", attribute))
+	{
+		const char *ptr;
+		if(NULL == (ptr = (const char *)cc_strdup(value)))
+		{
+			cc_log_err("bfile_config: Cannot allocate memory for file = '%s'", value);
+			return -1;
+		}
+		if(filename != filename_default)
+			cc_free((void *)filename);
+		filename = ptr;
+		return 0;
+	}
+
+	if(0 == strcasecmp("mode", attribute))
+	{
+		if(0 != bfile_number(attribute, value, 0777, &v))
+			return -1;
+		filemode = (int)v;
+		return 0;
+	}
+
+	if(0 == strcasecmp("buffer_size", attribute))
+	{
+		if(0 != bfile_number(attribute, value, 1UL << 30, &v))
+			return -1;
+		bufsize = CC_MAX(v, LOG_LINE);
+		return 0;
+	}
+
+	if(0 == strcasecmp("flush_interval", attribute))
+	{
+		if(0 != bfile_number(attribute, value, LONG_MAX, &v))
+			return -1;
+		flushms = (long)v;
+		return 0;
+	}
+
+	if(0 == strcasecmp("flush_level", attribute))
+	{
+		int level;
+		if(0 > (level = cc_log_find_level(value)))
+		{
+			cc_log_err("bfile_config: Unknown flush_level '%s'", value);
+			return -1;
+		}
+		flushlvl = level;
+		return 0;
+	}
+
+	if(0 == strcasecmp("rotate_size", attribute))
+		return bfile_number(attribute, value, ULONG_MAX, &rotsize);
+
+	if(0 == strcasecmp("rotate_interval", attribute))
+	{
+		if(0 != bfile_number(attribute, value, LONG_MAX / 1000, &v))
+			return -1;
+		rotsecs = (long)v;
+		return 0;
+	}
+
+	if(0 == strcasecmp("rotate_keep", attribute))
+	{
+		if(0 != bfile_number(attribute, value, 999, &v) || 0 == v)
+		{
+			cc_log_err("bfile_config: bad rotate_keep %s (1 to 999)", value);
+			return -1;
+		}
+		rotkeep = v;
+		return 0;
+	}
+
+	if(0 == strcasecmp("datasync", attribute))
+	{
+		size_t i;
+		for(i = 0; i < CC_ARRAY_COUNT(bfile_syncs); i += 1)
+		{
+			if(0 == strcasecmp(bfile_syncs[i].c_name, value))
+			{
+				syncmode = bfile_syncs[i].c_val;
+				return 0;
+			}
+		}
+		cc_log_err("bfile_config: bad datasync value '%s'", value);
+		return -1;
+	}
+
+	cc_log_err("bfile_config: Unknown attribute '%s'", attribute);
+	return -1;
+}
+
+static void bfile_reinit(void)
+{
+	if(filename != filename_default)
+		cc_free((void *)filename);
+	filename = NULL;
+	filemode = 0640;
+	bufsize  = 64 * 1024;
+	flushms  = 1000;
+	flushlvl = LOG_ERR;
+	rotsize  = 0;
+	rotsecs  = 0;
+	rotkeep  = 5;
+	syncmode = BFILE_SYNC_NONE;
+	return;
+}
+
+/*
+ * The async writer, if any, hands its lines to the driver first.
+ */
+static void bfile_exit(void)
+{
+	cc_log_async_stop();
+	bfile_close();
+	return;
+}
+
+/*
+ * Open filename, the time of a rotation starts with its creation.
+ */
+static int bfile_reopen(void)
+{
+	struct stat st;
+	int         fd;
+
+	if(-1 == (fd = open(filename, O_APPEND | O_CREAT | O_WRONLY | O_CLOEXEC, filemode)))
+		return -1;
+	filedesc = fd;
+	filesize = (0 == fstat(fd, &st)) ? (unsigned long)st.st_size : 0;
+	opened   = bfile_now();
+	return 0;
+}
+
+/*
+ * Write the buffer then the iovcnt lines of iov by one writev, and
+ * rotate the file if it is time. Called under lock.
+ */
+static void bfile_output(struct iovec *iov, int iovcnt)
+{
+	struct iovec vec[BFILE_BATCH + 1];
+	ssize_t      written;
+	int          n;
+
+	for(n = 0; 0 != used || iovcnt > 0; n = 0)
+	{
+		if(0 != used)
+		{
+			vec[n].iov_base   = buffer;
+			vec[n++].iov_len  = used;
+		}
+		for(; iovcnt > 0 && n <= BFILE_BATCH; iov += 1, iovcnt -= 1)
+			vec[n++] = *iov;
+		if(0 < (written = cc_io_writev(filedesc, vec, n)))
+			filesize += (unsigned long)written;
+		used = 0;
+	}
+	if(BFILE_SYNC_FLUSH == syncmode)
+		(void)fdatasync(filedesc);
+	if((0 != rotsize && filesize >= rotsize) || (0 != rotsecs && bfile_now() - opened >= rotsecs * 1000))
+		bfile_rotate();
+	return;
+}
+
+/*
+ * file.N-1 -> file.N ... file -> file.1, then a new file. Called under
+ * lock, with the buffer written.
+ */
+static void bfile_rotate(void)
+{
+	char          from[PATH_MAX];
+	char          to[PATH_MAX];
+	unsigned long i;
+	int           oldfd;
+
+	if(BFILE_SYNC_NONE != syncmode)
+		(void)fdatasync(filedesc);
+	for(i = rotkeep; i > 1; i -= 1)
+	{
+		(void)snprintf(from, sizeof(from), "%s.%lu", filename, i - 1);
+		(void)snprintf(to,   sizeof(to),   "%s.%lu", filename, i);
+		(void)rename(from, to);
+	}
+	(void)snprintf(to, sizeof(to), "%s.1", filename);
+	if(0 != rename(filename, to))
+	{
+		/* Retried at the next write */
+		opened = bfile_now();
+		return;
+	}
+	oldfd = filedesc;
+	if(0 == bfile_reopen())
+		(void)close(oldfd);
+	else
+		opened = bfile_now();
+	return;
+}
+
+static long bfile_now(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(BFILE_CLOCK, &ts);
+	return (long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/*
+ * A number, with a K, M or G suffix (powers of 1024).
+ */
+static int bfile_number(const char *attribute, const char *value, unsigned long max, unsigned long *result)
+{
+	char          *r;
+	unsigned long  v;
+	unsigned long  scale;
+
+	errno = 0;
+	v     = strtoul(value, &r, 0);
+	switch(*r)
+	{
+	case 'k': case 'K': scale = 1UL << 10; r += 1; break;
+	case 'm': case 'M': scale = 1UL << 20; r += 1; break;
+	case 'g': case 'G': scale = 1UL << 30; r += 1; break;
+	default:            scale = 1;                 break;
+	}
+	if(r == value || '\0' != *r || '-' == *value || 0 != errno || v > max / scale)
+	{
+		cc_log_err("bfile_config: bad %s value '%s'", attribute, value);
+		return -1;
+	}
+	*result = v * scale;
+	return 0;
+}
+
+static struct cc_log_driver_st slogdrv = {
+	.ld_next    = NULL,
+	.ld_name    = "bfile",
+	.ld_open    = bfile_open,
+	.ld_close   = bfile_close,
+	.ld_write   = bfile_write,
+	.ld_config  = bfile_config,
+	.ld_reinit  = bfile_reinit,
+	.ld_writev  = bfile_writev,
+	.ld_flush   = bfile_flush
+};
+
+static __attribute__((constructor)) void drv_ctor(void)
+{
+	cc_log_register_driver(&slogdrv);
+	return;
+}
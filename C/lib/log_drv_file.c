@@ -34,6 +34,7 @@ static void file_open(void);
 static void file_close(void);
 static void file_write(int , const char *, va_list);
 static int  file_config(const char *, const char *);
+static int  file_writev(struct iovec *, int);
 
 static const char *filename_default = "/tmp/cc_log.log";
 static const char *filename = NULL;
@@ -67,22 +68,19 @@ static void file_close(void)
 
 static void file_write(int level, const char *format, va_list ap)
 {
-	char   wbuffer[128];
+	char   wbuffer[LOG_LINE];
 	size_t towrite;
-	towrite = cc_log_format_message(wbuffer, sizeof(wbuffer), level, format, ap);
-	if(towrite < sizeof(wbuffer))
-	{
-		wbuffer[towrite++] = '\n';
-		(void)CC_IO_WRITE(filedesc, wbuffer, towrite);
-	}
-	else
-	{
-		(void)CC_IO_WRITE(filedesc, wbuffer, towrite);
-		(void)CC_IO_WRITE(filedesc, "\n", 1);
-	}
+	towrite = cc_log_format_message(wbuffer, sizeof(wbuffer) - 1, level, format, ap);
+	wbuffer[towrite++] = '\n';
+	(void)CC_IO_WRITE(filedesc, wbuffer, towrite);
 	return;
 }
 
+static int file_writev(struct iovec *iov, int iovcnt)
+{
+	return -1 == cc_io_writev(filedesc, iov, iovcnt) ? -1 : 0;
+}
+
 static int file_config(const char *attribute, const char *value)
 {
 	if(0 == strcasecmp("file", attribute))
@@ -133,7 +131,8 @@ static struct cc_log_driver_st slogdrv = {
 	.ld_close   = file_close,
 	.ld_write   = file_write,
 	.ld_config  = file_config,
-	.ld_reinit  = file_reinit
+	.ld_reinit  = file_reinit,
+	.ld_writev  = file_writev
 };
 
 static __attribute__((constructor)) void drv_ctor(void)
@@ -31,37 +31,9 @@ static void syslog_close(void);
 static void syslog_write(int , const char *, va_list);
 static int  syslog_config(const char *, const char *);
 
-static struct cc_log_code_st syslog_facilities[] = {
-	LOC_CODE_ENTRY("AUTH",     LOG_AUTH    ),
-	LOC_CODE_ENTRY("AUTHPRIV", LOG_AUTHPRIV),
-	LOC_CODE_ENTRY("CRON",     LOG_CRON    ),
-	LOC_CODE_ENTRY("DAEMON",   LOG_DAEMON  ),
-	LOC_CODE_ENTRY("FTP",      LOG_FTP     ),
-	LOC_CODE_ENTRY("KERN",     LOG_KERN    ),
-	LOC_CODE_ENTRY("LPR",      LOG_LPR     ),
-	LOC_CODE_ENTRY("MAIL",     LOG_MAIL    ),
-	LOC_CODE_ENTRY("NEWS",     LOG_NEWS    ),
-	LOC_CODE_ENTRY("SYSLOG",   LOG_SYSLOG  ),
-	LOC_CODE_ENTRY("USER",     LOG_USER    ),
-	LOC_CODE_ENTRY("UUCP",     LOG_UUCP    ),
-	LOC_CODE_ENTRY("LOCAL0",   LOG_LOCAL0  ),
-	LOC_CODE_ENTRY("LOCAL1",   LOG_LOCAL1  ),
-	LOC_CODE_ENTRY("LOCAL2",   LOG_LOCAL2  ),
-	LOC_CODE_ENTRY("LOCAL3",   LOG_LOCAL3  ),
-	LOC_CODE_ENTRY("LOCAL4",   LOG_LOCAL4  ),
-	LOC_CODE_ENTRY("LOCAL5",   LOG_LOCAL5  ),
-	LOC_CODE_ENTRY("LOCAL6",   LOG_LOCAL6  ),
-	LOC_CODE_ENTRY("LOCAL7",   LOG_LOCAL7  ),
-};
-
-static struct cc_log_code_st syslog_options[] = {
-        LOC_CODE_ENTRY("CONS",     LOG_CONS    ),
-        LOC_CODE_ENTRY("NDELAY",   LOG_NDELAY  ),
-        LOC_CODE_ENTRY("NOWAIT",   LOG_NOWAIT  ),
-        LOC_CODE_ENTRY("ODELAY",   LOG_ODELAY  ),
-        LOC_CODE_ENTRY("PERROR",   LOG_PERROR  ),
-        LOC_CODE_ENTRY("PID",      LOG_PID     ),
-};
+/* syslog_facilities and syslog_options, generated from log_syslog_*.mph */
+#include "log_syslog_facilities.h"
+#include "log_syslog_options.h"
 
 static const char    default_identity[] = default_ide;
 static const char   *slog_identity    = default_identity;
@@ -18,7 +18,12 @@
 #ifndef __CC_LOG_INTERNAL_H__
 #define __CC_LOG_INTERNAL_H__
 
+#include <sys/uio.h>
+#include <stdint.h>
+#include <time.h>
+
 #include <CCA/log.h>
+#include <CCA/mph.h>
 
 struct cc_log_code_st {
 	const char *c_name;
@@ -39,15 +44,82 @@ struct cc_log_driver_st {
 	void                    (*ld_write )(int, const char *, va_list);
 	int                     (*ld_config)(const char *, const char *);
 	void                    (*ld_reinit)(void);
+	int                     (*ld_writev)(struct iovec *, int);	/* Formatted lines, NULL if unsupported */
+	void                    (*ld_flush )(int);			/* Lines of level written, NULL if unbuffered */
 };
 
+#define LOG_LINE	1024		/* Longest line of the drivers, newline included */
+
+/* Clock of the time stamps, coarse where available */
+#ifdef CLOCK_REALTIME_COARSE
+# define LOG_CLOCK	CLOCK_REALTIME_COARSE
+#else
+# define LOG_CLOCK	CLOCK_REALTIME
+#endif
+
 extern size_t cc_log_format_message(char *, size_t, int, const char *, va_list);
+extern size_t cc_log_format_line   (char *, size_t, int, const char *, ...);
+extern size_t cc_log_format_prefix (char *, size_t, int, const struct timespec *);
 extern void   cc_log_register_driver(struct cc_log_driver_st *);
+extern int    cc_log_find_level    (const char *);
 
-extern const struct cc_log_code_st *cc_log_search_name(const char *, const struct cc_log_code_st *, size_t);
+extern const struct cc_log_code_st *cc_log_search_name(const char *, const struct cc_log_code_st *, const cc_mph_t *);
 extern const struct cc_log_code_st *cc_log_search_code(int,          const struct cc_log_code_st *, size_t);
 
-#define cc_log_find_name(name, table) cc_log_search_name(name, table, CC_ARRAY_COUNT(table))
+/* log_async.c */
+extern int           cc_log_async_config (const char *, const char *);
+extern void          cc_log_async_reinit (void);
+extern void          cc_log_async_start  (struct cc_log_driver_st *);
+extern void          cc_log_async_stop   (void);
+extern int           cc_log_async_write  (int, const char *, va_list);
+
+/*
+ * Binary records (log_binary.c).
+ *
+ * An event holds the address of its format and the raw values of its
+ * arguments, in the order of the conversions of the format : 8 bytes
+ * for integers, pointers and doubles, 16 for long doubles, and for
+ * strings a 32 bits length (LOG_BIN_NULL for NULL) followed by the
+ * bytes, padded to 8. A format record gives the text of the format of
+ * address lb_format, before the first event using it. A binary log file
+ * is a sequence of a cc_log_bin_head_st and records, and a new head
+ * starts again when the file is reopened : addresses are only valid up
+ * to the next head.
+ */
+#define LOG_BIN_MAGIC	"CCLOGBIN"
+#define LOG_BIN_ORDER	0x01020304
+#define LOG_BIN_VERSION	1
+#define LOG_BIN_EVENT	1
+#define LOG_BIN_FORMAT	2
+#define LOG_BIN_NULL	0xFFFFFFFFU
+#define LOG_BIN_TRUNC	0x0001		/* Arguments missing, no room       */
+
+struct cc_log_bin_head_st {
+	char     lh_magic[8];
+	uint32_t lh_order;
+	uint32_t lh_version;
+};
+
+struct cc_log_bin_st {
+	uint32_t lb_size;		/* Bytes of the record, multiple of 8 */
+	uint16_t lb_type;
+	int16_t  lb_level;
+	int32_t  lb_errno;		/* For %m                           */
+	uint16_t lb_flags;
+	uint16_t lb_pad;
+	uint64_t lb_format;
+	int64_t  lb_sec;
+	int64_t  lb_nsec;
+	unsigned char lb_args[];
+};
+
+#define LOG_BIN_ROUND(n) (((n) + 7) & ~(size_t)7)
+
+extern size_t cc_log_bin_capture(void *, size_t, int, const char *, va_list);
+extern size_t cc_log_bin_render (char *, size_t, const struct cc_log_bin_st *, const char *);
+
+/* Name tables are generated by cc_mph_emit, table##_mph indexes them */
+#define cc_log_find_name(name, table) cc_log_search_name(name, table, &table##_mph)
 #define cc_log_find_code(code, table) cc_log_search_code(code, table, CC_ARRAY_COUNT(table))
 
 #define default_tfm  "%d/%m/%Y %H:%M:%S";
@@ -0,0 +1,22 @@
+/*
+ * Generated by cc_mph_emit (CC_MPH_ICASE), do not edit : the indexes
+ * depend on cc_hash64, so regenerate when it changes.
+ */
+static const uint32_t log_priorities_disp[] = {
+	2, 0, 0, 3,
+};
+
+static const cc_mph_t log_priorities_mph = {
+	0x1715609F7C746C69ULL, 8, 2, 7, 0x0001, log_priorities_disp
+};
+
+static const struct cc_log_code_st log_priorities[] = {
+	LOC_CODE_ENTRY("ALERT",    LOG_ALERT   ),
+	LOC_CODE_ENTRY("EMERG",    LOG_EMERG   ),
+	LOC_CODE_ENTRY("DEBUG",    LOG_DEBUG   ),
+	LOC_CODE_ENTRY("CRIT",     LOG_CRIT    ),
+	LOC_CODE_ENTRY("WARNING",  LOG_WARNING ),
+	LOC_CODE_ENTRY("INFO",     LOG_INFO    ),
+	LOC_CODE_ENTRY("ERR",      LOG_ERR     ),
+	LOC_CODE_ENTRY("NOTICE",   LOG_NOTICE  ),
+};
@@ -0,0 +1,35 @@
+/*
+ * Generated by cc_mph_emit (CC_MPH_ICASE), do not edit : the indexes
+ * depend on cc_hash64, so regenerate when it changes.
+ */
+static const uint32_t syslog_facilities_disp[] = {
+	3, 0, 1, 6, 3, 1, 0, 10,
+	6, 12,
+};
+
+static const cc_mph_t syslog_facilities_mph = {
+	0x9E3779B97F4A7C15ULL, 20, 5, 8, 0x0001, syslog_facilities_disp
+};
+
+static const struct cc_log_code_st syslog_facilities[] = {
+	LOC_CODE_ENTRY("LOCAL0",   LOG_LOCAL0  ),
+	LOC_CODE_ENTRY("LOCAL6",   LOG_LOCAL6  ),
+	LOC_CODE_ENTRY("USER",     LOG_USER    ),
+	LOC_CODE_ENTRY("FTP",      LOG_FTP     ),
+	LOC_CODE_ENTRY("LOCAL7",   LOG_LOCAL7  ),
+	LOC_CODE_ENTRY("NEWS",     LOG_NEWS    ),
+	LOC_CODE_ENTRY("AUTHPRIV", LOG_AUTHPRIV),
+	LOC_CODE_ENTRY("SYSLOG",   LOG_SYSLOG  ),
+	LOC_CODE_ENTRY("LOCAL2",   LOG_LOCAL2  ),
+	LOC_CODE_ENTRY("LPR",      LOG_LPR     ),
+	LOC_CODE_ENTRY("LOCAL3",   LOG_LOCAL3  ),
+	LOC_CODE_ENTRY("LOCAL4",   LOG_LOCAL4  ),
+	LOC_CODE_ENTRY("LOCAL5",   LOG_LOCAL5  ),
+	LOC_CODE_ENTRY("AUTH",     LOG_AUTH    ),
+	LOC_CODE_ENTRY("CRON",     LOG_CRON    ),
+	LOC_CODE_ENTRY("KERN",     LOG_KERN    ),
+	LOC_CODE_ENTRY("MAIL",     LOG_MAIL    ),
+	LOC_CODE_ENTRY("DAEMON",   LOG_DAEMON  ),
+	LOC_CODE_ENTRY("LOCAL1",   LOG_LOCAL1  ),
+	LOC_CODE_ENTRY("UUCP",     LOG_UUCP    ),
+};
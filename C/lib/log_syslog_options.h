@@ -0,0 +1,20 @@
+/*
+ * Generated by cc_mph_emit (CC_MPH_ICASE), do not edit : the indexes
+ * depend on cc_hash64, so regenerate when it changes.
+ */
+static const uint32_t syslog_options_disp[] = {
+	1, 0, 0, 1,
+};
+
+static const cc_mph_t syslog_options_mph = {
+	0x0000000000000000ULL, 6, 2, 6, 0x0001, syslog_options_disp
+};
+
+static const struct cc_log_code_st syslog_options[] = {
+	LOC_CODE_ENTRY("PID",      LOG_PID     ),
+	LOC_CODE_ENTRY("ODELAY",   LOG_ODELAY  ),
+	LOC_CODE_ENTRY("NDELAY",   LOG_NDELAY  ),
+	LOC_CODE_ENTRY("CONS",     LOG_CONS    ),
+	LOC_CODE_ENTRY("PERROR",   LOG_PERROR  ),
+	LOC_CODE_ENTRY("NOWAIT",   LOG_NOWAIT  ),
+};
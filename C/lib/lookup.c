@@ -18,13 +18,19 @@
 #include <sys/types.h>
 #include <stdint.h>
 #include <pthread.h>
+#include <string.h>
+#include <unistd.h>
 
+#include <CCA/hash.h>
 #include <CCA/memory.h>
+#include <CCA/pool.h>
 #include <CCA/util.h>
 
 #define __CC_LOOKUP_INTERNAL__
 #include <CCA/lookup.h>
 
+#include "lookup_internal.h"
+
 /* Local datatypes definition */
 struct lookup_entry_st {
 	struct lookup_entry_st *le_prev;
@@ -34,56 +40,202 @@ struct lookup_entry_st {
 	const  void            *le_data;
 };
 
+struct lookup_array_st {
+	size_t                  la_len;
+	struct lookup_array_st *la_next;	/* Retired arrays                   */
+	struct lookup_entry_st *la_ent[1];
+};
+
+/* Objects unlinked during an epoch, see lookup_internal.h */
+struct lookup_limbo_st {
+	uint64_t                lm_epoch;
+	struct lookup_entry_st *lm_ent;		/* Linked by le_prev                */
+	struct lookup_entry_st *lm_del;		/* Deleted ones, data to destroy    */
+	struct lookup_array_st *lm_arr;		/* Linked by la_next                */
+};
+
+/*
+ * A shard is an independent hash table holding the keys whose hash
+ * selects it, with its own lock.
+ *
+ * While the shard is resized, the entries are moved a few buckets at a
+ * time from ls_old to ls_cur : the buckets of ls_old below ls_move are
+ * already moved.
+ *
+ * With CC_LOOKUP_LOCK_RCU, searches read ls_cur, ls_old, ls_move and
+ * the chains without lock, so the writers publish them with release
+ * stores, copy the entries they move instead of relinking them, and
+ * put the entries and arrays they unlink in limbo until no search can
+ * reach them.
+ *
+ * Shards are padded so that the locks of two shards never share a
+ * cache line.
+ */
+struct lookup_shard_st {
+	struct lookup_array_st  *ls_cur;
+	struct lookup_array_st  *ls_old;	/* Table being emptied or NULL      */
+	size_t                   ls_move;	/* Next bucket of ls_old to move    */
+	char                     ls_pad0[64];
+	union {
+		pthread_mutex_t  mutex;
+		pthread_rwlock_t rwlock;
+	}                        ls_lock;
+	size_t                   ls_count;	/* Number of entries                */
+	size_t                   ls_min;	/* Size never shrunk under          */
+	size_t                   ls_retired;	/* Objects put in limbo             */
+	struct lookup_limbo_st   ls_limbo[3];
+	char                     ls_pad1[64];
+};
+
 struct lookup_table_st {
-	cc_lookup_comp_t        lt_comp;
-	cc_lookup_hash_t        lt_hash;
-	cc_lookup_free_t        lt_free;
-	pthread_mutex_t         lt_mutex;
-	size_t                  lt_len;
-	struct lookup_entry_st *lt_ent[1];
+	cc_lookup_comp_t         lt_comp;
+	cc_lookup_hash_t         lt_hash;
+	cc_lookup_free_t         lt_free;
+	pthread_mutex_t          lt_mutex;
+	cc_lookup_locking_t      lt_locking;
+	int                      lt_shrink;	/* Shrink when sparse               */
+	unsigned                 lt_shift;	/* Hash shift selecting the shard   */
+	size_t                   lt_nshard;
+	struct lookup_shard_st  *lt_shard;
+	size_t                   lt_cursors;	/* Open cursors : no resizing       */
 };
 
+/*
+ * A cursor walks the shards one after the other, the buckets of the old
+ * array not moved yet then the ones of the current array, and copies
+ * whole buckets at a time into lc_pairs. While a cursor is open, the
+ * shards are neither resized nor rehashed, so that the buckets keep
+ * their entries.
+ */
+struct lookup_cursor_st {
+	CC_LOOKUP                lc_table;
+	size_t                   lc_shard;
+	int                      lc_phase;	/* 0 : old array, 1 : current one   */
+	size_t                   lc_bucket;
+	size_t                   lc_next;	/* Next pair of lc_pairs to return  */
+	size_t                   lc_count;	/* Pairs in lc_pairs                */
+	size_t                   lc_size;	/* Capacity of lc_pairs             */
+	cc_lookup_pair_t        *lc_pairs;
+};
+
+/* Overlays a free table, keeping its initialized mutex */
 struct lookup_freelst_st {
 	struct lookup_freelst_st *fl_prev;
 	struct lookup_freelst_st *fl_next;
 	void                     *fl_spare;
 	pthread_mutex_t           fl_mutex;
-	size_t                    fl_len;
 };
 
-#define LOOKUP_TABLE_HEAD_SZ (size_t)(((struct lookup_table_st *)0)->lt_ent)
+#define LOOKUP_ARRAY_HEAD_SZ    (size_t)(((struct lookup_array_st *)0)->la_ent)
+
+/*
+ * Free arrays are kept by size class : an array of class c holds up to
+ * 2^c buckets. At most LOOKUP_ARRAY_KEEP arrays are kept by class.
+ */
+#define LOOKUP_ARRAY_CLASSES	24
+#define LOOKUP_ARRAY_KEEP	4
+
+/*
+ * Buckets moved by each add or del while a shard is resized, and
+ * number of empty buckets that may be crossed for each of them.
+ */
+#define LOOKUP_REHASH_STEP	4
+#define LOOKUP_REHASH_EMPTY	10
+
+/* Shards of a concurrent table by online CPU when none is requested */
+#define LOOKUP_SHARDS_PER_CPU	4
+#define LOOKUP_SHARDS_MAX	4096
+
+/* Objects put in limbo between two attempts to advance the epoch */
+#define LOOKUP_EPOCH_RETIRES	64
+
+/* Pairs copied by a cursor at a time, keys hashed ahead by a bulk add */
+#define LOOKUP_CURSOR_BATCH	64
+#define LOOKUP_BULK_AHEAD	16
+
+#define LOOKUP_LOAD(p)		__atomic_load_n(&(p), __ATOMIC_ACQUIRE)
+#define LOOKUP_PUBLISH(p, v)	__atomic_store_n(&(p), (v), __ATOMIC_RELEASE)
 
 /* Global functions */
-extern CC_LOOKUP           cc_lookup_create (size_t, cc_lookup_comp_t, cc_lookup_hash_t, cc_lookup_free_t);
-extern void                cc_lookup_destroy(CC_LOOKUP);
-extern cc_lookup_status_t  cc_lookup_add    (CC_LOOKUP, const void *, void  *);
-extern cc_lookup_status_t  cc_lookup_del    (CC_LOOKUP, const void *, void **);
-extern cc_lookup_status_t  cc_lookup_search (CC_LOOKUP, const void *, void **);
-extern void                cc_lookup_lock   (CC_LOOKUP);
-extern void                cc_lookup_unlock (CC_LOOKUP);
+extern CC_LOOKUP           cc_lookup_create    (size_t, cc_lookup_comp_t, cc_lookup_hash_t, cc_lookup_free_t);
+extern CC_LOOKUP           cc_lookup_create_concurrent(size_t, size_t, cc_lookup_locking_t, cc_lookup_comp_t, cc_lookup_hash_t, cc_lookup_free_t);
+extern void                cc_lookup_destroy   (CC_LOOKUP);
+extern cc_lookup_status_t  cc_lookup_add       (CC_LOOKUP, const void *, void  *);
+extern cc_lookup_status_t  cc_lookup_del       (CC_LOOKUP, const void *, void **);
+extern cc_lookup_status_t  cc_lookup_search    (CC_LOOKUP, const void *, void **);
+extern cc_lookup_status_t  cc_lookup_reserve   (CC_LOOKUP, size_t);
+extern void                cc_lookup_autoshrink(CC_LOOKUP, int);
+extern size_t              cc_lookup_count     (CC_LOOKUP);
+extern void                cc_lookup_lock      (CC_LOOKUP);
+extern void                cc_lookup_unlock    (CC_LOOKUP);
+extern cc_lookup_status_t  cc_lookup_bulk_add  (CC_LOOKUP, const void **, void **, size_t);
+extern CC_LOOKUP_CURSOR    cc_lookup_cursor_open (CC_LOOKUP);
+extern cc_lookup_status_t  cc_lookup_cursor_next (CC_LOOKUP_CURSOR, const void **, void **);
+extern void                cc_lookup_cursor_close(CC_LOOKUP_CURSOR);
+extern cc_lookup_status_t  cc_lookup_snapshot    (CC_LOOKUP, cc_lookup_pair_t **, size_t *);
 
 /* Local defined functions */
-static struct lookup_entry_st *entry_alloc(void);
-static struct lookup_entry_st *entry_find(CC_LOOKUP, const void *, uint64_t *, size_t *, struct lookup_entry_st ***);
-static void                    entry_free(struct lookup_entry_st *);
-static struct lookup_table_st *table_alloc(size_t);
-static void                    table_free(struct lookup_table_st *);
+static cc_lookup_status_t       table_insert(CC_LOOKUP, const void *, void *, uint64_t);
+static int                      table_frozen(CC_LOOKUP);
+static int                      cursor_fill(struct lookup_cursor_st *);
+static struct lookup_entry_st  *entry_alloc(void);
+static void                     entry_init(void);
+static struct lookup_entry_st  *entry_find(CC_LOOKUP, struct lookup_shard_st *, const void *, uint64_t, struct lookup_entry_st ***);
+static struct lookup_entry_st  *entry_find_rcu(CC_LOOKUP, struct lookup_shard_st *, const void *, uint64_t);
+static void                     entry_free(struct lookup_entry_st *);
+static void                     entry_retire(CC_LOOKUP, struct lookup_shard_st *, struct lookup_entry_st *, int);
+static struct lookup_array_st  *array_alloc(size_t);
+static void                     array_free(struct lookup_array_st *);
+static unsigned                 array_class(size_t);
+static void                     array_retire(CC_LOOKUP, struct lookup_shard_st *, struct lookup_array_st *);
+static struct lookup_shard_st  *shard_get(CC_LOOKUP, uint64_t);
+static void                     shard_rdlock(CC_LOOKUP, struct lookup_shard_st *);
+static void                     shard_wrlock(CC_LOOKUP, struct lookup_shard_st *);
+static void                     shard_unlock(CC_LOOKUP, struct lookup_shard_st *);
+static struct lookup_entry_st **shard_bucket(struct lookup_shard_st *, uint64_t);
+static int                      shard_resize(struct lookup_shard_st *, size_t);
+static void                     shard_rehash(CC_LOOKUP, struct lookup_shard_st *, size_t);
+static int                      shard_rehash_bucket(CC_LOOKUP, struct lookup_shard_st *);
+static cc_lookup_status_t       shard_reserve(CC_LOOKUP, struct lookup_shard_st *, size_t);
+static struct lookup_limbo_st  *shard_limbo(CC_LOOKUP, struct lookup_shard_st *);
+static void                     shard_limbo_free(CC_LOOKUP, struct lookup_limbo_st *);
+static void                     shard_destroy(CC_LOOKUP, struct lookup_shard_st *);
+static void                     shard_destroy_chains(CC_LOOKUP, struct lookup_entry_st **, size_t);
+static struct lookup_table_st  *table_alloc(size_t, size_t, cc_lookup_locking_t);
+static void                     table_free(struct lookup_table_st *);
 
 /* LOcal data */
-static pthread_mutex_t           mut_freelist[1] = { PTHREAD_MUTEX_INITIALIZER };
-static struct lookup_entry_st   *ent_freelist = NULL;
-static struct lookup_freelst_st *tbl_freelist = NULL;
+static pthread_mutex_t            mut_freelist[1] = { PTHREAD_MUTEX_INITIALIZER };
+static struct lookup_freelst_st  *tbl_freelist = NULL;
+static struct lookup_array_st    *arr_freelist[LOOKUP_ARRAY_CLASSES];
+static size_t                     arr_freecount[LOOKUP_ARRAY_CLASSES];
+static pthread_once_t             ent_once = PTHREAD_ONCE_INIT;
+static CC_POOL                    ent_pool = NULL;
 
 
 
 CC_LOOKUP cc_lookup_create(size_t size, cc_lookup_comp_t fn_comp, cc_lookup_hash_t fn_hash, cc_lookup_free_t fn_free)
+{
+	return cc_lookup_create_concurrent(size, 1, CC_LOOKUP_LOCK_NONE, fn_comp, fn_hash, fn_free);
+}
+
+CC_LOOKUP cc_lookup_create_concurrent(size_t size, size_t nshard, cc_lookup_locking_t locking, cc_lookup_comp_t fn_comp, cc_lookup_hash_t fn_hash, cc_lookup_free_t fn_free)
 {
 	CC_LOOKUP new_lktabl = NULL;
+	size_t    pow2;
+	long      ncpu;
 
-	if(NULL != (new_lktabl = table_alloc(size)))
+	if(CC_LOOKUP_LOCK_NONE == locking)
+		nshard = 1;
+	else if(0 == nshard)
+		nshard = (ncpu = sysconf(_SC_NPROCESSORS_ONLN)) > 0 ? (size_t)ncpu * LOOKUP_SHARDS_PER_CPU : 1;
+	for(pow2 = 1; pow2 < nshard && pow2 < LOOKUP_SHARDS_MAX; pow2 <<= 1);
+	pthread_once(&ent_once, entry_init);
+
+	if(NULL != (new_lktabl = table_alloc(CC_MAX(size / pow2, 1), pow2, locking)))
 	{
-		new_lktabl->lt_comp = fn_comp;
-		new_lktabl->lt_hash = fn_hash;
+		new_lktabl->lt_comp = fn_comp ? fn_comp : (cc_lookup_comp_t)strcmp;
+		new_lktabl->lt_hash = fn_hash ? fn_hash : cc_hash64_key;
 		new_lktabl->lt_free = fn_free;
 	}
 	return new_lktabl;
@@ -91,32 +243,11 @@ CC_LOOKUP cc_lookup_create(size_t size, cc_lookup_comp_t fn_comp, cc_lookup_hash
 
 void cc_lookup_destroy(CC_LOOKUP table)
 {
-	struct lookup_entry_st **pt;
-	struct lookup_entry_st  *pe;
-	struct lookup_entry_st  *po;
-	struct lookup_entry_st  *ph;
-	size_t                   ix;
+	size_t ix;
 
 	cc_lookup_lock(table);
-	for(ix = 0, pt = table->lt_ent; ix < table->lt_len; ix += 1)
-	{
-		if(table->lt_free)
-		{
-			if((ph = *(pt++)))
-			{
-				for(pe = ph;pe; po = pe, pe = pe->le_next)
-				{
-					po = pe;
-					table->lt_free(pe->le_data);
-				}
-				pthread_mutex_lock(mut_freelist);
-				po->le_next  = ent_freelist;
-				ent_freelist = ph;
-				pthread_mutex_unlock(mut_freelist);
-			}
-		}
-		
-	}
+	for(ix = 0; ix < table->lt_nshard; ix += 1)
+		shard_destroy(table, table->lt_shard + ix);
 	table_free(table);
 	cc_lookup_unlock(table);
 	return;
@@ -135,85 +266,417 @@ void cc_lookup_unlock(CC_LOOKUP table)
 }
 
 cc_lookup_status_t cc_lookup_add(CC_LOOKUP table, const void *key, void  *data)
+{
+	return table_insert(table, key, data, table->lt_hash(key));
+}
+
+/*
+ * Bulk load : the table is presized, and the keys are hashed
+ * LOOKUP_BULK_AHEAD ahead of their insertion. The head of their bucket
+ * is prefetched meanwhile when the table is not shared : otherwise its
+ * array could be released by another writer before the prefetch.
+ */
+cc_lookup_status_t cc_lookup_bulk_add(CC_LOOKUP table, const void **keys, void **data, size_t count)
+{
+	struct lookup_shard_st *shard;
+	struct lookup_array_st *array;
+	uint64_t                hval[LOOKUP_BULK_AHEAD];
+	cc_lookup_status_t      ret = CC_LOOKUP_OK;
+	cc_lookup_status_t      sts;
+	size_t                  ix;
+	size_t                  nx;
+
+	/* Failing to presize only makes the table grow on the way */
+	(void)cc_lookup_reserve(table, cc_lookup_count(table) + count);
+
+	for(ix = 0; ix < count + LOOKUP_BULK_AHEAD; ix += 1)
+	{
+		if(ix >= LOOKUP_BULK_AHEAD)
+		{
+			nx = ix - LOOKUP_BULK_AHEAD;
+			sts = table_insert(table, keys[nx], data[nx], hval[nx % LOOKUP_BULK_AHEAD]);
+			if(CC_LOOKUP_SYSERR == sts)
+				return CC_LOOKUP_SYSERR;
+			if(CC_LOOKUP_DUPKEY == sts)
+				ret = CC_LOOKUP_DUPKEY;
+		}
+		if(ix < count)
+		{
+			hval[ix % LOOKUP_BULK_AHEAD] = table->lt_hash(keys[ix]);
+			if(CC_LOOKUP_LOCK_NONE == table->lt_locking)
+			{
+				shard = shard_get(table, hval[ix % LOOKUP_BULK_AHEAD]);
+				array = shard->ls_cur;
+				__builtin_prefetch(array->la_ent + hval[ix % LOOKUP_BULK_AHEAD] % array->la_len);
+			}
+		}
+	}
+	return ret;
+}
+
+static cc_lookup_status_t table_insert(CC_LOOKUP table, const void *key, void *data, uint64_t hval)
 {
 	struct lookup_entry_st **head;
 	struct lookup_entry_st  *pent;
-	uint64_t                 hval;
+	struct lookup_shard_st  *shard;
+	cc_lookup_status_t       ret  = CC_LOOKUP_OK;
 
-	if(NULL != (pent = entry_find(table, key, &hval, NULL, &head)))
-		return CC_LOOKUP_DUPKEY;
-	if(NULL == (pent = entry_alloc()))
-		return CC_LOOKUP_SYSERR;
-	pent->le_kval =  hval;
-	pent->le_key  =  key;
-	pent->le_data =  data;
-	pent->le_prev = NULL;
-	pent->le_next = *head;
-	if(*head)
-		(*head)->le_prev = pent;
-	*head = pent;
-	return CC_LOOKUP_OK;
+	shard = shard_get(table, hval);
+	shard_wrlock(table, shard);
+	if(shard->ls_old && !table_frozen(table))
+		shard_rehash(table, shard, LOOKUP_REHASH_STEP);
+
+	if(NULL != (pent = entry_find(table, shard, key, hval, &head)))
+		ret = CC_LOOKUP_DUPKEY;
+	else if(NULL == (pent = entry_alloc()))
+		ret = CC_LOOKUP_SYSERR;
+	else
+	{
+		pent->le_kval =  hval;
+		pent->le_key  =  key;
+		pent->le_data =  data;
+		pent->le_prev = NULL;
+		pent->le_next = *head;
+		if(*head)
+			(*head)->le_prev = pent;
+		LOOKUP_PUBLISH(*head, pent);
+
+		/* Failing to grow only makes the chains longer */
+		if(++shard->ls_count > shard->ls_cur->la_len && NULL == shard->ls_old && !table_frozen(table))
+			(void)shard_resize(shard, 2 * shard->ls_cur->la_len + 1);
+	}
+	shard_unlock(table, shard);
+	return ret;
 }
 
 cc_lookup_status_t cc_lookup_del(CC_LOOKUP table, const void *key, void **deleted)
 {
 	struct lookup_entry_st **head;
 	struct lookup_entry_st  *pent;
-	uint64_t                 hval;
-	
-	if(NULL == (pent = entry_find(table, key, &hval, NULL, &head)))
-		return CC_LOOKUP_NOENT;
-
-	if(pent->le_prev)  pent->le_prev->le_next = pent->le_next;
-	else              *head = pent->le_next;
-	if(pent->le_next)  pent->le_next->le_prev = pent->le_prev;
-	if(*deleted) *deleted = (void *)pent->le_data;
-	if(table->lt_free) table->lt_free(pent->le_data);
-	entry_free(pent);
-	return CC_LOOKUP_OK;
+	struct lookup_shard_st  *shard;
+	uint64_t                 hval = table->lt_hash(key);
+	cc_lookup_status_t       ret  = CC_LOOKUP_OK;
+
+	shard = shard_get(table, hval);
+	shard_wrlock(table, shard);
+	if(shard->ls_old && !table_frozen(table))
+		shard_rehash(table, shard, LOOKUP_REHASH_STEP);
+
+	if(NULL == (pent = entry_find(table, shard, key, hval, &head)))
+		ret = CC_LOOKUP_NOENT;
+	else
+	{
+		if(pent->le_prev)  LOOKUP_PUBLISH(pent->le_prev->le_next, pent->le_next);
+		else               LOOKUP_PUBLISH(*head, pent->le_next);
+		if(pent->le_next)  pent->le_next->le_prev = pent->le_prev;
+		if(deleted) *deleted = (void *)pent->le_data;
+		entry_retire(table, shard, pent, 1);
+
+		shard->ls_count -= 1;
+		if(table->lt_shrink && NULL == shard->ls_old && !table_frozen(table) && shard->ls_cur->la_len > shard->ls_min && shard->ls_count < shard->ls_cur->la_len / 8)
+			(void)shard_resize(shard, CC_MAX(shard->ls_min, shard->ls_cur->la_len / 2));
+	}
+	shard_unlock(table, shard);
+	return ret;
 }
 
 cc_lookup_status_t cc_lookup_search(CC_LOOKUP table, const void *key, void **returned)
 {
-	struct lookup_entry_st  *pent;
+	struct lookup_entry_st     *pent;
+	struct lookup_shard_st     *shard;
+	struct cc_lookup_reader_st *reader;
+	uint64_t                    hval = table->lt_hash(key);
+	cc_lookup_status_t          ret  = CC_LOOKUP_OK;
+
+	shard = shard_get(table, hval);
+	if(CC_LOOKUP_LOCK_RCU == table->lt_locking && NULL != (reader = cc_lookup_reader()))
+	{
+		cc_lookup_epoch_enter(reader);
+		if(NULL == (pent = entry_find_rcu(table, shard, key, hval)))
+			ret = CC_LOOKUP_NOENT;
+		else if(returned)
+			*returned = (void *)pent->le_data;
+		cc_lookup_epoch_leave(reader);
+		return ret;
+	}
+
+	shard_rdlock(table, shard);
+	if(NULL == (pent = entry_find(table, shard, key, hval, NULL)))
+		ret = CC_LOOKUP_NOENT;
+	else if(returned)
+		*returned = (void *)pent->le_data;
+	shard_unlock(table, shard);
+	return ret;
+}
+
+cc_lookup_status_t cc_lookup_reserve(CC_LOOKUP table, size_t count)
+{
+	struct lookup_shard_st *shard;
+	cc_lookup_status_t      ret = CC_LOOKUP_OK;
+	size_t                  ix;
+
+	count = CC_MAX((count + table->lt_nshard - 1) / table->lt_nshard, 1);
+	for(ix = 0; ix < table->lt_nshard && CC_LOOKUP_OK == ret; ix += 1)
+	{
+		shard = table->lt_shard + ix;
+		shard_wrlock(table, shard);
+		ret = shard_reserve(table, shard, count);
+		shard_unlock(table, shard);
+	}
+	return ret;
+}
+
+void cc_lookup_autoshrink(CC_LOOKUP table, int enable)
+{
+	table->lt_shrink = enable;
+	return;
+}
+
+size_t cc_lookup_count(CC_LOOKUP table)
+{
+	struct lookup_shard_st *shard;
+	size_t                  count;
+	size_t                  ix;
 
-	if(NULL == (pent = entry_find(table, key, NULL, NULL, NULL)))
-		return CC_LOOKUP_NOENT;
-	if(*returned) *returned = (void *)pent->le_data;
+	for(count = 0, ix = 0; ix < table->lt_nshard; ix += 1)
+	{
+		shard  = table->lt_shard + ix;
+		shard_rdlock(table, shard);
+		count += shard->ls_count;
+		shard_unlock(table, shard);
+	}
+	return count;
+}
+
+CC_LOOKUP_CURSOR cc_lookup_cursor_open(CC_LOOKUP table)
+{
+	struct lookup_cursor_st *cursor;
+
+	if(NULL == (cursor = CC_TALLOC(struct lookup_cursor_st, 1)))
+		return NULL;
+	if(NULL == (cursor->lc_pairs = CC_TALLOC(cc_lookup_pair_t, LOOKUP_CURSOR_BATCH)))
+	{
+		cc_free(cursor);
+		return NULL;
+	}
+	cursor->lc_size  = LOOKUP_CURSOR_BATCH;
+	cursor->lc_table = table;
+	__atomic_add_fetch(&(table->lt_cursors), 1, __ATOMIC_SEQ_CST);
+	return cursor;
+}
+
+cc_lookup_status_t cc_lookup_cursor_next(CC_LOOKUP_CURSOR cursor, const void **key, void **data)
+{
+	if(cursor->lc_next == cursor->lc_count)
+	{
+		cursor->lc_next  = 0;
+		cursor->lc_count = 0;
+		while(0 == cursor->lc_count && cursor->lc_shard < cursor->lc_table->lt_nshard)
+		{
+			if(0 != cursor_fill(cursor))
+				return CC_LOOKUP_SYSERR;
+		}
+		if(0 == cursor->lc_count)
+			return CC_LOOKUP_NOENT;
+	}
+	if(key)  *key  = cursor->lc_pairs[cursor->lc_next].lp_key;
+	if(data) *data = cursor->lc_pairs[cursor->lc_next].lp_data;
+	cursor->lc_next += 1;
 	return CC_LOOKUP_OK;
 }
 
-static struct lookup_entry_st *entry_alloc(void)
+void cc_lookup_cursor_close(CC_LOOKUP_CURSOR cursor)
 {
-	struct lookup_entry_st *newent;
+	__atomic_sub_fetch(&(cursor->lc_table->lt_cursors), 1, __ATOMIC_SEQ_CST);
+	cc_free(cursor->lc_pairs);
+	cc_free(cursor);
+	return;
+}
 
-	pthread_mutex_lock(mut_freelist);
-	if(NULL == ent_freelist)
+/*
+ * Copy of every (key, data) of the table, all the shards being locked
+ * together. The array is freed by cc_free.
+ */
+cc_lookup_status_t cc_lookup_snapshot(CC_LOOKUP table, cc_lookup_pair_t **rpairs, size_t *rcount)
+{
+	struct lookup_shard_st *shard;
+	struct lookup_array_st *array;
+	struct lookup_entry_st *pent;
+	cc_lookup_pair_t       *pairs;
+	size_t                  count;
+	size_t                  ix;
+	size_t                  bx;
+
+	for(count = 0, ix = 0; ix < table->lt_nshard; ix += 1)
 	{
-		newent          = ent_freelist;
-		ent_freelist    = newent->le_next;
-		newent->le_next = NULL;
+		shard  = table->lt_shard + ix;
+		shard_rdlock(table, shard);
+		count += shard->ls_count;
 	}
-	else
+
+	if(NULL != (pairs = CC_TALLOC(cc_lookup_pair_t, CC_MAX(count, 1))))
 	{
-		newent = CC_TALLOC(struct lookup_entry_st, 1);
+		for(count = 0, ix = 0; ix < table->lt_nshard; ix += 1)
+		{
+			shard = table->lt_shard + ix;
+			if(NULL != (array = shard->ls_old))
+			{
+				for(bx = shard->ls_move; bx < array->la_len; bx += 1)
+				{
+					for(pent = array->la_ent[bx]; pent; pent = pent->le_next, count += 1)
+					{
+						pairs[count].lp_key  = pent->le_key;
+						pairs[count].lp_data = (void *)pent->le_data;
+					}
+				}
+			}
+			for(array = shard->ls_cur, bx = 0; bx < array->la_len; bx += 1)
+			{
+				for(pent = array->la_ent[bx]; pent; pent = pent->le_next, count += 1)
+				{
+					pairs[count].lp_key  = pent->le_key;
+					pairs[count].lp_data = (void *)pent->le_data;
+				}
+			}
+		}
 	}
-	pthread_mutex_unlock(mut_freelist);
 
-	return newent;
+	for(ix = table->lt_nshard; ix > 0; ix -= 1)
+		shard_unlock(table, table->lt_shard + ix - 1);
+
+	if(NULL == pairs)
+		return CC_LOOKUP_SYSERR;
+	*rpairs = pairs;
+	*rcount = count;
+	return CC_LOOKUP_OK;
+}
+
+/*
+ * Copy the next buckets of the cursor shard, as long as they fit in
+ * LOOKUP_CURSOR_BATCH pairs (a longer bucket is copied alone).
+ * Returns -1 if the pairs array cannot be enlarged.
+ */
+static int cursor_fill(struct lookup_cursor_st *cursor)
+{
+	CC_LOOKUP               table = cursor->lc_table;
+	struct lookup_shard_st *shard = table->lt_shard + cursor->lc_shard;
+	struct lookup_array_st *array;
+	struct lookup_entry_st *pent;
+	cc_lookup_pair_t       *pairs;
+	size_t                  len;
+	int                     ret   = 0;
+
+	shard_rdlock(table, shard);
+	if(0 == cursor->lc_phase && (NULL == shard->ls_old || cursor->lc_bucket < shard->ls_move))
+	{
+		cursor->lc_phase  = shard->ls_old ? 0 : 1;
+		cursor->lc_bucket = shard->ls_old ? shard->ls_move : 0;
+	}
+	array = cursor->lc_phase ? shard->ls_cur : shard->ls_old;
+
+	while(cursor->lc_bucket < array->la_len)
+	{
+		for(len = 0, pent = array->la_ent[cursor->lc_bucket]; pent; pent = pent->le_next, len += 1);
+		if(cursor->lc_count + len > cursor->lc_size)
+		{
+			if(0 != cursor->lc_count)
+				break;
+			if(NULL == (pairs = (cc_lookup_pair_t *)cc_realloc(cursor->lc_pairs, len * sizeof(cc_lookup_pair_t))))
+			{
+				ret = -1;
+				break;
+			}
+			cursor->lc_pairs = pairs;
+			cursor->lc_size  = len;
+		}
+		for(pent = array->la_ent[cursor->lc_bucket]; pent; pent = pent->le_next)
+		{
+			cursor->lc_pairs[cursor->lc_count].lp_key  = pent->le_key;
+			cursor->lc_pairs[cursor->lc_count].lp_data = (void *)pent->le_data;
+			cursor->lc_count += 1;
+		}
+		cursor->lc_bucket += 1;
+	}
+
+	if(cursor->lc_bucket == array->la_len)
+	{
+		cursor->lc_bucket = 0;
+		if(0 == cursor->lc_phase)
+			cursor->lc_phase  = 1;
+		else
+		{
+			cursor->lc_phase  = 0;
+			cursor->lc_shard += 1;
+		}
+	}
+	shard_unlock(table, shard);
+	return ret;
+}
+
+/*
+ * True while cursors are open : the shards must keep their buckets.
+ */
+static int table_frozen(CC_LOOKUP table)
+{
+	return 0 != __atomic_load_n(&(table->lt_cursors), __ATOMIC_SEQ_CST);
+}
+
+/*
+ * Entries come from a pool shared by all of the tables (see CCA/pool.h),
+ * created with the first table.
+ */
+static struct lookup_entry_st *entry_alloc(void)
+{
+	return NULL == ent_pool ? NULL : (struct lookup_entry_st *)cc_pool_alloc(ent_pool);
+}
+
+static void entry_init(void)
+{
+	ent_pool = cc_pool_create(sizeof(struct lookup_entry_st), sizeof(void *), 0);
+	return;
+}
+
+static struct lookup_entry_st *entry_find(CC_LOOKUP table, struct lookup_shard_st *shard, const void *key, uint64_t hval, struct lookup_entry_st ***rpent)
+{
+	struct lookup_entry_st  *eptr;
+	struct lookup_entry_st **head;
+
+	head = shard_bucket(shard, hval);
+	if(rpent) *rpent = head;
+
+	for(eptr = *head; eptr; eptr = eptr->le_next)
+	{
+		if(hval == eptr->le_kval && 0 == table->lt_comp(eptr->le_key, key))
+		{
+			return eptr;
+		}
+	}
+	return NULL;
 }
 
-static struct lookup_entry_st *entry_find(CC_LOOKUP table, const void *key, uint64_t *rhash, size_t *rhent, struct lookup_entry_st ***rpent)
+/*
+ * Search without lock, inside an epoch.
+ *
+ * ls_cur is read before ls_old : a resize publishes ls_old first, so a
+ * new current array is never seen without the old one. Every array
+ * reached is complete for the buckets it is read for, since moved
+ * entries are copied and the originals stay linked until reclaimed.
+ */
+static struct lookup_entry_st *entry_find_rcu(CC_LOOKUP table, struct lookup_shard_st *shard, const void *key, uint64_t hval)
 {
+	struct lookup_array_st *cur;
+	struct lookup_array_st *old;
 	struct lookup_entry_st *eptr;
-	uint64_t                hval = table->lt_hash(key);
-	size_t                  hent = hval % table->lt_len;
+	size_t                  hent;
 
-	if(rhash) *rhash = hval;
-	if(rhent) *rhent = hent;
-	if(rpent) *rpent = table->lt_ent + hent;
+	cur = LOOKUP_LOAD(shard->ls_cur);
+	old = LOOKUP_LOAD(shard->ls_old);
+	if(old && (hent = hval % old->la_len) >= LOOKUP_LOAD(shard->ls_move))
+		eptr = LOOKUP_LOAD(old->la_ent[hent]);
+	else
+		eptr = LOOKUP_LOAD(cur->la_ent[hval % cur->la_len]);
 
-	for(eptr = table->lt_ent[hent]; eptr; eptr = eptr->le_next)
+	for(; eptr; eptr = LOOKUP_LOAD(eptr->le_next))
 	{
 		if(hval == eptr->le_kval && 0 == table->lt_comp(eptr->le_key, key))
 		{
@@ -225,66 +688,478 @@ static struct lookup_entry_st *entry_find(CC_LOOKUP table, const void *key, uint
 
 static void entry_free(struct lookup_entry_st *entry)
 {
-	pthread_mutex_lock(mut_freelist);
-	entry->le_next = ent_freelist;
+	entry->le_next = NULL;
 	entry->le_prev = NULL;
 	entry->le_kval = 0;
 	entry->le_key  = NULL;
 	entry->le_data = NULL;
-	ent_freelist   = entry;
-	pthread_mutex_unlock(mut_freelist);
+	cc_pool_free(ent_pool, entry);
+	return;
+}
+
+/*
+ * Release an unlinked entry, and its data if it is deleted. Lock free
+ * searches may still follow it, compare its key and return its data, so
+ * it keeps them and le_next until its epoch is over.
+ */
+static void entry_retire(CC_LOOKUP table, struct lookup_shard_st *shard, struct lookup_entry_st *entry, int dispose)
+{
+	struct lookup_limbo_st *limbo;
+
+	if(CC_LOOKUP_LOCK_RCU != table->lt_locking)
+	{
+		if(dispose && table->lt_free)
+			table->lt_free(entry->le_data);
+		entry_free(entry);
+		return;
+	}
+	limbo = shard_limbo(table, shard);
+	if(dispose)
+	{
+		entry->le_prev = limbo->lm_del;
+		limbo->lm_del  = entry;
+	}
+	else
+	{
+		entry->le_prev = limbo->lm_ent;
+		limbo->lm_ent  = entry;
+	}
+	return;
+}
+
+/*
+ * Arrays are allocated for the capacity of their class, so that any
+ * free array of the class can be reused.
+ */
+static struct lookup_array_st *array_alloc(size_t len)
+{
+	struct lookup_array_st *newarr = NULL;
+	unsigned                cls    = array_class(len);
+	size_t                  cap    = len;
+
+	if(cls < LOOKUP_ARRAY_CLASSES)
+	{
+		cap = (size_t)1 << cls;
+		pthread_mutex_lock(mut_freelist);
+		if(NULL != (newarr = arr_freelist[cls]))
+		{
+			arr_freelist[cls]   = newarr->la_next;
+			arr_freecount[cls] -= 1;
+		}
+		pthread_mutex_unlock(mut_freelist);
+		if(NULL != newarr)
+			memset(newarr->la_ent, 0, len * sizeof(struct lookup_entry_st *));
+	}
+	if(NULL == newarr)
+		newarr = (struct lookup_array_st *)cc_malloc(LOOKUP_ARRAY_HEAD_SZ + cap * sizeof(struct lookup_entry_st *));
+	if(NULL != newarr)
+	{
+		newarr->la_len  = len;
+		newarr->la_next = NULL;
+	}
+	return newarr;
+}
+
+static void array_free(struct lookup_array_st *array)
+{
+	unsigned cls = array_class(array->la_len);
+
+	if(cls < LOOKUP_ARRAY_CLASSES)
+	{
+		pthread_mutex_lock(mut_freelist);
+		if(arr_freecount[cls] < LOOKUP_ARRAY_KEEP)
+		{
+			array->la_next      = arr_freelist[cls];
+			arr_freelist[cls]   = array;
+			arr_freecount[cls] += 1;
+			array               = NULL;
+		}
+		pthread_mutex_unlock(mut_freelist);
+	}
+	if(NULL != array)
+		cc_free(array);
+	return;
+}
+
+/*
+ * Smallest class holding `len' buckets.
+ */
+static unsigned array_class(size_t len)
+{
+	unsigned cls;
+
+	for(cls = 0; cls < LOOKUP_ARRAY_CLASSES && ((size_t)1 << cls) < len; cls += 1);
+	return cls;
+}
+
+static void array_retire(CC_LOOKUP table, struct lookup_shard_st *shard, struct lookup_array_st *array)
+{
+	struct lookup_limbo_st *limbo;
+
+	if(CC_LOOKUP_LOCK_RCU != table->lt_locking)
+	{
+		array_free(array);
+		return;
+	}
+	limbo          = shard_limbo(table, shard);
+	array->la_next = limbo->lm_arr;
+	limbo->lm_arr  = array;
+	return;
+}
+
+/*
+ * The shard is chosen by the high bits of the hash, the bucket by its
+ * remainder.
+ */
+static struct lookup_shard_st *shard_get(CC_LOOKUP table, uint64_t hval)
+{
+	return table->lt_shard + (table->lt_shift < 64 ? hval >> table->lt_shift : 0);
+}
+
+static void shard_rdlock(CC_LOOKUP table, struct lookup_shard_st *shard)
+{
+	switch(table->lt_locking)
+	{
+	case CC_LOOKUP_LOCK_MUTEX:
+	case CC_LOOKUP_LOCK_RCU:    pthread_mutex_lock(&(shard->ls_lock.mutex));      break;
+	case CC_LOOKUP_LOCK_RWLOCK: pthread_rwlock_rdlock(&(shard->ls_lock.rwlock)); break;
+	default:                                                                      break;
+	}
+	return;
+}
+
+static void shard_wrlock(CC_LOOKUP table, struct lookup_shard_st *shard)
+{
+	switch(table->lt_locking)
+	{
+	case CC_LOOKUP_LOCK_MUTEX:
+	case CC_LOOKUP_LOCK_RCU:    pthread_mutex_lock(&(shard->ls_lock.mutex));      break;
+	case CC_LOOKUP_LOCK_RWLOCK: pthread_rwlock_wrlock(&(shard->ls_lock.rwlock)); break;
+	default:                                                                      break;
+	}
+	return;
+}
+
+static void shard_unlock(CC_LOOKUP table, struct lookup_shard_st *shard)
+{
+	switch(table->lt_locking)
+	{
+	case CC_LOOKUP_LOCK_MUTEX:
+	case CC_LOOKUP_LOCK_RCU:    pthread_mutex_unlock(&(shard->ls_lock.mutex));   break;
+	case CC_LOOKUP_LOCK_RWLOCK: pthread_rwlock_unlock(&(shard->ls_lock.rwlock)); break;
+	default:                                                                     break;
+	}
+	return;
+}
+
+/*
+ * Bucket of a hash value : the one of the old table while it is not
+ * moved yet.
+ */
+static struct lookup_entry_st **shard_bucket(struct lookup_shard_st *shard, uint64_t hval)
+{
+	size_t hent;
+
+	if(shard->ls_old && (hent = hval % shard->ls_old->la_len) >= shard->ls_move)
+		return shard->ls_old->la_ent + hent;
+	return shard->ls_cur->la_ent + hval % shard->ls_cur->la_len;
+}
+
+/*
+ * Start moving the entries to a table of `len' buckets.
+ */
+static int shard_resize(struct lookup_shard_st *shard, size_t len)
+{
+	struct lookup_array_st *newarr;
+
+	if(NULL == (newarr = array_alloc(len)))
+		return -1;
+	LOOKUP_PUBLISH(shard->ls_move, 0);
+	LOOKUP_PUBLISH(shard->ls_old,  shard->ls_cur);
+	LOOKUP_PUBLISH(shard->ls_cur,  newarr);
+	return 0;
+}
+
+/*
+ * Move up to `count' non empty buckets of the old table.
+ */
+static void shard_rehash(CC_LOOKUP table, struct lookup_shard_st *shard, size_t count)
+{
+	size_t empty = count < SIZE_MAX / LOOKUP_REHASH_EMPTY ? count * LOOKUP_REHASH_EMPTY : SIZE_MAX;
+
+	while(shard->ls_old && count > 0 && empty > 0)
+	{
+		if(NULL == shard->ls_old->la_ent[shard->ls_move])
+		{
+			LOOKUP_PUBLISH(shard->ls_move, shard->ls_move + 1);
+			empty -= 1;
+		}
+		else if(0 == shard_rehash_bucket(table, shard))
+			count -= 1;
+		else
+			break;
+		if(shard->ls_move == shard->ls_old->la_len)
+		{
+			array_retire(table, shard, shard->ls_old);
+			LOOKUP_PUBLISH(shard->ls_old, NULL);
+		}
+	}
 	return;
 }
 
-static struct lookup_table_st *table_alloc(size_t len)
+/*
+ * Move the bucket ls_move of the old table. With lock free searches,
+ * the entries are copied first, so that a copy failure leaves the
+ * bucket as it is.
+ */
+static int shard_rehash_bucket(CC_LOOKUP table, struct lookup_shard_st *shard)
+{
+	struct lookup_entry_st  *pent;
+	struct lookup_entry_st  *next;
+	struct lookup_entry_st  *copy;
+	struct lookup_entry_st  *copies = NULL;
+	struct lookup_entry_st **head;
+
+	if(CC_LOOKUP_LOCK_RCU != table->lt_locking)
+	{
+		for(pent = shard->ls_old->la_ent[shard->ls_move]; pent; pent = next)
+		{
+			next          = pent->le_next;
+			head          = shard->ls_cur->la_ent + pent->le_kval % shard->ls_cur->la_len;
+			pent->le_prev = NULL;
+			pent->le_next = *head;
+			if(*head)
+				(*head)->le_prev = pent;
+			*head = pent;
+		}
+		shard->ls_old->la_ent[shard->ls_move] = NULL;
+		shard->ls_move += 1;
+		return 0;
+	}
+
+	for(pent = shard->ls_old->la_ent[shard->ls_move]; pent; pent = pent->le_next)
+	{
+		if(NULL == (copy = entry_alloc()))
+		{
+			for(; copies; copies = next)
+			{
+				next = copies->le_prev;
+				entry_free(copies);
+			}
+			return -1;
+		}
+		*copy         = *pent;
+		copy->le_prev = copies;
+		copies        = copy;
+	}
+	for(; copies; copies = next)
+	{
+		next           = copies->le_prev;
+		head           = shard->ls_cur->la_ent + copies->le_kval % shard->ls_cur->la_len;
+		copies->le_prev = NULL;
+		copies->le_next = *head;
+		if(*head)
+			(*head)->le_prev = copies;
+		LOOKUP_PUBLISH(*head, copies);
+	}
+	LOOKUP_PUBLISH(shard->ls_move, shard->ls_move + 1);
+	for(pent = shard->ls_old->la_ent[shard->ls_move - 1]; pent; pent = pent->le_next)
+		entry_retire(table, shard, pent, 0);
+	return 0;
+}
+
+static cc_lookup_status_t shard_reserve(CC_LOOKUP table, struct lookup_shard_st *shard, size_t count)
+{
+	if(count > shard->ls_min)
+		shard->ls_min = count;
+	if(table_frozen(table))
+		return CC_LOOKUP_OK;
+	shard_rehash(table, shard, SIZE_MAX);
+	if(count > shard->ls_cur->la_len)
+	{
+		if(0 != shard_resize(shard, count))
+			return CC_LOOKUP_SYSERR;
+		shard_rehash(table, shard, SIZE_MAX);
+	}
+	return shard->ls_old ? CC_LOOKUP_SYSERR : CC_LOOKUP_OK;
+}
+
+/*
+ * Limbo list of the current epoch. The lists whose epoch is two behind
+ * are reclaimed on the way, and an attempt to advance the epoch is made
+ * regularly.
+ */
+static struct lookup_limbo_st *shard_limbo(CC_LOOKUP table, struct lookup_shard_st *shard)
+{
+	struct lookup_limbo_st *limbo;
+	uint64_t                epoch;
+	size_t                  ix;
+
+	if(0 == (++shard->ls_retired % LOOKUP_EPOCH_RETIRES))
+		(void)cc_lookup_epoch_advance();
+
+	epoch = cc_lookup_epoch_sync();
+	for(ix = 0; ix < CC_ARRAY_COUNT(shard->ls_limbo); ix += 1)
+	{
+		limbo = shard->ls_limbo + ix;
+		if(limbo->lm_epoch + 2 <= epoch)
+			shard_limbo_free(table, limbo);
+	}
+	limbo = shard->ls_limbo + epoch % CC_ARRAY_COUNT(shard->ls_limbo);
+	limbo->lm_epoch = epoch;
+	return limbo;
+}
+
+/*
+ * Reclaim a limbo list : the destructor runs on the data of the deleted
+ * entries, now that no search can return them.
+ */
+static void shard_limbo_free(CC_LOOKUP table, struct lookup_limbo_st *limbo)
+{
+	struct lookup_entry_st *pent;
+	struct lookup_array_st *parr;
+
+	while(NULL != (pent = limbo->lm_ent))
+	{
+		limbo->lm_ent = pent->le_prev;
+		entry_free(pent);
+	}
+	while(NULL != (pent = limbo->lm_del))
+	{
+		limbo->lm_del = pent->le_prev;
+		if(table->lt_free)
+			table->lt_free(pent->le_data);
+		entry_free(pent);
+	}
+	while(NULL != (parr = limbo->lm_arr))
+	{
+		limbo->lm_arr = parr->la_next;
+		array_free(parr);
+	}
+	return;
+}
+
+/*
+ * Release the entries of a shard, calling the destructor on their data.
+ */
+static void shard_destroy(CC_LOOKUP table, struct lookup_shard_st *shard)
+{
+	size_t ix;
+
+	for(ix = 0; ix < CC_ARRAY_COUNT(shard->ls_limbo); ix += 1)
+		shard_limbo_free(table, shard->ls_limbo + ix);
+	if(shard->ls_old)
+		shard_destroy_chains(table, shard->ls_old->la_ent + shard->ls_move, shard->ls_old->la_len - shard->ls_move);
+	shard_destroy_chains(table, shard->ls_cur->la_ent, shard->ls_cur->la_len);
+
+	if(shard->ls_old)
+		array_free(shard->ls_old);
+	array_free(shard->ls_cur);
+	shard->ls_old = NULL;
+	shard->ls_cur = NULL;
+	switch(table->lt_locking)
+	{
+	case CC_LOOKUP_LOCK_MUTEX:
+	case CC_LOOKUP_LOCK_RCU:    pthread_mutex_destroy(&(shard->ls_lock.mutex));   break;
+	case CC_LOOKUP_LOCK_RWLOCK: pthread_rwlock_destroy(&(shard->ls_lock.rwlock)); break;
+	default:                                                                      break;
+	}
+	return;
+}
+
+static void shard_destroy_chains(CC_LOOKUP table, struct lookup_entry_st **pt, size_t len)
+{
+	struct lookup_entry_st *pe;
+	struct lookup_entry_st *pn;
+	size_t                  ix;
+
+	for(ix = 0; ix < len; ix += 1, pt += 1)
+	{
+		for(pe = *pt; pe; pe = pn)
+		{
+			pn = pe->le_next;
+			if(table->lt_free)
+				table->lt_free(pe->le_data);
+			entry_free(pe);
+		}
+		*pt = NULL;
+	}
+	return;
+}
+
+static struct lookup_table_st *table_alloc(size_t len, size_t nshard, cc_lookup_locking_t locking)
 {
 	struct lookup_table_st   *newret;
 	struct lookup_freelst_st *newlst;
+	struct lookup_shard_st   *newshd;
+	size_t                    ix;
 
-	pthread_mutex_lock(mut_freelist);
-	for(newlst = tbl_freelist; newlst; newlst = newlst->fl_next)
+	if(NULL == (newshd = CC_TALLOC(struct lookup_shard_st, nshard)))
+		return NULL;
+	for(ix = 0; ix < nshard; ix += 1)
 	{
-		if(newlst->fl_len == len)
+		if(NULL == (newshd[ix].ls_cur = array_alloc(len)))
 		{
-			if(newlst->fl_prev) newlst->fl_prev->fl_next = newlst->fl_next;
-			else                tbl_freelist = newlst->fl_next;
-			if(newlst->fl_next) newlst->fl_next->fl_prev = newlst->fl_prev;
-			newlst = newlst;
-			break;
+			while(ix-- > 0)
+				array_free(newshd[ix].ls_cur);
+			cc_free(newshd);
+			return NULL;
+		}
+		newshd[ix].ls_min = len;
+		switch(locking)
+		{
+		case CC_LOOKUP_LOCK_MUTEX:
+		case CC_LOOKUP_LOCK_RCU:    pthread_mutex_init(&(newshd[ix].ls_lock.mutex), NULL);   break;
+		case CC_LOOKUP_LOCK_RWLOCK: pthread_rwlock_init(&(newshd[ix].ls_lock.rwlock), NULL); break;
+		default:                                                                              break;
 		}
 	}
+
+	pthread_mutex_lock(mut_freelist);
+	if(NULL != (newlst = tbl_freelist))
+		tbl_freelist = newlst->fl_next;
 	pthread_mutex_unlock(mut_freelist);
 	if(NULL != newlst)
 	{
 		newret = (struct lookup_table_st *)newlst;
 		newret->lt_comp = NULL;
 		newret->lt_hash = NULL;
+		newret->lt_free = NULL;
 	}
 	else
 	{
-		if(NULL != (newret = (struct lookup_table_st *)cc_malloc(LOOKUP_TABLE_HEAD_SZ + len * sizeof(struct lookup_entry_st *))))
+		if(NULL == (newret = CC_TALLOC(struct lookup_table_st, 1)))
 		{
-			newret->lt_len = len;
-			pthread_mutex_init(&(newret->lt_mutex), NULL);
+			for(ix = 0; ix < nshard; ix += 1)
+				array_free(newshd[ix].ls_cur);
+			cc_free(newshd);
+			return NULL;
 		}
+		pthread_mutex_init(&(newret->lt_mutex), NULL);
 	}
+	newret->lt_locking = locking;
+	newret->lt_shrink  = 0;
+	for(newret->lt_shift = 64, ix = nshard; ix > 1; ix >>= 1, newret->lt_shift -= 1);
+	newret->lt_nshard  = nshard;
+	newret->lt_shard   = newshd;
+	newret->lt_cursors = 0;
 	return newret;
 }
 
 static void table_free(struct lookup_table_st *table)
 {
 	struct lookup_freelst_st  *fltbl = (struct lookup_freelst_st *)table;
-	size_t                     index;
-	struct lookup_entry_st   **entry;
-
-	table->lt_comp = NULL;
-	table->lt_hash = NULL;
-	table->lt_free = NULL;
-	for(entry = table->lt_ent, index = 0; index < table->lt_len; *(entry++) = NULL, index += 1);
-	fltbl->fl_prev = NULL;
+
+	cc_free(table->lt_shard);
+	table->lt_shard  = NULL;
+	table->lt_nshard = 0;
+	table->lt_comp   = NULL;
+	table->lt_hash   = NULL;
+	table->lt_free   = NULL;
+	fltbl->fl_prev   = NULL;
 	pthread_mutex_lock(mut_freelist);
-	fltbl->fl_next = tbl_freelist;
-	tbl_freelist   = fltbl;
+	fltbl->fl_next   = tbl_freelist;
+	tbl_freelist     = fltbl;
 	pthread_mutex_unlock(mut_freelist);
 	return;
 }
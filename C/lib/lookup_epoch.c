@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026
+ *     Christian CAMIER <christian.c at promethee dot services>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <CCA/memory.h>
+
+#include "lookup_internal.h"
+
+/* Global functions */
+extern struct cc_lookup_reader_st *cc_lookup_reader(void);
+extern uint64_t                    cc_lookup_epoch_sync(void);
+extern int                         cc_lookup_epoch_advance(void);
+extern void                        cc_lookup_synchronize(void);
+
+/* Local defined functions */
+static void reader_init(void);
+static void reader_release(void *);
+
+/* Global data */
+uint64_t cc_lookup_epoch = 1;
+
+/* Local data */
+static pthread_once_t              reader_once     = PTHREAD_ONCE_INIT;
+static pthread_key_t               reader_key;
+static pthread_mutex_t             reader_mutex[1] = { PTHREAD_MUTEX_INITIALIZER };
+static struct cc_lookup_reader_st *reader_list     = NULL;
+static __thread struct cc_lookup_reader_st *reader_self = NULL;
+
+/*
+ * Reader record of the calling thread, registered at its first search.
+ * Records of terminated threads are reused.
+ */
+struct cc_lookup_reader_st *cc_lookup_reader(void)
+{
+	struct cc_lookup_reader_st *reader;
+
+	if(NULL != (reader = reader_self))
+		return reader;
+
+	pthread_once(&reader_once, reader_init);
+	pthread_mutex_lock(reader_mutex);
+	for(reader = reader_list; reader && reader->lr_used; reader = reader->lr_next);
+	if(NULL == reader && NULL != (reader = CC_TALLOC(struct cc_lookup_reader_st, 1)))
+	{
+		reader->lr_next = reader_list;
+		__atomic_store_n(&reader_list, reader, __ATOMIC_RELEASE);
+	}
+	if(NULL != reader)
+		reader->lr_used = 1;
+	pthread_mutex_unlock(reader_mutex);
+
+	if(NULL != reader)
+	{
+		pthread_setspecific(reader_key, reader);
+		reader_self = reader;
+	}
+	return reader;
+}
+
+/*
+ * Current epoch, read after the preceding unlinks are visible.
+ */
+uint64_t cc_lookup_epoch_sync(void)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	return __atomic_load_n(&cc_lookup_epoch, __ATOMIC_ACQUIRE);
+}
+
+/*
+ * Advance the epoch if every reader inside a search has seen it.
+ * Returns 1 if it has been advanced.
+ */
+int cc_lookup_epoch_advance(void)
+{
+	struct cc_lookup_reader_st *reader;
+	uint64_t                    epoch;
+	uint64_t                    seen;
+
+	epoch = cc_lookup_epoch_sync();
+	for(reader = __atomic_load_n(&reader_list, __ATOMIC_ACQUIRE); reader; reader = reader->lr_next)
+	{
+		seen = __atomic_load_n(&(reader->lr_epoch), __ATOMIC_ACQUIRE);
+		if(0 != seen && epoch != seen)
+			return 0;
+	}
+	return __atomic_compare_exchange_n(&cc_lookup_epoch, &epoch, epoch + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+}
+
+/*
+ * Wait until the searches running at the call have returned : the
+ * epoch is advanced twice, which every reader seen inside a search
+ * holds back until it leaves.
+ */
+void cc_lookup_synchronize(void)
+{
+	uint64_t epoch = cc_lookup_epoch_sync();
+
+	while(__atomic_load_n(&cc_lookup_epoch, __ATOMIC_ACQUIRE) < epoch + 2)
+	{
+		if(!cc_lookup_epoch_advance())
+			sched_yield();
+	}
+	return;
+}
+
+static void reader_init(void)
+{
+	pthread_key_create(&reader_key, reader_release);
+	return;
+}
+
+static void reader_release(void *arg)
+{
+	struct cc_lookup_reader_st *reader = (struct cc_lookup_reader_st *)arg;
+
+	__atomic_store_n(&(reader->lr_epoch), 0, __ATOMIC_RELEASE);
+	pthread_mutex_lock(reader_mutex);
+	reader->lr_used = 0;
+	pthread_mutex_unlock(reader_mutex);
+	return;
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026
+ *     Christian CAMIER <christian.c at promethee dot services>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __CC_LOOKUP_INTERNAL_H__
+#define __CC_LOOKUP_INTERNAL_H__
+
+/*
+ * Epoch based reclamation for the lock free searches of cc_lookup.
+ *
+ * A searching thread publishes the global epoch it has seen in its
+ * reader record, and 0 when it is done. The epoch is advanced only when
+ * every reader inside a search has seen the current one, so an object
+ * unlinked during epoch E is no longer referenced once the global epoch
+ * reaches E + 2.
+ */
+
+struct cc_lookup_reader_st {
+	uint64_t                    lr_epoch;	/* 0 when outside a search */
+	struct cc_lookup_reader_st *lr_next;
+	int                         lr_used;
+	char                        lr_pad[64];	/* One record by cache line */
+};
+
+extern uint64_t cc_lookup_epoch;
+
+extern struct cc_lookup_reader_st *cc_lookup_reader(void);
+extern uint64_t                    cc_lookup_epoch_sync(void);
+extern int                         cc_lookup_epoch_advance(void);
+
+static inline void cc_lookup_epoch_enter(struct cc_lookup_reader_st *reader)
+{
+	__atomic_store_n(&(reader->lr_epoch), __atomic_load_n(&cc_lookup_epoch, __ATOMIC_ACQUIRE), __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void cc_lookup_epoch_leave(struct cc_lookup_reader_st *reader)
+{
+	__atomic_store_n(&(reader->lr_epoch), 0, __ATOMIC_RELEASE);
+}
+
+#endif /* ! __CC_LOOKUP_INTERNAL_H__ */
@@ -0,0 +1,440 @@
+/*
+ * Copyright (c) 2026
+ *     Christian CAMIER <christian.c at promethee dot services>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <CCA/hash.h>
+#include <CCA/io.h>
+#include <CCA/memory.h>
+#include <CCA/util.h>
+
+#define __CC_LOOKUP_MAP_INTERNAL__
+#include <CCA/lookup_map.h>
+
+/*
+ * File layout :
+ *
+ *	header	struct lookup_map_head_st
+ *	index	mh_mask + 1 slots, at offset mh_index (64 bytes aligned)
+ *	records	8 bytes aligned, after the index
+ *
+ * The index is open addressing with linear probing, filled at most to
+ * one half. A slot holds the high 32 bits of the key hash and the
+ * offset of the record divided by 8, 0 for an empty slot (offset 0 is
+ * the header). A record is its struct lookup_map_rec_st followed by
+ * the key, a NUL byte, the data and a NUL byte.
+ */
+#define MAP_MAGIC	"CCLKMAP"
+#define MAP_ORDER	0x01020304
+#define MAP_VERSION	1
+#define MAP_ALIGN	8
+#define MAP_BUFSIZE	65536
+
+/* Local datatypes definition */
+struct lookup_map_head_st {
+	char     mh_magic[8];
+	uint32_t mh_order;		/* Byte order mark                  */
+	uint32_t mh_version;
+	uint64_t mh_seed;		/* Seed of cc_hash64                */
+	uint64_t mh_count;		/* Number of records                */
+	uint64_t mh_mask;		/* Number of slots - 1              */
+	uint64_t mh_index;		/* Offset of the index              */
+	uint64_t mh_size;		/* Size of the file                 */
+};
+
+struct lookup_map_slot_st {
+	uint32_t ms_tag;		/* High bits of the hash            */
+	uint32_t ms_rec;		/* Offset of the record / 8         */
+};
+
+struct lookup_map_rec_st {
+	uint32_t mr_klen;
+	uint32_t mr_dlen;
+};
+
+struct lookup_map_st {
+	const uint8_t                   *lm_base;
+	size_t                           lm_size;
+	const struct lookup_map_head_st *lm_head;
+	const struct lookup_map_slot_st *lm_slot;
+};
+
+/* Record being written */
+struct lookup_map_item_st {
+	const void *mi_key;
+	const void *mi_data;
+	size_t      mi_klen;
+	size_t      mi_dlen;
+};
+
+/* Output buffer */
+struct lookup_map_out_st {
+	int     mo_fd;
+	size_t  mo_len;
+	uint8_t mo_buf[MAP_BUFSIZE];
+};
+
+/* Global functions */
+extern int                cc_lookup_map_build          (const char *, CC_LOOKUP,    cc_lookup_map_dump_t, cc_lookup_map_dump_t);
+extern int                cc_lookup_map_build_hashtable(const char *, CC_HASHTABLE, cc_lookup_map_dump_t, cc_lookup_map_dump_t);
+extern int                cc_lookup_map_write          (const char *, const cc_lookup_pair_t *, size_t, cc_lookup_map_dump_t, cc_lookup_map_dump_t);
+extern CC_LOOKUP_MAP      cc_lookup_map_open           (const char *, int);
+extern void               cc_lookup_map_close          (CC_LOOKUP_MAP);
+extern size_t             cc_lookup_map_count          (CC_LOOKUP_MAP);
+extern cc_lookup_status_t cc_lookup_map_search         (CC_LOOKUP_MAP, const void *, size_t, const void **, size_t *);
+extern cc_lookup_status_t cc_lookup_map_search_str     (CC_LOOKUP_MAP, const char *, const char **);
+
+/* Local defined functions */
+static size_t map_dump_str(const void *, const void **);
+static size_t map_rec_size(size_t, size_t);
+static int    map_out     (struct lookup_map_out_st *, const void *, size_t);
+static int    map_flush   (struct lookup_map_out_st *);
+static int    map_store   (const char *, const struct lookup_map_head_st *, const struct lookup_map_slot_st *, const struct lookup_map_item_st *);
+
+int cc_lookup_map_build(const char *path, CC_LOOKUP table, cc_lookup_map_dump_t kdump, cc_lookup_map_dump_t ddump)
+{
+	cc_lookup_pair_t *pairs;
+	size_t            count;
+	int               ret;
+
+	if(CC_LOOKUP_OK != cc_lookup_snapshot(table, &pairs, &count))
+		return -1;
+	ret = cc_lookup_map_write(path, pairs, count, kdump, ddump);
+	cc_free(pairs);
+	return ret;
+}
+
+int cc_lookup_map_build_hashtable(const char *path, CC_HASHTABLE table, cc_lookup_map_dump_t kdump, cc_lookup_map_dump_t ddump)
+{
+	CC_HASHTABLE_HDR *elts;
+	cc_lookup_pair_t *pairs;
+	size_t            count;
+	size_t            i;
+	int               ret;
+
+	/* The data is the element, whose layout only the caller knows */
+	if(NULL == ddump)
+	{
+		errno = EINVAL;
+		return -1;
+	}
+	if(CC_HASHTABLE_ERR_NOERROR != cc_hashtable_snapshot(table, &elts, &count))
+		return -1;
+	if(NULL == (pairs = CC_TALLOC(cc_lookup_pair_t, CC_MAX(count, 1))))
+	{
+		cc_free(elts);
+		return -1;
+	}
+	for(i = 0; i < count; i += 1)
+	{
+		pairs[i].lp_key  = elts[i]->key;
+		pairs[i].lp_data = elts[i];
+	}
+	cc_free(elts);
+	ret = cc_lookup_map_write(path, pairs, count, kdump, ddump);
+	cc_free(pairs);
+	return ret;
+}
+
+int cc_lookup_map_write(const char *path, const cc_lookup_pair_t *pairs, size_t count, cc_lookup_map_dump_t kdump, cc_lookup_map_dump_t ddump)
+{
+	struct lookup_map_head_st  head;
+	struct lookup_map_slot_st *slot = NULL;
+	struct lookup_map_item_st *item = NULL;
+	uint64_t                   hval;
+	uint64_t                   offset;
+	size_t                     nslot;
+	size_t                     i;
+	size_t                     s;
+	int                        ret = -1;
+
+	if(NULL == kdump) kdump = map_dump_str;
+	if(NULL == ddump) ddump = map_dump_str;
+
+	for(nslot = 8; nslot < 2 * count; nslot <<= 1);
+
+	memset(&head, 0, sizeof(head));
+	memcpy(head.mh_magic, MAP_MAGIC, sizeof(head.mh_magic));
+	head.mh_order   = MAP_ORDER;
+	head.mh_version = MAP_VERSION;
+	head.mh_seed    = 0;
+	head.mh_count   = count;
+	head.mh_mask    = nslot - 1;
+	head.mh_index   = 64;
+
+	if(NULL == (slot = CC_TALLOC(struct lookup_map_slot_st, nslot)) ||
+	   NULL == (item = CC_TALLOC(struct lookup_map_item_st, CC_MAX(count, 1))))
+		goto end;
+
+	/*
+	 * The offsets of the records only depend on their sizes, so the
+	 * index is built before anything is written.
+	 */
+	offset = head.mh_index + nslot * sizeof(struct lookup_map_slot_st);
+	for(i = 0; i < count; i += 1)
+	{
+		item[i].mi_klen = kdump(pairs[i].lp_key,  &(item[i].mi_key));
+		item[i].mi_dlen = ddump(pairs[i].lp_data, &(item[i].mi_data));
+		if(item[i].mi_klen > UINT32_MAX || item[i].mi_dlen > UINT32_MAX || offset / MAP_ALIGN > UINT32_MAX)
+		{
+			errno = EINVAL;
+			goto end;
+		}
+
+		hval = cc_hash64(item[i].mi_key, item[i].mi_klen, head.mh_seed);
+		for(s = hval & head.mh_mask; 0 != slot[s].ms_rec; s = (s + 1) & head.mh_mask);
+		slot[s].ms_tag = (uint32_t)(hval >> 32);
+		slot[s].ms_rec = (uint32_t)(offset / MAP_ALIGN);
+		offset += map_rec_size(item[i].mi_klen, item[i].mi_dlen);
+	}
+	head.mh_size = offset;
+
+	ret = map_store(path, &head, slot, item);
+ end:
+	if(item) cc_free(item);
+	if(slot) cc_free(slot);
+	return ret;
+}
+
+CC_LOOKUP_MAP cc_lookup_map_open(const char *path, int flags)
+{
+	const struct lookup_map_head_st *head;
+	struct lookup_map_st            *map;
+	struct stat                      st;
+	void                            *base;
+	int                              fd;
+
+	if(-1 == (fd = open(path, O_RDONLY | O_CLOEXEC)))
+		return NULL;
+	if(-1 == fstat(fd, &st))
+	{
+		close(fd);
+		return NULL;
+	}
+	if((size_t)st.st_size < sizeof(struct lookup_map_head_st))
+	{
+		close(fd);
+		errno = EINVAL;
+		return NULL;
+	}
+
+#ifdef MAP_POPULATE
+	base = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED | ((flags & CC_LOOKUP_MAP_POPULATE) ? MAP_POPULATE : 0), fd, 0);
+#else
+	base = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+#endif
+	close(fd);
+	if(MAP_FAILED == base)
+		return NULL;
+
+	/* Searches jump around the file : no read ahead unless asked */
+	(void)madvise(base, st.st_size, (flags & CC_LOOKUP_MAP_POPULATE) ? MADV_WILLNEED : MADV_RANDOM);
+
+	head = (const struct lookup_map_head_st *)base;
+	if(0 != memcmp(head->mh_magic, MAP_MAGIC, sizeof(head->mh_magic)) ||
+	   MAP_ORDER   != head->mh_order   ||
+	   MAP_VERSION != head->mh_version ||
+	   (uint64_t)st.st_size != head->mh_size ||
+	   0 != (head->mh_mask & (head->mh_mask + 1)) ||
+	   head->mh_count > head->mh_mask ||
+	   0 != head->mh_index % 64 ||
+	   head->mh_index < sizeof(struct lookup_map_head_st) ||
+	   head->mh_index > head->mh_size ||
+	   (head->mh_size - head->mh_index) / sizeof(struct lookup_map_slot_st) <= head->mh_mask)
+	{
+		munmap(base, st.st_size);
+		errno = EINVAL;
+		return NULL;
+	}
+
+	if(NULL == (map = CC_TALLOC(struct lookup_map_st, 1)))
+	{
+		munmap(base, st.st_size);
+		return NULL;
+	}
+	map->lm_base = (const uint8_t *)base;
+	map->lm_size = st.st_size;
+	map->lm_head = head;
+	map->lm_slot = (const struct lookup_map_slot_st *)(map->lm_base + head->mh_index);
+	return map;
+}
+
+void cc_lookup_map_close(CC_LOOKUP_MAP map)
+{
+	munmap((void *)map->lm_base, map->lm_size);
+	cc_free(map);
+	return;
+}
+
+size_t cc_lookup_map_count(CC_LOOKUP_MAP map)
+{
+	return map->lm_head->mh_count;
+}
+
+/*
+ * The records are checked against the size of the file, so a damaged
+ * file never makes a search read outside of the mapping.
+ */
+cc_lookup_status_t cc_lookup_map_search(CC_LOOKUP_MAP map, const void *key, size_t klen, const void **data, size_t *dlen)
+{
+	const struct lookup_map_head_st *head = map->lm_head;
+	const struct lookup_map_rec_st  *rec;
+	uint64_t                         hval;
+	uint64_t                         offset;
+	uint64_t                         s;
+	uint64_t                         n;
+	uint32_t                         tag;
+
+	hval = cc_hash64(key, klen, head->mh_seed);
+	tag  = (uint32_t)(hval >> 32);
+	for(s = hval & head->mh_mask, n = 0; n <= head->mh_mask && 0 != map->lm_slot[s].ms_rec; s = (s + 1) & head->mh_mask, n += 1)
+	{
+		if(tag != map->lm_slot[s].ms_tag)
+			continue;
+		offset = (uint64_t)map->lm_slot[s].ms_rec * MAP_ALIGN;
+		if(offset > map->lm_size - sizeof(struct lookup_map_rec_st))
+			break;
+		rec = (const struct lookup_map_rec_st *)(map->lm_base + offset);
+		if(rec->mr_klen != klen)
+			continue;
+		if(map_rec_size(rec->mr_klen, rec->mr_dlen) > map->lm_size - offset)
+			break;
+		if(0 != memcmp(rec + 1, key, klen))
+			continue;
+		if(data) *data = (const uint8_t *)(rec + 1) + klen + 1;
+		if(dlen) *dlen = rec->mr_dlen;
+		return CC_LOOKUP_OK;
+	}
+	return CC_LOOKUP_NOENT;
+}
+
+cc_lookup_status_t cc_lookup_map_search_str(CC_LOOKUP_MAP map, const char *key, const char **data)
+{
+	return cc_lookup_map_search(map, key, strlen(key), (const void **)data, NULL);
+}
+
+static size_t map_dump_str(const void *obj, const void **bytes)
+{
+	*bytes = obj;
+	return strlen((const char *)obj);
+}
+
+static size_t map_rec_size(size_t klen, size_t dlen)
+{
+	size_t size = sizeof(struct lookup_map_rec_st) + klen + 1 + dlen + 1;
+	return (size + MAP_ALIGN - 1) & ~(size_t)(MAP_ALIGN - 1);
+}
+
+static int map_flush(struct lookup_map_out_st *out)
+{
+	if(0 != out->mo_len && -1 == cc_io_write(out->mo_fd, out->mo_buf, out->mo_len, NULL, NULL))
+		return -1;
+	out->mo_len = 0;
+	return 0;
+}
+
+static int map_out(struct lookup_map_out_st *out, const void *bytes, size_t len)
+{
+	size_t n;
+
+	while(len > 0)
+	{
+		if(out->mo_len == MAP_BUFSIZE && 0 != map_flush(out))
+			return -1;
+		n = CC_MIN(len, MAP_BUFSIZE - out->mo_len);
+		memcpy(out->mo_buf + out->mo_len, bytes, n);
+		out->mo_len += n;
+		bytes        = (const uint8_t *)bytes + n;
+		len         -= n;
+	}
+	return 0;
+}
+
+/*
+ * Write the file under path.tmp, then rename it, so that a process
+ * having the previous file mapped keeps a consistent view of it.
+ */
+static int map_store(const char *path, const struct lookup_map_head_st *head, const struct lookup_map_slot_st *slot, const struct lookup_map_item_st *item)
+{
+	static const uint8_t      zero[MAP_ALIGN + 64];
+	struct lookup_map_out_st *out;
+	struct lookup_map_rec_st  rec;
+	char                     *tmp;
+	size_t                    len;
+	size_t                    i;
+	int                       ret = -1;
+	int                       err;
+
+	len = strlen(path) + 5;
+	if(NULL == (tmp = CC_TALLOC(char, len)))
+		return -1;
+	snprintf(tmp, len, "%s.tmp", path);
+	if(NULL == (out = CC_TALLOC(struct lookup_map_out_st, 1)))
+	{
+		cc_free(tmp);
+		return -1;
+	}
+	if(-1 == (out->mo_fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)))
+		goto end;
+
+	if(0 != map_out(out, head, sizeof(*head)) ||
+	   0 != map_out(out, zero, head->mh_index - sizeof(*head)) ||
+	   0 != map_out(out, slot, (head->mh_mask + 1) * sizeof(*slot)))
+		goto fail;
+	for(i = 0; i < head->mh_count; i += 1)
+	{
+		rec.mr_klen = (uint32_t)item[i].mi_klen;
+		rec.mr_dlen = (uint32_t)item[i].mi_dlen;
+		len = map_rec_size(rec.mr_klen, rec.mr_dlen) - sizeof(rec) - rec.mr_klen - rec.mr_dlen - 1;
+		if(0 != map_out(out, &rec, sizeof(rec)) ||
+		   0 != map_out(out, item[i].mi_key, rec.mr_klen) ||
+		   0 != map_out(out, zero, 1) ||
+		   0 != map_out(out, item[i].mi_data, rec.mr_dlen) ||
+		   0 != map_out(out, zero, len))
+			goto fail;
+	}
+	if(0 != map_flush(out) || 0 != fsync(out->mo_fd))
+		goto fail;
+	if(0 != close(out->mo_fd))
+	{
+		out->mo_fd = -1;
+		goto fail;
+	}
+	out->mo_fd = -1;
+	if(0 != rename(tmp, path))
+		goto fail;
+	ret = 0;
+	goto end;
+
+ fail:
+	err = errno;
+	if(-1 != out->mo_fd) close(out->mo_fd);
+	unlink(tmp);
+	errno = err;
+ end:
+	cc_free(out);
+	cc_free(tmp);
+	return ret;
+}
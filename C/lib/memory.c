@@ -15,9 +15,28 @@
  * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  */
 
+/*
+ * Every block is preceded by a header holding its size, so that cc_free
+ * can wipe it. The header is 16 bytes long to keep the alignment of
+ * malloc.
+ *
+ * Blocks are zeroed by calloc : for large blocks, malloc implementations
+ * map fresh zero pages and skip the clear. Wiping uses memset followed by
+ * a compiler barrier (the explicit_bzero technique), so that it is not
+ * dropped as a dead store before free. Large wipes are left to memset,
+ * which switches to non temporal stores past its own threshold (sized on
+ * the cache of the machine) : hand written streaming stores were slower
+ * on blocks of a few MB, whose pages are freshly mapped.
+ */
+
 #include <sys/types.h>
+#include <errno.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
 
 #include <CCA/util.h>
 #include <CCA/memory.h>
@@ -27,52 +46,50 @@ extern void  cc_free(void *);
 extern void *cc_malloc(size_t);
 extern void  cc_memclr(void *, size_t);
 extern void *cc_memdup(const void *, size_t);
+extern void  cc_memwipe(void *, size_t);
 extern void *cc_realloc(void *, size_t);
 extern char *cc_strdup(const char *);
 
-#define ULONG_SIZE(nbytes)      (((unsigned long)(nbytes) + sizeof(unsigned long) + sizeof(unsigned long) - 1) / sizeof(unsigned long))
-#define ULONG2BYTES(nulong)     ((unsigned long)(nulong) * sizeof(unsigned long))
+struct memory_hdr_st {
+	size_t mh_size;			/* Bytes usable after the header    */
+	size_t mh_pad;
+};
+
+#define MEMORY_HDR		sizeof(struct memory_hdr_st)
+#define MEMORY_BARRIER(p)	__asm__ __volatile__("" : : "r"(p) : "memory")
+
+static void *memory_alloc(size_t, int);
 
 void *cc_calloc(size_t nmemb, size_t esize)
 {
+	if(0 != esize && nmemb > SIZE_MAX / esize)
+	{
+		errno = ENOMEM;
+		return CC_TNULL(void);
+	}
 	return cc_malloc(nmemb * esize);
 }
 
 extern void  cc_free(void *ptr)
 {
-	unsigned long  i;
-	unsigned long  n;
-	unsigned long *p;
-	unsigned long *s;
+	struct memory_hdr_st *h;
 
-	s  = (unsigned long *)ptr;
-	s -= 1;
-	n  = *s;
-
-	for(i = 0, p = s; i < n; *(p++) =   0UL, i += 1);
-	free(s);
+	if(CC_TNULL(void) == ptr)
+		return;
+	h = (struct memory_hdr_st *)ptr - 1;
+	cc_memwipe(h, MEMORY_HDR + h->mh_size);
+	free(h);
 	return;
 }
 
 extern void *cc_malloc(size_t size)
 {
-	unsigned long  i;
-	unsigned long  n;
-	unsigned long *p;
-	unsigned long *r;
-
-	n = ULONG_SIZE(size);
-	if(CC_TNULL(unsigned long) == (r = (unsigned long *)malloc(ULONG2BYTES(n))))
-		return CC_TNULL(void);
-
-	*(r++) = n;
-	for(p = r, i = 1; i < n; *(p++) = 0UL, i += 1);
-	return (void *)r;
+	return memory_alloc(size, 1);
 }
 
 extern void  cc_memclr(void *ptr, size_t size)
 {
-	(void)memset(ptr, 0x00, size); /* fall into */
+	cc_memwipe(ptr, size);
 	return;
 }
 
@@ -80,34 +97,72 @@ extern void *cc_memdup(const void *address, size_t size)
 {
 	void *dest;
 
-	if(CC_TNULL(void) != (dest = cc_malloc(size)))
+	if(CC_TNULL(void) != (dest = memory_alloc(size, 0)))
 		(void)memcpy(dest, address, size);
 
 	return dest;
 }
 
+extern void  cc_memwipe(void *ptr, size_t size)
+{
+	(void)memset(ptr, 0x00, size);
+	MEMORY_BARRIER(ptr);
+	return;
+}
+
+/*
+ * Shrinking keeps the block. Growing is done in place when the block
+ * has room for it, otherwise through a new block, so that the old one is
+ * wiped instead of being released as is by realloc.
+ */
 extern void *cc_realloc(void *ptr, size_t newsize)
 {
-	unsigned long  i;
-	unsigned long  n;
-	unsigned long  o;
-	unsigned long *p;
-	unsigned long *s;
-
-	p = (unsigned long *)ptr;
-	s = p - 1;
-	o = *s;
-	n = ULONG_SIZE(newsize);
-	if(n < o)
+	struct memory_hdr_st *h;
+	void                 *n;
+
+	if(CC_TNULL(void) == ptr)
+		return cc_malloc(newsize);
+	h = (struct memory_hdr_st *)ptr - 1;
+	if(newsize <= h->mh_size)
 		return ptr;
-	if(CC_TNULL(unsigned long) == (s = p = (unsigned long *)realloc(s, ULONG2BYTES(n))))
+#ifdef __GLIBC__
+	if(newsize <= malloc_usable_size(h) - MEMORY_HDR)
+	{
+		(void)memset((char *)ptr + h->mh_size, 0x00, newsize - h->mh_size);
+		h->mh_size = newsize;
+		return ptr;
+	}
+#endif
+	if(CC_TNULL(void) == (n = memory_alloc(newsize, 0)))
 		return CC_TNULL(void);
-	*(s++) = n;
-	for(i = o, p += o; i < n; *(p++) = 0UL, i += 1);
-	return (void *)s;
+	(void)memcpy(n, ptr, h->mh_size);
+	(void)memset((char *)n + h->mh_size, 0x00, newsize - h->mh_size);
+	cc_free(ptr);
+	return n;
 }
 
 extern char *cc_strdup(const char *string)
 {
 	return (char *)cc_memdup((void *)string, strlen(string) + 1);
 }
+
+/*
+ * Block of size bytes, zeroed if zero is set (callers about to fill it
+ * do not pay the clear twice).
+ */
+static void *memory_alloc(size_t size, int zero)
+{
+	struct memory_hdr_st *h;
+
+	if(size > SIZE_MAX - MEMORY_HDR)
+	{
+		errno = ENOMEM;
+		return CC_TNULL(void);
+	}
+	h = (struct memory_hdr_st *)(zero ? calloc(1, MEMORY_HDR + size) : malloc(MEMORY_HDR + size));
+	if(CC_TNULL(struct memory_hdr_st) == h)
+		return CC_TNULL(void);
+	h->mh_size = size;
+	h->mh_pad  = 0;
+	return (void *)(h + 1);
+}
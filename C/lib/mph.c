@@ -0,0 +1,406 @@
+/*
+ * Copyright (c) 2026
+ *     Christian CAMIER <christian.c at promethee dot services>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/types.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+
+#include <CCA/hash.h>
+#include <CCA/memory.h>
+#include <CCA/mph.h>
+#include <CCA/util.h>
+
+#define MPH_LAMBDA	4		/* Average keys per bucket          */
+#define MPH_SEEDS	32		/* Seeds tried before giving up     */
+#define MPH_TRIES	(1 << 20)	/* Displacements tried per bucket   */
+#define MPH_SEED_STEP	0x9E3779B97F4A7C15ULL
+
+/* Global functions */
+extern int      cc_mph_build    (cc_mph_t *, const void *const *, const size_t *, size_t, int);
+extern void     cc_mph_free     (cc_mph_t *);
+extern uint32_t cc_mph_index    (const cc_mph_t *, const void *, size_t);
+extern uint32_t cc_mph_index_str(const cc_mph_t *, const char *);
+extern int      cc_mph_emit     (FILE *, const cc_mph_t *, const char *, const void *const *, const size_t *, const char *, const char *const *);
+
+/* Local defined functions */
+static uint64_t mph_hash (uint64_t, int, const void *, size_t);
+static void     mph_split(uint64_t, uint32_t, uint32_t, uint32_t *, uint32_t *, uint32_t *);
+static uint32_t mph_pos  (uint32_t, uint32_t, uint32_t, uint32_t, uint32_t);
+static int      mph_equal(int, const void *, size_t, const void *, size_t);
+/* Working arrays of a build */
+struct mph_work_st {
+	uint64_t *mw_hash;		/* Hash of each key                 */
+	uint32_t *mw_order;		/* Keys sorted by bucket            */
+	uint32_t *mw_start;		/* First key of each bucket         */
+	uint32_t *mw_bucket;		/* Buckets sorted by size           */
+	uint32_t *mw_pos;		/* Indexes of the bucket being set  */
+	uint8_t  *mw_taken;		/* Indexes already given            */
+};
+
+static int      mph_try  (cc_mph_t *, uint32_t *, struct mph_work_st *, const void *const *, const size_t *);
+static void     mph_quote(FILE *, const void *, size_t);
+
+int cc_mph_build(cc_mph_t *mph, const void *const *keys, const size_t *lens, size_t count, int flags)
+{
+	struct mph_work_st work;
+	uint32_t          *disp;
+	size_t             len;
+	size_t             i;
+	int                ret = -1;
+	int                st;
+
+	memset(mph, 0, sizeof(*mph));
+	memset(&work, 0, sizeof(work));
+	if(count >= UINT32_MAX)
+	{
+		errno = EINVAL;
+		return -1;
+	}
+	mph->mp_count   = (uint32_t)count;
+	mph->mp_nbucket = (uint32_t)CC_MAX((count + MPH_LAMBDA - 1) / MPH_LAMBDA, 1);
+	mph->mp_flags   = flags;
+	for(i = 0; i < count; i += 1)
+	{
+		len = lens ? lens[i] : strlen((const char *)keys[i]);
+		if(len > UINT32_MAX || ((flags & CC_MPH_ICASE) && len > CC_MPH_ICASE_MAX))
+		{
+			errno = EINVAL;
+			return -1;
+		}
+		mph->mp_maxlen = CC_MAX(mph->mp_maxlen, (uint32_t)len);
+	}
+
+	if(NULL == (disp = CC_TALLOC(uint32_t, 2 * mph->mp_nbucket)))
+		return -1;
+	if(0 == count)
+	{
+		mph->mp_disp = disp;
+		return 0;
+	}
+
+	if(NULL == (work.mw_hash   = CC_TALLOC(uint64_t, count))               ||
+	   NULL == (work.mw_order  = CC_TALLOC(uint32_t, count))               ||
+	   NULL == (work.mw_start  = CC_TALLOC(uint32_t, (mph->mp_nbucket + 1))) ||
+	   NULL == (work.mw_bucket = CC_TALLOC(uint32_t, mph->mp_nbucket))     ||
+	   NULL == (work.mw_pos    = CC_TALLOC(uint32_t, count))               ||
+	   NULL == (work.mw_taken  = CC_TALLOC(uint8_t,  count)))
+		goto end;
+
+	/*
+	 * The seeds are always tried in the same order, so that a set of
+	 * keys always gives the same hash and cc_mph_emit the same code.
+	 */
+	for(i = 0; i < MPH_SEEDS; i += 1)
+	{
+		mph->mp_seed = i * MPH_SEED_STEP;
+		if(0 == (st = mph_try(mph, disp, &work, keys, lens)))
+			break;
+		if(EAGAIN != st)
+		{
+			errno = st;
+			goto end;
+		}
+	}
+	if(MPH_SEEDS == i)
+	{
+		errno = EAGAIN;
+		goto end;
+	}
+	mph->mp_disp = disp;
+	disp         = NULL;
+	ret          = 0;
+ end:
+	if(work.mw_taken)  cc_free(work.mw_taken);
+	if(work.mw_pos)    cc_free(work.mw_pos);
+	if(work.mw_bucket) cc_free(work.mw_bucket);
+	if(work.mw_start)  cc_free(work.mw_start);
+	if(work.mw_order)  cc_free(work.mw_order);
+	if(work.mw_hash)   cc_free(work.mw_hash);
+	if(disp)           cc_free(disp);
+	return ret;
+}
+
+void cc_mph_free(cc_mph_t *mph)
+{
+	if(mph->mp_disp)
+		cc_free((void *)mph->mp_disp);
+	mph->mp_disp = NULL;
+	return;
+}
+
+uint32_t cc_mph_index(const cc_mph_t *mph, const void *key, size_t len)
+{
+	uint32_t b;
+	uint32_t f1;
+	uint32_t f2;
+
+	if(0 == mph->mp_count || len > mph->mp_maxlen)
+		return mph->mp_count;
+	mph_split(mph_hash(mph->mp_seed, mph->mp_flags, key, len), mph->mp_nbucket, mph->mp_count, &b, &f1, &f2);
+	return mph_pos(mph->mp_count, f1, f2, mph->mp_disp[2 * b], mph->mp_disp[2 * b + 1]);
+}
+
+uint32_t cc_mph_index_str(const cc_mph_t *mph, const char *key)
+{
+	return cc_mph_index(mph, key, strlen(key));
+}
+
+int cc_mph_emit(FILE *out, const cc_mph_t *mph, const char *name, const void *const *keys, const size_t *lens, const char *type, const char *const *inits)
+{
+	uint32_t *perm;
+	uint32_t  i;
+	size_t    len;
+
+	if(NULL == (perm = CC_TALLOC(uint32_t, CC_MAX(mph->mp_count, 1))))
+		return -1;
+	for(i = 0; i < mph->mp_count; i += 1)
+	{
+		len = lens ? lens[i] : strlen((const char *)keys[i]);
+		perm[cc_mph_index(mph, keys[i], len)] = i;
+	}
+
+	fprintf(out, "/*\n * Generated by cc_mph_emit%s, do not edit : the indexes\n", (mph->mp_flags & CC_MPH_ICASE) ? " (CC_MPH_ICASE)" : "");
+	fprintf(out, " * depend on cc_hash64, so regenerate when it changes.\n */\n");
+	fprintf(out, "static const uint32_t %s_disp[] = {", name);
+	for(i = 0; i < 2 * mph->mp_nbucket; i += 1)
+		fprintf(out, "%s%u,", (0 == i % 8) ? "\n\t" : " ", mph->mp_disp[i]);
+	fprintf(out, "\n};\n\n");
+	fprintf(out, "static const cc_mph_t %s_mph = {\n", name);
+	fprintf(out, "\t0x%016llXULL, %u, %u, %u, 0x%04X, %s_disp\n};\n",
+		(unsigned long long)mph->mp_seed, mph->mp_count, mph->mp_nbucket, mph->mp_maxlen, mph->mp_flags, name);
+	if(0 != mph->mp_count)
+	{
+		fprintf(out, "\nstatic const %s %s[] = {\n", type, name);
+		for(i = 0; i < mph->mp_count; i += 1)
+		{
+			fprintf(out, "\t");
+			if(inits)
+				fprintf(out, "%s", inits[perm[i]]);
+			else
+				mph_quote(out, keys[perm[i]], lens ? lens[perm[i]] : strlen((const char *)keys[perm[i]]));
+			fprintf(out, ",\n");
+		}
+		fprintf(out, "};\n");
+	}
+	cc_free(perm);
+
+	if(ferror(out))
+	{
+		errno = EIO;
+		return -1;
+	}
+	return 0;
+}
+
+/*
+ * Hash of a key, in upper case for CC_MPH_ICASE sets.
+ */
+static inline uint64_t mph_hash(uint64_t seed, int flags, const void *key, size_t len)
+{
+	const uint8_t *src;
+	uint8_t        buf[CC_MPH_ICASE_MAX];
+	size_t         i;
+
+	if(0 == (flags & CC_MPH_ICASE))
+		return cc_hash64(key, len, seed);
+	for(src = (const uint8_t *)key, i = 0; i < len; i += 1)
+		buf[i] = (src[i] >= 'a' && src[i] <= 'z') ? src[i] - 'a' + 'A' : src[i];
+	return cc_hash64(buf, len, seed);
+}
+
+/*
+ * Bucket and (f1, f2) of a hash, reduced by multiplication instead of
+ * division.
+ */
+static inline void mph_split(uint64_t h, uint32_t nbucket, uint32_t n, uint32_t *b, uint32_t *f1, uint32_t *f2)
+{
+	uint64_t g = h * MPH_SEED_STEP;
+
+	*b  = (uint32_t)(((h >> 32) * nbucket) >> 32);
+	*f1 = (uint32_t)(((h & 0xFFFFFFFF) * n) >> 32);
+	*f2 = (uint32_t)(((g >> 32) * n) >> 32);
+}
+
+static inline uint32_t mph_pos(uint32_t n, uint32_t f1, uint32_t f2, uint32_t d0, uint32_t d1)
+{
+	return (uint32_t)(((uint64_t)f1 + (uint64_t)d0 * f2 + d1) % n);
+}
+
+static int mph_equal(int flags, const void *k1, size_t l1, const void *k2, size_t l2)
+{
+	if(l1 != l2)
+		return 0;
+	if(flags & CC_MPH_ICASE)
+		return 0 == strncasecmp((const char *)k1, (const char *)k2, l1);
+	return 0 == memcmp(k1, k2, l1);
+}
+
+/*
+ * Try to find the displacements with mph->mp_seed. Returns 0, EAGAIN
+ * when the next seed is to be tried, or EINVAL for duplicated keys.
+ *
+ * The buckets are placed from the largest one, while most indexes are
+ * still free. For a given d0 the indexes of a bucket are distinct or
+ * not whatever d1, so d1 only moves them together to free indexes.
+ * The buckets of one key, last ones, just take the free indexes left.
+ */
+static int mph_try(cc_mph_t *mph, uint32_t *disp, struct mph_work_st *work, const void *const *keys, const size_t *lens)
+{
+	uint32_t n = mph->mp_count;
+	uint32_t nbucket = mph->mp_nbucket;
+	uint32_t maxsize;
+	uint32_t next;
+	uint32_t b, f1, f2;
+	uint32_t d0, d1;
+	uint32_t i, j, k;
+	uint32_t first, size;
+	uint32_t p;
+	size_t   tries;
+	size_t   li, lj;
+
+	/* Keys sorted by bucket (counting sort) */
+	memset(work->mw_start, 0, (nbucket + 1) * sizeof(uint32_t));
+	for(i = 0; i < n; i += 1)
+	{
+		work->mw_hash[i] = mph_hash(mph->mp_seed, mph->mp_flags, keys[i], lens ? lens[i] : strlen((const char *)keys[i]));
+		mph_split(work->mw_hash[i], nbucket, n, &b, &f1, &f2);
+		work->mw_start[b + 1] += 1;
+	}
+	for(maxsize = 0, b = 0; b < nbucket; b += 1)
+	{
+		maxsize = CC_MAX(maxsize, work->mw_start[b + 1]);
+		work->mw_start[b + 1] += work->mw_start[b];
+	}
+	for(i = 0; i < n; i += 1)
+	{
+		mph_split(work->mw_hash[i], nbucket, n, &b, &f1, &f2);
+		work->mw_pos[work->mw_start[b]++] = i;
+	}
+	for(b = nbucket; b > 0; b -= 1)
+		work->mw_start[b] = work->mw_start[b - 1];
+	work->mw_start[0] = 0;
+	memcpy(work->mw_order, work->mw_pos, n * sizeof(uint32_t));
+
+	/* Keys of a bucket with the same hash : duplicated or next seed */
+	for(b = 0; b < nbucket; b += 1)
+	{
+		for(i = work->mw_start[b]; i < work->mw_start[b + 1]; i += 1)
+		{
+			for(j = i + 1; j < work->mw_start[b + 1]; j += 1)
+			{
+				if(work->mw_hash[work->mw_order[i]] != work->mw_hash[work->mw_order[j]])
+					continue;
+				li = lens ? lens[work->mw_order[i]] : strlen((const char *)keys[work->mw_order[i]]);
+				lj = lens ? lens[work->mw_order[j]] : strlen((const char *)keys[work->mw_order[j]]);
+				return mph_equal(mph->mp_flags, keys[work->mw_order[i]], li, keys[work->mw_order[j]], lj) ? EINVAL : EAGAIN;
+			}
+		}
+	}
+
+	/* Buckets sorted by decreasing size */
+	for(k = 0, size = maxsize; size > 0; size -= 1)
+		for(b = 0; b < nbucket; b += 1)
+			if(work->mw_start[b + 1] - work->mw_start[b] == size)
+				work->mw_bucket[k++] = b;
+	for(b = 0; b < nbucket; b += 1)
+		if(work->mw_start[b + 1] == work->mw_start[b])
+			work->mw_bucket[k++] = b;
+
+	memset(work->mw_taken, 0, n);
+	memset(disp, 0, 2 * nbucket * sizeof(uint32_t));
+	for(next = 0, k = 0; k < nbucket; k += 1)
+	{
+		b     = work->mw_bucket[k];
+		first = work->mw_start[b];
+		size  = work->mw_start[b + 1] - first;
+		if(0 == size)
+			break;
+
+		if(1 == size)
+		{
+			while(work->mw_taken[next])
+				next += 1;
+			mph_split(work->mw_hash[work->mw_order[first]], nbucket, n, &b, &f1, &f2);
+			disp[2 * b]     = 0;
+			disp[2 * b + 1] = (next + n - f1) % n;
+			work->mw_taken[next] = 1;
+			continue;
+		}
+
+		for(tries = 0, d0 = 0; d0 < n && tries < MPH_TRIES; d0 += 1)
+		{
+			/* Indexes with d1 = 0, which must be distinct */
+			for(i = 0; i < size; i += 1)
+			{
+				mph_split(work->mw_hash[work->mw_order[first + i]], nbucket, n, &p, &f1, &f2);
+				work->mw_pos[i] = mph_pos(n, f1, f2, d0, 0);
+				for(j = 0; j < i && work->mw_pos[j] != work->mw_pos[i]; j += 1);
+				if(j < i)
+					break;
+			}
+			if(i < size)
+				continue;
+
+			for(d1 = 0; d1 < n && tries < MPH_TRIES; d1 += 1, tries += 1)
+			{
+				for(i = 0; i < size; i += 1)
+				{
+					p = work->mw_pos[i] + d1;
+					if(work->mw_taken[p >= n ? p - n : p])
+						break;
+				}
+				if(i == size)
+					goto found;
+			}
+		}
+		return EAGAIN;
+
+	found:
+		for(i = 0; i < size; i += 1)
+		{
+			p = work->mw_pos[i] + d1;
+			work->mw_taken[p >= n ? p - n : p] = 1;
+		}
+		disp[2 * b]     = d0;
+		disp[2 * b + 1] = d1;
+	}
+	return 0;
+}
+
+/*
+ * Key as a C string literal.
+ */
+static void mph_quote(FILE *out, const void *key, size_t len)
+{
+	const uint8_t *c = (const uint8_t *)key;
+	size_t         i;
+
+	fputc('"', out);
+	for(i = 0; i < len; i += 1)
+	{
+		if('"' == c[i] || '\\' == c[i])
+			fprintf(out, "\\%c", c[i]);
+		else if(c[i] >= ' ' && c[i] < 0x7F)
+			fputc(c[i], out);
+		else
+			fprintf(out, "\\%03o", c[i]);
+	}
+	fputc('"', out);
+}
@@ -0,0 +1,460 @@
+/*
+ * Copyright (c) 2026
+ *     Christian CAMIER <christian.c at promethee dot services>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/types.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <CCA/memory.h>
+#include <CCA/util.h>
+
+#define __CC_POOL_INTERNAL__
+#include <CCA/pool.h>
+
+/*
+ * The depot stacks hold magazine numbers, not pointers : the head is
+ * the number + 1 of the top magazine in its low 32 bits and a counter
+ * incremented by every change in its high 32 bits, so that a head seen
+ * before a pop and a push of the same magazine no longer matches (ABA).
+ * Magazines are found from their number in po_dir, and never freed
+ * before the pool, so a stale magazine can always be read.
+ */
+#define POOL_DIR_BLOCK	256		/* Magazines by block of po_dir     */
+#define POOL_DIR_SIZE	4096		/* Blocks of po_dir                 */
+#define POOL_SLAB_MAGS	4		/* Default magazines by slab        */
+
+#define POOL_LOAD(p)	 __atomic_load_n(&(p), __ATOMIC_ACQUIRE)
+#define POOL_ADD(p, n)	 (void)__atomic_add_fetch(&(p), n, __ATOMIC_RELAXED)
+#define POOL_SUB(p, n)	 (void)__atomic_sub_fetch(&(p), n, __ATOMIC_RELAXED)
+
+/* Local datatypes definition */
+struct pool_magazine_st {
+	uint32_t    pm_index;			/* Number of the magazine           */
+	uint32_t    pm_next;			/* Next in a depot stack, + 1       */
+	size_t      pm_count;
+	void       *pm_obj[CC_POOL_MAGAZINE];
+};
+
+struct pool_slab_st {
+	struct pool_slab_st *ps_next;
+};
+
+/* Free object no magazine could take */
+struct pool_loose_st {
+	struct pool_loose_st *pl_next;
+};
+
+struct pool_st {
+	uint64_t                  po_full;	/* Depot of full magazines          */
+	uint64_t                  po_empty;	/* Depot of empty magazines         */
+	char                      po_pad[64];
+	size_t                    po_size;
+	size_t                    po_align;
+	size_t                    po_slab;	/* Objects by slab                  */
+	uint64_t                  po_gen;	/* Unique, see pool_cache           */
+	unsigned                  po_id;
+	pthread_mutex_t           po_grow;	/* Slabs, po_dir and po_loose       */
+	struct pool_slab_st      *po_slabs;
+	struct pool_loose_st     *po_loose;
+	uint32_t                  po_nmag;	/* Magazines created                */
+	size_t                    po_nslab;
+	size_t                    po_objects;
+	size_t                    po_depot;
+	size_t                    po_exchanges;
+	struct pool_magazine_st  *po_dir[POOL_DIR_SIZE];
+};
+
+/*
+ * Magazines of a thread for the pool of number po_id. pc_gen is the
+ * po_gen of the pool they belong to : a cache left by a destroyed pool
+ * is dropped when its number is reused.
+ */
+struct pool_cache_st {
+	uint64_t                  pc_gen;
+	struct pool_magazine_st  *pc_loaded;
+	struct pool_magazine_st  *pc_previous;
+};
+
+/* Global functions */
+extern CC_POOL cc_pool_create (size_t, size_t, size_t);
+extern void    cc_pool_destroy(CC_POOL);
+extern void   *cc_pool_alloc  (CC_POOL);
+extern void    cc_pool_free   (CC_POOL, void *);
+extern void    cc_pool_stats  (CC_POOL, cc_pool_stats_t *);
+
+/* Local defined functions */
+static struct pool_cache_st    *pool_cache    (CC_POOL);
+static void                     pool_init     (void);
+static void                     pool_release  (void *);
+static void                     pool_flush    (CC_POOL, struct pool_cache_st *);
+static void                     pool_push     (CC_POOL, uint64_t *, struct pool_magazine_st *);
+static struct pool_magazine_st *pool_pop      (CC_POOL, uint64_t *);
+static struct pool_magazine_st *pool_magazine (CC_POOL);
+static struct pool_magazine_st *pool_slab     (CC_POOL);
+
+/* LOcal data */
+static pthread_mutex_t       pool_mutex[1] = { PTHREAD_MUTEX_INITIALIZER };
+static CC_POOL               pool_registry[CC_POOL_MAX];	/* Under pool_mutex */
+static uint64_t              pool_generation = 0;
+static pthread_once_t        pool_once = PTHREAD_ONCE_INIT;
+static pthread_key_t         pool_key;
+static __thread int          pool_registered;
+static __thread struct pool_cache_st pool_caches[CC_POOL_MAX];
+
+CC_POOL cc_pool_create(size_t size, size_t align, size_t slab)
+{
+	CC_POOL  pool;
+	unsigned id;
+
+	if(0 == align)
+		align = CC_POOL_ALIGN;
+	if(0 == size || 0 != (align & (align - 1)) || size > SIZE_MAX / 2)
+	{
+		errno = EINVAL;
+		return NULL;
+	}
+	if(0 == slab)
+		slab = POOL_SLAB_MAGS * CC_POOL_MAGAZINE;
+	slab = CC_MAX((slab + CC_POOL_MAGAZINE - 1) / CC_POOL_MAGAZINE, 1) * CC_POOL_MAGAZINE;
+
+	if(NULL == (pool = CC_TALLOC(struct pool_st, 1)))
+		return NULL;
+	pool->po_size  = (CC_MAX(size, sizeof(struct pool_loose_st)) + align - 1) & ~(align - 1);
+	pool->po_align = align;
+	pool->po_slab  = slab;
+	pthread_mutex_init(&(pool->po_grow), NULL);
+
+	pthread_mutex_lock(pool_mutex);
+	for(id = 0; id < CC_POOL_MAX && NULL != pool_registry[id]; id += 1);
+	if(CC_POOL_MAX != id)
+	{
+		pool->po_id       = id;
+		pool->po_gen      = ++pool_generation;
+		pool_registry[id] = pool;
+	}
+	pthread_mutex_unlock(pool_mutex);
+	if(CC_POOL_MAX == id)
+	{
+		pthread_mutex_destroy(&(pool->po_grow));
+		cc_free(pool);
+		errno = EAGAIN;
+		return NULL;
+	}
+	return pool;
+}
+
+void cc_pool_destroy(CC_POOL pool)
+{
+	struct pool_slab_st *slab;
+	size_t               ix;
+
+	pthread_mutex_lock(pool_mutex);
+	pool_registry[pool->po_id] = NULL;
+	pthread_mutex_unlock(pool_mutex);
+
+	while(NULL != (slab = pool->po_slabs))
+	{
+		pool->po_slabs = slab->ps_next;
+		free(slab);
+	}
+	for(ix = 0; ix < POOL_DIR_SIZE && NULL != pool->po_dir[ix]; ix += 1)
+		cc_free(pool->po_dir[ix]);
+	pthread_mutex_destroy(&(pool->po_grow));
+	cc_free(pool);
+	return;
+}
+
+void *cc_pool_alloc(CC_POOL pool)
+{
+	struct pool_cache_st    *cache = pool_cache(pool);
+	struct pool_magazine_st *mag;
+	struct pool_loose_st    *obj;
+
+	if(NULL == (mag = cache->pc_loaded) || 0 == mag->pm_count)
+	{
+		if(NULL != cache->pc_previous && 0 != cache->pc_previous->pm_count)
+		{
+			cache->pc_loaded   = cache->pc_previous;
+			cache->pc_previous = mag;
+		}
+		else
+		{
+			if(NULL == (mag = pool_pop(pool, &(pool->po_full))))
+			{
+				pthread_mutex_lock(&(pool->po_grow));
+				if(NULL != (obj = pool->po_loose))
+					pool->po_loose = obj->pl_next;
+				pthread_mutex_unlock(&(pool->po_grow));
+				if(NULL != obj)
+					return obj;
+				if(NULL == (mag = pool_slab(pool)))
+					return NULL;
+			}
+			else
+			{
+				POOL_SUB(pool->po_depot, mag->pm_count);
+			}
+			POOL_ADD(pool->po_exchanges, 1);
+			if(NULL != cache->pc_previous)
+				pool_push(pool, &(pool->po_empty), cache->pc_previous);
+			cache->pc_previous = cache->pc_loaded;
+			cache->pc_loaded   = mag;
+		}
+	}
+	mag = cache->pc_loaded;
+	return mag->pm_obj[--mag->pm_count];
+}
+
+void cc_pool_free(CC_POOL pool, void *object)
+{
+	struct pool_cache_st    *cache = pool_cache(pool);
+	struct pool_magazine_st *mag;
+	struct pool_loose_st    *obj;
+
+	if(NULL == (mag = cache->pc_loaded) || CC_POOL_MAGAZINE == mag->pm_count)
+	{
+		if(NULL != cache->pc_previous && CC_POOL_MAGAZINE != cache->pc_previous->pm_count)
+		{
+			cache->pc_loaded   = cache->pc_previous;
+			cache->pc_previous = mag;
+		}
+		else if(NULL == (mag = pool_pop(pool, &(pool->po_empty))) && NULL == (mag = pool_magazine(pool)))
+		{
+			obj = (struct pool_loose_st *)object;
+			pthread_mutex_lock(&(pool->po_grow));
+			obj->pl_next   = pool->po_loose;
+			pool->po_loose = obj;
+			pthread_mutex_unlock(&(pool->po_grow));
+			return;
+		}
+		else
+		{
+			POOL_ADD(pool->po_exchanges, 1);
+			if(NULL != cache->pc_previous)
+			{
+				POOL_ADD(pool->po_depot, cache->pc_previous->pm_count);
+				pool_push(pool, &(pool->po_full), cache->pc_previous);
+			}
+			cache->pc_previous = cache->pc_loaded;
+			cache->pc_loaded   = mag;
+		}
+	}
+	mag = cache->pc_loaded;
+	mag->pm_obj[mag->pm_count++] = object;
+	return;
+}
+
+void cc_pool_stats(CC_POOL pool, cc_pool_stats_t *stats)
+{
+	stats->ps_size      = pool->po_size;
+	stats->ps_slabs     = __atomic_load_n(&(pool->po_nslab),     __ATOMIC_RELAXED);
+	stats->ps_objects   = __atomic_load_n(&(pool->po_objects),   __ATOMIC_RELAXED);
+	stats->ps_depot     = __atomic_load_n(&(pool->po_depot),     __ATOMIC_RELAXED);
+	stats->ps_exchanges = __atomic_load_n(&(pool->po_exchanges), __ATOMIC_RELAXED);
+	return;
+}
+
+/*
+ * Magazines of the calling thread for the pool. They go back to the
+ * depot when the thread terminates.
+ */
+static inline struct pool_cache_st *pool_cache(CC_POOL pool)
+{
+	struct pool_cache_st *cache = pool_caches + pool->po_id;
+
+	if(pool->po_gen != cache->pc_gen)
+	{
+		if(!pool_registered)
+		{
+			pthread_once(&pool_once, pool_init);
+			pthread_setspecific(pool_key, pool_caches);
+			pool_registered = 1;
+		}
+		cache->pc_gen      = pool->po_gen;
+		cache->pc_loaded   = NULL;
+		cache->pc_previous = NULL;
+	}
+	return cache;
+}
+
+static void pool_init(void)
+{
+	pthread_key_create(&pool_key, pool_release);
+	return;
+}
+
+/*
+ * The registry lock keeps the pools from being destroyed while the
+ * magazines go back to their depots.
+ */
+static void pool_release(void *arg)
+{
+	struct pool_cache_st *caches = (struct pool_cache_st *)arg;
+	unsigned              id;
+
+	pthread_mutex_lock(pool_mutex);
+	for(id = 0; id < CC_POOL_MAX; id += 1)
+	{
+		if(NULL != pool_registry[id] && pool_registry[id]->po_gen == caches[id].pc_gen)
+			pool_flush(pool_registry[id], caches + id);
+		caches[id].pc_gen = 0;
+	}
+	pthread_mutex_unlock(pool_mutex);
+	return;
+}
+
+static void pool_flush(CC_POOL pool, struct pool_cache_st *cache)
+{
+	struct pool_magazine_st *mags[2];
+	size_t                   ix;
+
+	mags[0] = cache->pc_loaded;
+	mags[1] = cache->pc_previous;
+	cache->pc_loaded   = NULL;
+	cache->pc_previous = NULL;
+	for(ix = 0; ix < CC_ARRAY_COUNT(mags); ix += 1)
+	{
+		if(NULL == mags[ix])
+			continue;
+		if(0 == mags[ix]->pm_count)
+		{
+			pool_push(pool, &(pool->po_empty), mags[ix]);
+		}
+		else
+		{
+			POOL_ADD(pool->po_depot, mags[ix]->pm_count);
+			pool_push(pool, &(pool->po_full), mags[ix]);
+		}
+	}
+	return;
+}
+
+static void pool_push(CC_POOL pool, uint64_t *head, struct pool_magazine_st *mag)
+{
+	uint64_t old;
+	uint64_t new;
+
+	(void)pool;
+	old = POOL_LOAD(*head);
+	do {
+		__atomic_store_n(&(mag->pm_next), (uint32_t)old, __ATOMIC_RELAXED);
+		new = (((old >> 32) + 1) << 32) | (mag->pm_index + 1);
+	} while(!__atomic_compare_exchange_n(head, &old, new, 1, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE));
+	return;
+}
+
+static struct pool_magazine_st *pool_pop(CC_POOL pool, uint64_t *head)
+{
+	struct pool_magazine_st *mag;
+	uint64_t                 old;
+	uint64_t                 new;
+	uint32_t                 ix;
+
+	old = POOL_LOAD(*head);
+	do {
+		if(0 == (ix = (uint32_t)old))
+			return NULL;
+		ix -= 1;
+		mag = POOL_LOAD(pool->po_dir[ix / POOL_DIR_BLOCK]) + ix % POOL_DIR_BLOCK;
+		new = (((old >> 32) + 1) << 32) | __atomic_load_n(&(mag->pm_next), __ATOMIC_RELAXED);
+	} while(!__atomic_compare_exchange_n(head, &old, new, 1, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE));
+	return mag;
+}
+
+/*
+ * New empty magazine. Magazines are created by blocks, published in
+ * po_dir before any of them can be pushed.
+ */
+static struct pool_magazine_st *pool_magazine(CC_POOL pool)
+{
+	struct pool_magazine_st *block;
+	struct pool_magazine_st *mag = NULL;
+	uint32_t                 ix;
+
+	pthread_mutex_lock(&(pool->po_grow));
+	ix = pool->po_nmag;
+	if(ix / POOL_DIR_BLOCK < POOL_DIR_SIZE)
+	{
+		if(NULL == (block = pool->po_dir[ix / POOL_DIR_BLOCK]))
+		{
+			if(NULL != (block = CC_TALLOC(struct pool_magazine_st, POOL_DIR_BLOCK)))
+				__atomic_store_n(&(pool->po_dir[ix / POOL_DIR_BLOCK]), block, __ATOMIC_RELEASE);
+		}
+		if(NULL != block)
+		{
+			mag           = block + ix % POOL_DIR_BLOCK;
+			mag->pm_index = ix;
+			mag->pm_count = 0;
+			pool->po_nmag = ix + 1;
+		}
+	}
+	pthread_mutex_unlock(&(pool->po_grow));
+	return mag;
+}
+
+/*
+ * Carve a new slab into full magazines : one is returned, the other
+ * ones go to the depot.
+ */
+static struct pool_magazine_st *pool_slab(CC_POOL pool)
+{
+	struct pool_magazine_st *first = NULL;
+	struct pool_magazine_st *mag;
+	struct pool_slab_st     *slab;
+	uintptr_t                addr;
+	size_t                   hdr;
+	size_t                   ix;
+	size_t                   nx;
+
+	hdr = (sizeof(struct pool_slab_st) + pool->po_align - 1) & ~(pool->po_align - 1);
+	if(NULL == (slab = (struct pool_slab_st *)malloc(hdr + pool->po_slab * pool->po_size + pool->po_align - 1)))
+		return NULL;
+	addr = ((uintptr_t)slab + hdr + pool->po_align - 1) & ~(uintptr_t)(pool->po_align - 1);
+
+	/* Filled in reverse so that the objects are taken in address order */
+	for(ix = 0; ix < pool->po_slab; ix += CC_POOL_MAGAZINE)
+	{
+		if(NULL == (mag = pool_magazine(pool)))
+			break;
+		for(nx = 0; nx < CC_POOL_MAGAZINE; nx += 1)
+			mag->pm_obj[CC_POOL_MAGAZINE - 1 - nx] = (void *)(addr + (ix + nx) * pool->po_size);
+		mag->pm_count = CC_POOL_MAGAZINE;
+		if(NULL == first)
+		{
+			first = mag;
+			continue;
+		}
+		POOL_ADD(pool->po_depot, CC_POOL_MAGAZINE);
+		pool_push(pool, &(pool->po_full), mag);
+	}
+	if(NULL == first)
+	{
+		free(slab);
+		return NULL;
+	}
+
+	pthread_mutex_lock(&(pool->po_grow));
+	slab->ps_next  = pool->po_slabs;
+	pool->po_slabs = slab;
+	pthread_mutex_unlock(&(pool->po_grow));
+	POOL_ADD(pool->po_nslab, 1);
+	POOL_ADD(pool->po_objects, ix);
+	return first;
+}
@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2026
+ *     Christian CAMIER <christian.c at promethee dot services>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <CCA/memory.h>
+#include <CCA/secure.h>
+#include <CCA/util.h>
+
+/*
+ * A region is mapped as a guard page, sr_size bytes holding the region
+ * header then the blocks, and a guard page. Every block starts with a
+ * SECURE_HDR bytes header : its size (header included) and its region
+ * while it is allocated, the next free block of the region while it is
+ * free. The free blocks of a region are kept by address, so that a
+ * released block is merged with its free neighbours.
+ *
+ * Free memory is always zero : mmap gives zero pages, blocks are wiped
+ * when released and the header of a block merged into another one is
+ * wiped as well. cc_secure_alloc has nothing to clear.
+ */
+#define SECURE_HDR	CC_SECURE_ALIGN
+#define SECURE_MIN	(2 * SECURE_HDR)	/* Smallest block split off         */
+#define SECURE_LARGE	(CC_SECURE_REGION / 4)	/* Blocks given their own region    */
+#define SECURE_ROUND(n, a) (((n) + (a) - 1) & ~((size_t)(a) - 1))
+
+/* Local datatypes definition */
+struct secure_region_st;
+
+struct secure_block_st {
+	size_t                       sb_size;
+	union {
+		struct secure_region_st *sb_region;	/* Allocated        */
+		struct secure_block_st  *sb_next;	/* Free             */
+	} sb_u;
+};
+
+struct secure_region_st {
+	struct secure_region_st *sr_next;
+	void                    *sr_map;	/* Mapping, guard pages included    */
+	size_t                   sr_maplen;
+	size_t                   sr_size;	/* Bytes between the guard pages    */
+	int                      sr_locked;
+	int                      sr_single;	/* One block, unmapped when freed   */
+	struct secure_block_st  *sr_free;	/* Free blocks, by address          */
+};
+
+#define SECURE_RHDR	SECURE_ROUND(sizeof(struct secure_region_st), CC_SECURE_ALIGN)
+
+/* Global functions */
+extern void *cc_secure_alloc(size_t);
+extern void  cc_secure_free (void *);
+extern void  cc_secure_stats(cc_secure_stats_t *);
+
+/* Local defined functions */
+static struct secure_region_st *secure_region(size_t, int);
+static void                     secure_unmap (struct secure_region_st *);
+static void                    *secure_carve (struct secure_region_st *, size_t);
+static void                     secure_merge (struct secure_region_st *, struct secure_block_st *);
+
+/* LOcal data */
+static pthread_mutex_t          secure_lock    = PTHREAD_MUTEX_INITIALIZER;
+static struct secure_region_st *secure_regions = NULL;
+static cc_secure_stats_t        secure_counts;
+
+void *cc_secure_alloc(size_t size)
+{
+	struct secure_region_st *r;
+	void                    *p;
+	size_t                   need;
+
+	if(size > SIZE_MAX / 2)
+	{
+		errno = ENOMEM;
+		return NULL;
+	}
+	need = SECURE_HDR + SECURE_ROUND(CC_MAX(size, 1), CC_SECURE_ALIGN);
+
+	if(need > SECURE_LARGE)
+	{
+		if(NULL == (r = secure_region(need, 1)))
+			return NULL;
+		p = secure_carve(r, r->sr_free->sb_size);
+		pthread_mutex_lock(&secure_lock);
+		r->sr_next     = secure_regions;
+		secure_regions = r;
+		secure_counts.ss_used += r->sr_size - SECURE_RHDR;
+		pthread_mutex_unlock(&secure_lock);
+		return p;
+	}
+
+	pthread_mutex_lock(&secure_lock);
+	for(p = NULL, r = secure_regions; NULL == p && NULL != r; r = r->sr_next)
+		if(!r->sr_single)
+			p = secure_carve(r, need);
+	if(NULL == p && NULL != (r = secure_region(CC_SECURE_REGION - SECURE_RHDR, 0)))
+	{
+		r->sr_next     = secure_regions;
+		secure_regions = r;
+		p = secure_carve(r, need);
+	}
+	if(NULL != p)
+		secure_counts.ss_used += ((struct secure_block_st *)p - 1)->sb_size;
+	pthread_mutex_unlock(&secure_lock);
+	return p;
+}
+
+void cc_secure_free(void *ptr)
+{
+	struct secure_block_st   *b;
+	struct secure_region_st  *r;
+	struct secure_region_st **pr;
+
+	if(NULL == ptr)
+		return;
+	b = (struct secure_block_st *)ptr - 1;
+	r = b->sb_u.sb_region;
+	cc_memwipe(ptr, b->sb_size - SECURE_HDR);
+
+	pthread_mutex_lock(&secure_lock);
+	secure_counts.ss_used -= b->sb_size;
+	if(r->sr_single)
+	{
+		for(pr = &secure_regions; *pr != r; pr = &(*pr)->sr_next);
+		*pr = r->sr_next;
+	}
+	else
+		secure_merge(r, b);
+	pthread_mutex_unlock(&secure_lock);
+
+	if(r->sr_single)
+		secure_unmap(r);
+	return;
+}
+
+void cc_secure_stats(cc_secure_stats_t *stats)
+{
+	pthread_mutex_lock(&secure_lock);
+	*stats = secure_counts;
+	pthread_mutex_unlock(&secure_lock);
+	return;
+}
+
+/*
+ * Map a region with room for need bytes of blocks. The counters are
+ * updated under secure_lock, which single regions are mapped without.
+ */
+static struct secure_region_st *secure_region(size_t need, int single)
+{
+	struct secure_region_st *r;
+	struct secure_block_st  *b;
+	size_t                   page;
+	size_t                   size;
+	char                    *map;
+	int                      locked;
+
+	page = (size_t)sysconf(_SC_PAGESIZE);
+	if(need > SIZE_MAX - SECURE_RHDR - 3 * page)
+	{
+		errno = ENOMEM;
+		return NULL;
+	}
+	size = SECURE_ROUND(SECURE_RHDR + need, page);
+	map  = (char *)mmap(NULL, size + 2 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(MAP_FAILED == (void *)map)
+		return NULL;
+	if(0 != mprotect(map, page, PROT_NONE) || 0 != mprotect(map + page + size, page, PROT_NONE))
+	{
+		CC_PROTECT_ERRNO((void)munmap(map, size + 2 * page));
+		return NULL;
+	}
+	locked = (0 == mlock(map + page, size));
+#ifdef MADV_DONTDUMP
+	(void)madvise(map + page, size, MADV_DONTDUMP);
+#endif
+
+	r = (struct secure_region_st *)(map + page);
+	r->sr_next   = NULL;
+	r->sr_map    = map;
+	r->sr_maplen = size + 2 * page;
+	r->sr_size   = size;
+	r->sr_locked = locked;
+	r->sr_single = single;
+	r->sr_free   = b = (struct secure_block_st *)(map + page + SECURE_RHDR);
+	b->sb_size   = size - SECURE_RHDR;
+
+	if(single)
+		pthread_mutex_lock(&secure_lock);
+	secure_counts.ss_regions  += 1;
+	secure_counts.ss_mapped   += size;
+	secure_counts.ss_unlocked += locked ? 0 : size;
+	if(single)
+		pthread_mutex_unlock(&secure_lock);
+	return r;
+}
+
+/*
+ * Give a single region back to the system. munmap unlocks it.
+ */
+static void secure_unmap(struct secure_region_st *r)
+{
+	void   *map    = r->sr_map;
+	size_t  maplen = r->sr_maplen;
+
+	pthread_mutex_lock(&secure_lock);
+	secure_counts.ss_regions  -= 1;
+	secure_counts.ss_mapped   -= r->sr_size;
+	secure_counts.ss_unlocked -= r->sr_locked ? 0 : r->sr_size;
+	pthread_mutex_unlock(&secure_lock);
+	cc_memwipe(r, SECURE_RHDR);
+	(void)munmap(map, maplen);
+	return;
+}
+
+/*
+ * First free block of the region holding need bytes, split when the
+ * rest is worth it.
+ */
+static void *secure_carve(struct secure_region_st *r, size_t need)
+{
+	struct secure_block_st **pb;
+	struct secure_block_st  *b;
+	struct secure_block_st  *n;
+
+	for(pb = &r->sr_free; NULL != (b = *pb) && b->sb_size < need; pb = &b->sb_u.sb_next);
+	if(NULL == b)
+		return NULL;
+	if(b->sb_size - need >= SECURE_MIN)
+	{
+		n = (struct secure_block_st *)((char *)b + need);
+		n->sb_size      = b->sb_size - need;
+		n->sb_u.sb_next = b->sb_u.sb_next;
+		b->sb_size      = need;
+		*pb             = n;
+	}
+	else
+		*pb = b->sb_u.sb_next;
+	b->sb_u.sb_region = r;
+	return (void *)(b + 1);
+}
+
+/*
+ * Put a wiped block back in the free list of its region.
+ */
+static void secure_merge(struct secure_region_st *r, struct secure_block_st *b)
+{
+	struct secure_block_st **pb;
+	struct secure_block_st  *p;
+	struct secure_block_st  *n;
+
+	for(p = NULL, pb = &r->sr_free; NULL != (n = *pb) && n < b; p = n, pb = &n->sb_u.sb_next);
+	b->sb_u.sb_next = n;
+	*pb = b;
+	if(NULL != n && (char *)b + b->sb_size == (char *)n)
+	{
+		b->sb_size     += n->sb_size;
+		b->sb_u.sb_next = n->sb_u.sb_next;
+		cc_memwipe(n, SECURE_HDR);
+	}
+	if(NULL != p && (char *)p + p->sb_size == (char *)b)
+	{
+		p->sb_size     += b->sb_size;
+		p->sb_u.sb_next = b->sb_u.sb_next;
+		cc_memwipe(b, SECURE_HDR);
+	}
+	return;
+}
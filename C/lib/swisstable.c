@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2026
+ *     Christian CAMIER <christian.c at promethee dot services>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * The hash of a key is split in two parts :
+ *  - H1 (hash >> 7) selects the first group of slots to probe,
+ *  - H2 (hash & 0x7F) is stored in the control byte of the slot.
+ * Groups are probed in triangular order (g, g + 1, g + 3, g + 6, ...),
+ * which visits every group since their number is a power of two. A
+ * probe stops at the first group holding an empty slot.
+ *
+ * A deleted slot becomes empty when its group has an empty slot (no
+ * probe sequence can go through that group), otherwise it becomes a
+ * tombstone, reclaimed at the next rehash.
+ */
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <CCA/hash.h>
+#include <CCA/memory.h>
+#include <CCA/util.h>
+
+#define __CC_SWISSTABLE_INTERNAL__
+#include <CCA/swisstable.h>
+
+/* Control bytes */
+#define CTRL_EMPTY	((uint8_t)0x80)
+#define CTRL_DELETED	((uint8_t)0xFE)
+#define CTRL_ISFULL(C)	(0 == ((C) & 0x80))
+
+#define HASH_H1(H)	((H) >> 7)
+#define HASH_H2(H)	((uint8_t)((H) & 0x7F))
+
+/*
+ * Group matching. A mask has one bit (SSE2) or one byte (SWAR) per
+ * matching slot of the group, MASK_NEXT returns the index of the lowest
+ * one.
+ */
+#if defined(__SSE2__)
+
+#define GROUP_WIDTH	16
+typedef uint32_t group_mask_t;
+
+static inline group_mask_t group_match(const uint8_t *ctrl, uint8_t h2)
+{
+	__m128i g = _mm_loadu_si128((const __m128i *)ctrl);
+	return (group_mask_t)_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8((char)h2)));
+}
+
+static inline group_mask_t group_empty(const uint8_t *ctrl)
+{
+	__m128i g = _mm_loadu_si128((const __m128i *)ctrl);
+	return (group_mask_t)_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8((char)CTRL_EMPTY)));
+}
+
+static inline group_mask_t group_free(const uint8_t *ctrl)
+{
+	return (group_mask_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)ctrl));
+}
+
+#define MASK_NEXT(M)	((size_t)__builtin_ctz(M))
+
+#else /* !__SSE2__ */
+
+#define GROUP_WIDTH	8
+typedef uint64_t group_mask_t;
+
+#define SWAR_LSB	0x0101010101010101ULL
+#define SWAR_MSB	0x8080808080808080ULL
+
+static inline uint64_t group_load(const uint8_t *ctrl)
+{
+	uint64_t g;
+
+	(void)memcpy(&g, ctrl, sizeof(g));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	g = __builtin_bswap64(g);
+#endif
+	return g;
+}
+
+/*
+ * May report false positives just above a true match : they are
+ * eliminated by the key comparison.
+ */
+static inline group_mask_t group_match(const uint8_t *ctrl, uint8_t h2)
+{
+	uint64_t x = group_load(ctrl) ^ (SWAR_LSB * h2);
+	return (x - SWAR_LSB) & ~x & SWAR_MSB;
+}
+
+static inline group_mask_t group_empty(const uint8_t *ctrl)
+{
+	uint64_t g = group_load(ctrl);
+	return g & ~(g << 6) & SWAR_MSB;
+}
+
+static inline group_mask_t group_free(const uint8_t *ctrl)
+{
+	uint64_t g = group_load(ctrl);
+	return g & ~(g << 7) & SWAR_MSB;
+}
+
+#define MASK_NEXT(M)	((size_t)__builtin_ctzll(M) / 8)
+
+#endif /* __SSE2__ */
+
+#define MASK_DROP(M)	((M) & ((M) - 1))
+
+/* Smallest capacity and maximum load (7/8) */
+#define MIN_CAPACITY	(2 * GROUP_WIDTH)
+#define MAX_LOAD(C)	((C) - (C) / 8)
+
+/* Local datatypes definition */
+struct swiss_slot_st {
+	const void *ss_key;
+	void       *ss_data;
+};
+
+struct swiss_table_st {
+	cc_swisstable_comp_t  st_comp;
+	cc_swisstable_hash_t  st_hash;
+	cc_swisstable_free_t  st_free;
+	size_t                st_mask;	/* Number of groups - 1         */
+	size_t                st_count;	/* Entries                      */
+	size_t                st_left;	/* Empty slots still usable     */
+	uint8_t              *st_ctrl;	/* Control bytes                */
+	struct swiss_slot_st *st_slots;	/* Slots                        */
+};
+
+/* Global functions */
+extern CC_SWISSTABLE          cc_swisstable_create (size_t, cc_swisstable_comp_t, cc_swisstable_hash_t, cc_swisstable_free_t);
+extern void                   cc_swisstable_destroy(CC_SWISSTABLE);
+extern cc_swisstable_status_t cc_swisstable_add    (CC_SWISSTABLE, const void *, void  *);
+extern cc_swisstable_status_t cc_swisstable_del    (CC_SWISSTABLE, const void *, void **);
+extern cc_swisstable_status_t cc_swisstable_search (CC_SWISSTABLE, const void *, void **);
+extern size_t                 cc_swisstable_count  (CC_SWISSTABLE);
+
+/* Local defined functions */
+static size_t table_find  (CC_SWISSTABLE, const void *, uint64_t);
+static size_t table_insert(CC_SWISSTABLE, uint64_t);
+static int    table_resize(CC_SWISSTABLE, size_t);
+static int    table_arrays(size_t, uint8_t **, struct swiss_slot_st **);
+
+#define NOT_FOUND	((size_t)-1)
+
+CC_SWISSTABLE cc_swisstable_create(size_t size, cc_swisstable_comp_t fn_comp, cc_swisstable_hash_t fn_hash, cc_swisstable_free_t fn_free)
+{
+	CC_SWISSTABLE table;
+	size_t        capacity;
+
+	for(capacity = MIN_CAPACITY; MAX_LOAD(capacity) < size; capacity *= 2);
+
+	if(NULL == (table = CC_TALLOC(struct swiss_table_st, 1)))
+		return NULL;
+	if(0 != table_arrays(capacity, &(table->st_ctrl), &(table->st_slots)))
+	{
+		cc_free(table);
+		return NULL;
+	}
+	table->st_comp  = fn_comp ? fn_comp : (cc_swisstable_comp_t)strcmp;
+	table->st_hash  = fn_hash ? fn_hash : cc_hash64_key;
+	table->st_free  = fn_free;
+	table->st_mask  = capacity / GROUP_WIDTH - 1;
+	table->st_count = 0;
+	table->st_left  = MAX_LOAD(capacity);
+	return table;
+}
+
+void cc_swisstable_destroy(CC_SWISSTABLE table)
+{
+	size_t capacity = (table->st_mask + 1) * GROUP_WIDTH;
+	size_t ix;
+
+	if(table->st_free)
+		for(ix = 0; ix < capacity; ix += 1)
+			if(CTRL_ISFULL(table->st_ctrl[ix]))
+				table->st_free(table->st_slots[ix].ss_data);
+	cc_free(table->st_ctrl);
+	cc_free(table);
+	return;
+}
+
+cc_swisstable_status_t cc_swisstable_add(CC_SWISSTABLE table, const void *key, void *data)
+{
+	uint64_t hval = table->st_hash(key);
+	size_t   slot;
+
+	if(NOT_FOUND != table_find(table, key, hval))
+		return CC_SWISSTABLE_DUPKEY;
+
+	if(0 == table->st_left)
+	{
+		/*
+		 * Grow, unless tombstones hold enough room to rehash in place.
+		 */
+		size_t capacity = (table->st_mask + 1) * GROUP_WIDTH;
+		if(0 != table_resize(table, (table->st_count * 2 < MAX_LOAD(capacity)) ? capacity : capacity * 2))
+			return CC_SWISSTABLE_SYSERR;
+	}
+
+	slot = table_insert(table, hval);
+	table->st_slots[slot].ss_key  = key;
+	table->st_slots[slot].ss_data = data;
+	table->st_count += 1;
+	return CC_SWISSTABLE_OK;
+}
+
+cc_swisstable_status_t cc_swisstable_del(CC_SWISSTABLE table, const void *key, void **deleted)
+{
+	size_t   slot;
+	size_t   group;
+	void    *data;
+
+	if(NOT_FOUND == (slot = table_find(table, key, table->st_hash(key))))
+		return CC_SWISSTABLE_NOENT;
+
+	group = slot & ~(size_t)(GROUP_WIDTH - 1);
+	if(group_empty(table->st_ctrl + group))
+	{
+		table->st_ctrl[slot] = CTRL_EMPTY;
+		table->st_left += 1;
+	}
+	else
+	{
+		table->st_ctrl[slot] = CTRL_DELETED;
+	}
+	table->st_count -= 1;
+
+	data = table->st_slots[slot].ss_data;
+	table->st_slots[slot].ss_key  = NULL;
+	table->st_slots[slot].ss_data = NULL;
+	if(deleted) *deleted = data;
+	if(table->st_free) table->st_free(data);
+	return CC_SWISSTABLE_OK;
+}
+
+cc_swisstable_status_t cc_swisstable_search(CC_SWISSTABLE table, const void *key, void **returned)
+{
+	size_t slot;
+
+	if(NOT_FOUND == (slot = table_find(table, key, table->st_hash(key))))
+		return CC_SWISSTABLE_NOENT;
+	if(returned) *returned = table->st_slots[slot].ss_data;
+	return CC_SWISSTABLE_OK;
+}
+
+size_t cc_swisstable_count(CC_SWISSTABLE table)
+{
+	return table->st_count;
+}
+
+/*
+ * Slot of key, or NOT_FOUND.
+ */
+static size_t table_find(CC_SWISSTABLE table, const void *key, uint64_t hval)
+{
+	const uint8_t *ctrl;
+	group_mask_t   match;
+	size_t         group = HASH_H1(hval) & table->st_mask;
+	size_t         stride;
+	size_t         slot;
+	uint8_t        h2    = HASH_H2(hval);
+
+	for(stride = 1; ; group = (group + stride) & table->st_mask, stride += 1)
+	{
+		ctrl = table->st_ctrl + group * GROUP_WIDTH;
+		for(match = group_match(ctrl, h2); match; match = MASK_DROP(match))
+		{
+			slot = group * GROUP_WIDTH + MASK_NEXT(match);
+			if(0 == table->st_comp(table->st_slots[slot].ss_key, key))
+				return slot;
+		}
+		if(group_empty(ctrl))
+			return NOT_FOUND;
+	}
+}
+
+/*
+ * Claim a free slot for a new key of hash hval. The caller made sure
+ * there is room.
+ */
+static size_t table_insert(CC_SWISSTABLE table, uint64_t hval)
+{
+	group_mask_t avail;
+	size_t       group = HASH_H1(hval) & table->st_mask;
+	size_t       stride;
+	size_t       slot;
+
+	for(stride = 1; ; group = (group + stride) & table->st_mask, stride += 1)
+	{
+		if(0 != (avail = group_free(table->st_ctrl + group * GROUP_WIDTH)))
+			break;
+	}
+
+	slot = group * GROUP_WIDTH + MASK_NEXT(avail);
+	if(CTRL_EMPTY == table->st_ctrl[slot])
+		table->st_left -= 1;
+	table->st_ctrl[slot] = HASH_H2(hval);
+	return slot;
+}
+
+/*
+ * Move every entry into new arrays of `capacity' slots, dropping the
+ * tombstones.
+ */
+static int table_resize(CC_SWISSTABLE table, size_t capacity)
+{
+	uint8_t              *octrl  = table->st_ctrl;
+	struct swiss_slot_st *oslots = table->st_slots;
+	size_t                ocap   = (table->st_mask + 1) * GROUP_WIDTH;
+	size_t                ix;
+	size_t                slot;
+
+	if(0 != table_arrays(capacity, &(table->st_ctrl), &(table->st_slots)))
+	{
+		table->st_ctrl  = octrl;
+		table->st_slots = oslots;
+		return -1;
+	}
+	table->st_mask = capacity / GROUP_WIDTH - 1;
+	table->st_left = MAX_LOAD(capacity);
+
+	for(ix = 0; ix < ocap; ix += 1)
+	{
+		if(CTRL_ISFULL(octrl[ix]))
+		{
+			slot = table_insert(table, table->st_hash(oslots[ix].ss_key));
+			table->st_slots[slot] = oslots[ix];
+		}
+	}
+	cc_free(octrl);
+	return 0;
+}
+
+/*
+ * Control bytes and slots of a table of `capacity' slots, in a single
+ * block.
+ */
+static int table_arrays(size_t capacity, uint8_t **ctrl, struct swiss_slot_st **slots)
+{
+	uint8_t *block;
+
+	if(NULL == (block = (uint8_t *)cc_malloc(capacity + capacity * sizeof(struct swiss_slot_st))))
+		return -1;
+	(void)memset(block, CTRL_EMPTY, capacity);
+	*ctrl  = block;
+	*slots = (struct swiss_slot_st *)(block + capacity);
+	return 0;
+}
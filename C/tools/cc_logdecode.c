@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2026
+ *      Christian CAMIER <chcamier@free.fr>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * #@ "cc_logdecode.c"
+ *	-- CC Utilities: Binary log decoder
+ *
+ * Author : Christian CAMIER (chcamier@free.fr)
+ *
+ * Formats the records of the binary log files written by cc_log with
+ * the "async_binfile" attribute (see CCA/log.h), one line per event,
+ * as the file driver would have written them. The files are read in
+ * turn, the standard input if none is given.
+ *
+ * The exit status is 0 when all the files are decoded, 1 otherwise.
+ *
+ * Rev : 1.0 (10/18/2026)
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <CCA/hash.h>
+#include <CCA/log.h>
+#include <CCA/memory.h>
+#include <CCA/options.h>
+#include <CCA/swisstable.h>
+#include <CCA/util.h>
+
+#include "log_internal.h"
+
+#define VERSION		"1.0"
+
+#define LINE_SIZE	8192		/* Longest line written             */
+
+/* Local datatypes definition */
+struct decode_format_st {
+	uint64_t df_id;			/* lb_format of the events          */
+	char     df_text[];
+};
+
+extern int main(int, char **);
+
+static const char *usage =
+	"CC %P %V, binary log decoder\n\n"
+	"Usage: %p [options] [file ...]\n"
+	"\n"
+	"Options:\n%O\n";
+
+static const char *version =
+	"CC %P %V\n"
+	"\n"
+	"Copyright (c) 2026\n"
+	"\tChristian CAMIER <chcamier@free.fr>\n";
+
+static struct cc_option options_defs[] = {
+	CC_OPT_ENTRY(
+		'h', 'h', "help",
+		CC_OPTARG_NONE,
+		CC_TNULL(int), 0, CC_OPTARG_OPENONE,
+		"display this help"),
+	CC_OPT_ENTRY(
+		'p', 'p', "precision",
+		CC_OPTARG_REQUIRED,
+		CC_TNULL(int), 0, CC_OPTARG_OPENONE,
+		"digits of the fractions of seconds (0, 3 or 6)"),
+	CC_OPT_ENTRY(
+		't', 't', "time-format",
+		CC_OPTARG_REQUIRED,
+		CC_TNULL(int), 0, CC_OPTARG_OPENONE,
+		"strftime format of the time stamps"),
+	CC_OPT_ENTRY(
+		'V', 'V', "version",
+		CC_OPTARG_NONE,
+		CC_TNULL(int), 0, CC_OPTARG_OPENONE,
+		"display programm version"),
+};
+
+static int      decode_file(FILE *, const char *);
+static int      decode_comp(const void *, const void *);
+static uint64_t decode_hash(const void *);
+static void     decode_free(const void *);
+
+static char line[LINE_SIZE];
+
+int main(int argc, char **argv)
+{
+	FILE *file;
+	int   failures;
+
+	cc_opts_prepare(*argv, VERSION, usage, options_defs, CC_ARRAY_COUNT(options_defs));
+	argc -= 1, argv += 1;
+	{
+		char *aa;
+		int   to;
+
+		aa = CC_TNULL(char);
+		while(0 != (to = cc_opts_next(&argc, &argv, &aa)))
+		{
+			switch(to)
+			{
+			case 'h': cc_opts_usage(0);					break;
+			case 'p': if(0 != cc_log_config("timeprecision", aa)) cc_opts_usage(202);	break;
+			case 't': if(0 != cc_log_config("timeformat", aa)) cc_opts_usage(202);	break;
+			case 'V': cc_opts_version(version);				break;
+			default:  cc_opts_usage(200);					break;
+			}
+		}
+	}
+
+	if(0 == argc)
+		return decode_file(stdin, "<stdin>");
+	for(failures = 0; argc > 0; argc -= 1, argv += 1)
+	{
+		if(NULL == (file = fopen(*argv, "r")))
+		{
+			fprintf(stderr, "%s: %s: %s\n", cc_opts_progname(), *argv, strerror(errno));
+			failures += 1;
+			continue;
+		}
+		failures += decode_file(file, *argv);
+		(void)fclose(file);
+	}
+	return failures ? 1 : 0;
+}
+
+/*
+ * Decode the records of file, returns 1 if it is not a valid binary log.
+ */
+static int decode_file(FILE *file, const char *name)
+{
+	struct cc_log_bin_head_st  head;
+	struct cc_log_bin_st      *rec;
+	struct decode_format_st   *fmt;
+	CC_SWISSTABLE              formats;
+	const char                *text;
+	uint32_t                   size;
+	size_t                     recsiz;
+	size_t                     n;
+
+	rec     = NULL;
+	recsiz  = 0;
+	formats = NULL;
+	for(;;)
+	{
+		/* A head or the start of a record, which is longer */
+		if(0 == (n = fread(&head, 1, sizeof(head), file)) && feof(file) && NULL != formats)
+			break;
+		if(sizeof(head) != n)
+			goto bad;
+
+		/* A head starts again : the format addresses changed */
+		if(0 == memcmp(head.lh_magic, LOG_BIN_MAGIC, sizeof(head.lh_magic)))
+		{
+			if(LOG_BIN_ORDER != head.lh_order || LOG_BIN_VERSION != head.lh_version)
+			{
+				fprintf(stderr, "%s: %s: Unsupported byte order or version\n", cc_opts_progname(), name);
+				goto fail;
+			}
+			if(NULL != formats)
+				cc_swisstable_destroy(formats);
+			if(NULL == (formats = cc_swisstable_create(64, decode_comp, decode_hash, decode_free)))
+				goto syserr;
+			continue;
+		}
+		if(NULL == formats)
+		{
+			fprintf(stderr, "%s: %s: Not a binary log file\n", cc_opts_progname(), name);
+			goto fail;
+		}
+
+		(void)memcpy(&size, &head, sizeof(size));
+		if(size < sizeof(*rec) || 0 != size % 8)
+			goto bad;
+		if(size > recsiz)
+		{
+			cc_free(rec);
+			if(NULL == (rec = (struct cc_log_bin_st *)cc_malloc(size)))
+				goto syserr;
+			recsiz = size;
+		}
+		(void)memcpy(rec, &head, sizeof(head));
+		if(1 != fread((char *)rec + sizeof(head), size - sizeof(head), 1, file))
+			goto bad;
+
+		switch(rec->lb_type)
+		{
+		case LOG_BIN_FORMAT:
+			n = size - sizeof(*rec);
+			if(NULL == (fmt = (struct decode_format_st *)cc_malloc(sizeof(*fmt) + n + 1)))
+				goto syserr;
+			fmt->df_id = rec->lb_format;
+			(void)memcpy(fmt->df_text, rec->lb_args, n);
+			fmt->df_text[n] = '\0';
+			if(CC_SWISSTABLE_OK != cc_swisstable_add(formats, &fmt->df_id, fmt))
+				cc_free(fmt);
+			break;
+		case LOG_BIN_EVENT:
+			if(CC_SWISSTABLE_OK == cc_swisstable_search(formats, &rec->lb_format, (void **)&fmt))
+				text = fmt->df_text;
+			else
+				text = "<unknown format>";
+			(void)cc_log_bin_render(line, sizeof(line), rec, text);
+			(void)puts(line);
+			break;
+		default:
+			break;
+		}
+	}
+	cc_swisstable_destroy(formats);
+	cc_free(rec);
+	return 0;
+
+syserr:
+	fprintf(stderr, "%s: %s\n", cc_opts_progname(), strerror(errno));
+	goto fail;
+bad:
+	fprintf(stderr, "%s: %s: %s\n", cc_opts_progname(), name, ferror(file) ? strerror(errno) : "Truncated or corrupted file");
+fail:
+	if(NULL != formats)
+		cc_swisstable_destroy(formats);
+	cc_free(rec);
+	return 1;
+}
+
+/*
+ * The formats are keyed by their address in the logging process.
+ */
+static int decode_comp(const void *a, const void *b)
+{
+	return *(const uint64_t *)a != *(const uint64_t *)b;
+}
+
+static uint64_t decode_hash(const void *key)
+{
+	return cc_hash64(key, sizeof(uint64_t), 0);
+}
+
+static void decode_free(const void *data)
+{
+	cc_free((void *)data);
+	return;
+}
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2026
+ *      Christian CAMIER <chcamier@free.fr>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * #@ "cc_mphgen.c"
+ *	-- CC Utilities: Perfect hash table generator
+ *
+ * Author : Christian CAMIER (chcamier@free.fr)
+ *
+ * Builds the perfect hash of the keys of a file (see CCA/mph.h) and
+ * writes its C code, by cc_mph_emit, on the standard output. Each line
+ * of the file holds a key, then optionally blanks and the initializer
+ * of its entry, written as is : either all the keys or none have one.
+ * Empty lines and lines starting with '#' are ignored.
+ *
+ * The name tables of cc_log are generated by "make mph" in C/tools,
+ * to be run when cc_hash64 changes.
+ *
+ * The exit status is 0 on success, 1 otherwise.
+ *
+ * Rev : 1.0 (10/18/2026)
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <CCA/memory.h>
+#include <CCA/mph.h>
+#include <CCA/options.h>
+#include <CCA/util.h>
+
+#define VERSION		"1.0"
+
+#define LINE_SIZE	1024		/* Longest line of the file         */
+
+extern int main(int, char **);
+
+static const char *usage =
+	"CC %P %V, perfect hash table generator\n\n"
+	"Usage: %p [options] file\n"
+	"\n"
+	"Options:\n%O\n";
+
+static const char *version =
+	"CC %P %V\n"
+	"\n"
+	"Copyright (c) 2026\n"
+	"\tChristian CAMIER <chcamier@free.fr>\n";
+
+static struct cc_option options_defs[] = {
+	CC_OPT_ENTRY(
+		'h', 'h', "help",
+		CC_OPTARG_NONE,
+		CC_TNULL(int), 0, CC_OPTARG_OPENONE,
+		"display this help"),
+	CC_OPT_ENTRY(
+		'i', 'i', "icase",
+		CC_OPTARG_NONE,
+		CC_TNULL(int), 0, CC_OPTARG_OPENONE,
+		"keys compare in any case (CC_MPH_ICASE)"),
+	CC_OPT_ENTRY(
+		'n', 'n', "name",
+		CC_OPTARG_REQUIRED,
+		CC_TNULL(int), 0, CC_OPTARG_OPENONE,
+		"name of the table"),
+	CC_OPT_ENTRY(
+		't', 't', "type",
+		CC_OPTARG_REQUIRED,
+		CC_TNULL(int), 0, CC_OPTARG_OPENONE,
+		"type of the entries (char *const)"),
+	CC_OPT_ENTRY(
+		'V', 'V', "version",
+		CC_OPTARG_NONE,
+		CC_TNULL(int), 0, CC_OPTARG_OPENONE,
+		"display programm version"),
+};
+
+static int gen_read(FILE *, const char *, char ***, char ***, size_t *);
+
+int main(int argc, char **argv)
+{
+	const char *name  = NULL;
+	const char *type  = "char *const";
+	int         flags = 0;
+	FILE       *file;
+	cc_mph_t    mph;
+	char      **keys;
+	char      **inits;
+	size_t      count;
+	size_t      i;
+	int         ret;
+
+	cc_opts_prepare(*argv, VERSION, usage, options_defs, CC_ARRAY_COUNT(options_defs));
+	argc -= 1, argv += 1;
+	{
+		char *aa;
+		int   to;
+
+		aa = CC_TNULL(char);
+		while(0 != (to = cc_opts_next(&argc, &argv, &aa)))
+		{
+			switch(to)
+			{
+			case 'h': cc_opts_usage(0);			break;
+			case 'i': flags |= CC_MPH_ICASE;		break;
+			case 'n': name = aa;				break;
+			case 't': type = aa;				break;
+			case 'V': cc_opts_version(version);		break;
+			default:  cc_opts_usage(200);			break;
+			}
+		}
+	}
+	if(1 != argc || NULL == name)
+		cc_opts_usage(201);
+
+	if(NULL == (file = fopen(*argv, "r")))
+	{
+		fprintf(stderr, "%s: %s: %s\n", cc_opts_progname(), *argv, strerror(errno));
+		return 1;
+	}
+	ret = gen_read(file, *argv, &keys, &inits, &count);
+	(void)fclose(file);
+	if(0 != ret)
+		return 1;
+
+	ret = 1;
+	if(0 != cc_mph_build(&mph, (const void *const *)keys, NULL, count, flags))
+		fprintf(stderr, "%s: %s: %s\n", cc_opts_progname(), *argv, EINVAL == errno ? "Duplicate or too long key" : strerror(errno));
+	else
+	{
+		if(0 != cc_mph_emit(stdout, &mph, name, (const void *const *)keys, NULL, type, (const char *const *)inits) || 0 != fflush(stdout))
+			fprintf(stderr, "%s: %s\n", cc_opts_progname(), strerror(errno));
+		else
+			ret = 0;
+		cc_mph_free(&mph);
+	}
+
+	for(i = 0; i < count; i += 1)
+		cc_free(keys[i]);
+	cc_free(keys);
+	cc_free(inits);
+	return ret;
+}
+
+/*
+ * Keys and initializers of file, inits being NULL if the keys have none.
+ * Both are stored in the same string : "key\0init".
+ */
+static int gen_read(FILE *file, const char *path, char ***rkeys, char ***rinits, size_t *rcount)
+{
+	char    line[LINE_SIZE];
+	char  **keys  = NULL;
+	char  **inits = NULL;
+	char  **grown;
+	char   *key;
+	char   *end;
+	char   *init;
+	size_t  count = 0;
+	size_t  size  = 0;
+	size_t  lineno;
+	int     withinit = -1;		/* Unknown before the first key     */
+
+	for(lineno = 1; NULL != fgets(line, sizeof(line), file); lineno += 1)
+	{
+		if(NULL == strchr(line, '\n') && !feof(file))
+		{
+			fprintf(stderr, "%s: %s:%lu: Line too long\n", cc_opts_progname(), path, (unsigned long)lineno);
+			goto fail;
+		}
+		for(end = line + strlen(line); end > line && isspace((unsigned char)end[-1]); *--end = '\0');
+		for(key = line; isspace((unsigned char)*key); key += 1);
+		if('\0' == *key || '#' == *key)
+			continue;
+		for(init = key; '\0' != *init && !isspace((unsigned char)*init); init += 1);
+		if('\0' != *init)
+		{
+			*init++ = '\0';
+			for(; isspace((unsigned char)*init); init += 1);
+		}
+		if(withinit < 0)
+			withinit = '\0' != *init;
+		else if(withinit != ('\0' != *init))
+		{
+			fprintf(stderr, "%s: %s:%lu: %s\n", cc_opts_progname(), path, (unsigned long)lineno, withinit ? "Initializer missing" : "Initializer unexpected, the first key has none");
+			goto fail;
+		}
+
+		if(count == size)
+		{
+			size = size ? 2 * size : 64;
+			if(NULL == (grown = (char **)cc_realloc(keys, size * sizeof(char *))))
+				goto syserr;
+			keys = grown;
+			if(NULL == (grown = (char **)cc_realloc(inits, size * sizeof(char *))))
+				goto syserr;
+			inits = grown;
+		}
+		if(NULL == (keys[count] = (char *)cc_memdup(key, (size_t)(end - key) + 1)))
+			goto syserr;
+		inits[count] = keys[count] + (init - key);
+		count += 1;
+	}
+	if(ferror(file))
+		goto syserr;
+
+	if(1 != withinit)
+	{
+		cc_free(inits);
+		inits = NULL;
+	}
+	*rkeys  = keys;
+	*rinits = inits;
+	*rcount = count;
+	return 0;
+
+syserr:
+	fprintf(stderr, "%s: %s: %s\n", cc_opts_progname(), path, strerror(errno));
+fail:
+	while(count > 0)
+		cc_free(keys[--count]);
+	cc_free(keys);
+	cc_free(inits);
+	return -1;
+}
@@ -0,0 +1,407 @@
+/*
+ * Copyright (c) 2026
+ *      Christian CAMIER <chcamier@free.fr>
+ *
+ * Permission to use, copy, modify, and distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * #@ "crc_bench.c"
+ *	-- CC Utilities: CRC correctness checks and throughput measures
+ *
+ * Author : Christian CAMIER (chcamier@free.fr)
+ *
+ * For every CRC family :
+ *  - crcSlow, crcFast and the incremental functions must give the
+ *    check value of the family for "123456789",
+ *  - crcFast and the incremental functions (fed by chunks of various
+ *    sizes) must give the crcSlow result on random messages of various
+ *    sizes and alignments.
+ * Then, unless -c is given, every function is timed on buffers from
+ * 16 bytes to 1 GB (by factors of 4), reporting GB/s and cycles per
+ * byte.
+ *
+ * The exit status is 0 when all checks succeed, 1 otherwise.
+ *
+ * Rev : 1.0 (10/18/2026)
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define HAVE_RDTSC
+#endif
+
+#include <CCA/options.h>
+#include <CCA/util.h>
+
+#include "crc_bench.h"
+
+#define VERSION		"1.0"
+
+#define MIN_SIZE	((size_t)16)
+#define DEFAULT_MAXSIZE	((size_t)1 << 30)	/* Largest benched buffer               */
+#define DEFAULT_MAXSLOW	((size_t)1 << 20)	/* Largest buffer given to crcSlow      */
+#define DEFAULT_MINTIME	100			/* Minimum duration of a measure (ms)   */
+#define CHECK_MAXSIZE	((size_t)70000)		/* Largest random message checked       */
+#define APPND_CHUNK	((size_t)4096)		/* Incremental chunk size when benched  */
+
+extern int main(int, char **);
+
+static const struct bench_family_st *families[] = {
+	&bench_ccitt,
+	&bench_crc16,
+	&bench_crc32,
+	&bench_crc32c,
+	&bench_crc64ecma,
+	&bench_crc64xz
+};
+
+static const size_t check_chunks[] = { 0, 1, 3, 8, 61, 4093 };
+
+static int options_flgs = 0;
+#define FLAG_CHECKONLY		(int)(1 << 0)
+#define IS_CHECKONLY	((options_flgs & FLAG_CHECKONLY) == FLAG_CHECKONLY)
+
+static const char *usage =
+	"CC %P %V, CRC checks and benchmarks\n\n"
+	"Usage: %p [options]\n"
+	"\n"
+	"Options:\n%O\n";
+
+static const char *version =
+	"CC %P %V\n"
+	"\n"
+	"Copyright (c) 2026\n"
+	"\tChristian CAMIER <chcamier@free.fr>\n";
+
+static struct cc_option options_defs[] = {
+	CC_OPT_ENTRY(
+		0, 'c', "check",
+		CC_OPTARG_NONE,
+		&options_flgs, FLAG_CHECKONLY, CC_OPTARG_OPEOR,
+		"run the correctness checks only"),
+	CC_OPT_ENTRY(
+		'h', 'h', "help",
+		CC_OPTARG_NONE,
+		CC_TNULL(int), 0, CC_OPTARG_OPENONE,
+		"display this help"),
+	CC_OPT_ENTRY(
+		'm', 'm', "max-size",
+		CC_OPTARG_REQUIRED,
+		CC_TNULL(int), 0, CC_OPTARG_OPENONE,
+		"largest benched buffer (K, M or G suffix allowed, default 1G)"),
+	CC_OPT_ENTRY(
+		's', 's', "max-slow",
+		CC_OPTARG_REQUIRED,
+		CC_TNULL(int), 0, CC_OPTARG_OPENONE,
+		"largest buffer benched with crcSlow (default 1M)"),
+	CC_OPT_ENTRY(
+		't', 't', "time",
+		CC_OPTARG_REQUIRED,
+		CC_TNULL(int), 0, CC_OPTARG_OPENONE,
+		"minimum duration of a measure in milliseconds (default 100)"),
+	CC_OPT_ENTRY(
+		'V', 'V', "version",
+		CC_OPTARG_NONE,
+		CC_TNULL(int), 0, CC_OPTARG_OPENONE,
+		"display programm version"),
+};
+
+static int         check_family(const struct bench_family_st *, const uint8_t *);
+static void        bench_family(const struct bench_family_st *, const uint8_t *, size_t, size_t, unsigned);
+static void        bench_measure(const struct bench_family_st *, int, const uint8_t *, size_t, unsigned);
+static size_t      parse_size(const char *);
+static const char *format_size(size_t, char *, size_t);
+static void        fill_random(uint8_t *, size_t);
+static double      now(void);
+
+static volatile cc_crc64_t sink;
+
+int main(int argc, char **argv)
+{
+	uint8_t *buffer;
+	size_t   maxsize;
+	size_t   maxslow;
+	unsigned mintime;
+	size_t   ix;
+	int      failures;
+
+	maxsize = DEFAULT_MAXSIZE;
+	maxslow = DEFAULT_MAXSLOW;
+	mintime = DEFAULT_MINTIME;
+
+	cc_opts_prepare(*argv, VERSION, usage, options_defs, CC_ARRAY_COUNT(options_defs));
+	argc -= 1, argv += 1;
+	{
+		char *aa;
+		int   to;
+
+		aa = CC_TNULL(char);
+		while(0 != (to = cc_opts_next(&argc, &argv, &aa)))
+		{
+			switch(to)
+			{
+			case 'h': cc_opts_usage(0);				break;
+			case 'm': maxsize = parse_size(aa);			break;
+			case 's': maxslow = parse_size(aa);			break;
+			case 't': mintime = (unsigned)strtoul(aa, NULL, 10);	break;
+			case 'V': cc_opts_version(version);			break;
+			default:  cc_opts_usage(200);				break;
+			}
+		}
+	}
+	if (argc > 0 || maxsize < MIN_SIZE)
+		cc_opts_usage(201);
+
+	/*
+	 * Correctness checks.
+	 */
+	if (NULL == (buffer = (uint8_t *)malloc(CHECK_MAXSIZE + 16)))
+	{
+		perror("malloc");
+		exit(202);
+	}
+	fill_random(buffer, CHECK_MAXSIZE + 16);
+	for (failures = 0, ix = 0; ix < CC_ARRAY_COUNT(families); ix += 1)
+		failures += check_family(families[ix], buffer);
+	free(buffer);
+
+	if (failures || IS_CHECKONLY)
+		exit(failures ? 1 : 0);
+
+	/*
+	 * Throughput measures, on the largest buffer we can get.
+	 */
+	for (buffer = NULL; NULL == buffer && maxsize >= MIN_SIZE; )
+		if (NULL == (buffer = (uint8_t *)malloc(maxsize)))
+			maxsize /= 4;
+	if (NULL == buffer)
+	{
+		perror("malloc");
+		exit(202);
+	}
+	fill_random(buffer, maxsize);
+
+	printf("%-16s %-6s %6s %10s %10s\n", "Family", "Func", "Size", "GB/s", "Cycles/B");
+	for (ix = 0; ix < CC_ARRAY_COUNT(families); ix += 1)
+		bench_family(families[ix], buffer, maxsize, maxslow, mintime);
+	free(buffer);
+
+	exit(0);
+}
+
+/*
+ * Correctness checks of a family, `buffer' holding CHECK_MAXSIZE + 16
+ * random bytes. Returns the number of failures.
+ */
+static int
+check_family(const struct bench_family_st *family, const uint8_t *buffer)
+{
+	static const char *check_string = "123456789";
+	cc_crc64_t         crc;
+	cc_crc64_t         ref;
+	size_t             size;
+	size_t             offset;
+	size_t             ix;
+	int                failures;
+
+	failures = 0;
+
+#define CHECK(COND, ...)					\
+	do {							\
+		if (!(COND))					\
+		{						\
+			fprintf(stderr, "%s: ", family->bf_name);\
+			fprintf(stderr, __VA_ARGS__);		\
+			fputc('\n', stderr);			\
+			failures += 1;				\
+		}						\
+	} while (0)
+
+	crc = family->bf_slow(check_string, 9);
+	CHECK(crc == family->bf_check, "crcSlow check value %llX, expected %llX",
+	      (unsigned long long)crc, (unsigned long long)family->bf_check);
+	crc = family->bf_fast(check_string, 9);
+	CHECK(crc == family->bf_check, "crcFast check value %llX, expected %llX",
+	      (unsigned long long)crc, (unsigned long long)family->bf_check);
+	for (ix = 0; ix < CC_ARRAY_COUNT(check_chunks); ix += 1)
+	{
+		crc = family->bf_appnd(check_string, 9, check_chunks[ix]);
+		CHECK(crc == family->bf_check, "crcAppnd (chunk %zu) check value %llX, expected %llX",
+		      check_chunks[ix], (unsigned long long)crc, (unsigned long long)family->bf_check);
+	}
+
+	/*
+	 * Sizes around the slicing and acceleration thresholds, then
+	 * growing geometrically, each one at several alignments.
+	 */
+	for (size = 0; size <= CHECK_MAXSIZE; size = (size < 300) ? size + 1 : size * 5 / 4)
+	{
+		for (offset = 0; offset < 16; offset += (size < 300) ? 7 : 3)
+		{
+			ref = family->bf_slow(buffer + offset, size);
+			crc = family->bf_fast(buffer + offset, size);
+			CHECK(crc == ref, "crcFast(%zu bytes at +%zu) = %llX, crcSlow = %llX",
+			      size, offset, (unsigned long long)crc, (unsigned long long)ref);
+			for (ix = 0; ix < CC_ARRAY_COUNT(check_chunks); ix += 1)
+			{
+				crc = family->bf_appnd(buffer + offset, size, check_chunks[ix]);
+				CHECK(crc == ref, "crcAppnd(%zu bytes at +%zu, chunk %zu) = %llX, crcSlow = %llX",
+				      size, offset, check_chunks[ix], (unsigned long long)crc, (unsigned long long)ref);
+			}
+		}
+	}
+
+#undef CHECK
+
+	printf("%-16s %s\n", family->bf_name, failures ? "FAILED" : "ok");
+	return failures;
+}
+
+/*
+ * Throughput of the functions of a family.
+ */
+static void
+bench_family(const struct bench_family_st *family, const uint8_t *buffer, size_t maxsize, size_t maxslow, unsigned mintime)
+{
+	size_t size;
+	int    func;
+
+	for (func = 0; func < 3; func += 1)
+		for (size = MIN_SIZE; size <= maxsize; size *= 4)
+		{
+			if (0 == func && size > maxslow)
+				break;
+			bench_measure(family, func, buffer, size, mintime);
+		}
+}
+
+/*
+ * Run `func' (0: crcSlow, 1: crcFast, 2: crcAppnd by APPND_CHUNK
+ * bytes) on `size' bytes until at least `mintime' milliseconds are
+ * spent, and report the throughput.
+ */
+static void
+bench_measure(const struct bench_family_st *family, int func, const uint8_t *buffer, size_t size, unsigned mintime)
+{
+	static const char *names[] = { "Slow", "Fast", "Appnd" };
+	char               sbuf[16];
+	double             start;
+	double             elapsed;
+	uint64_t           rounds;
+	uint64_t           batch;
+	uint64_t           ix;
+	double             cycles;
+#if defined(HAVE_RDTSC)
+	uint64_t           tsc;
+#endif
+
+	rounds  = 0;
+	batch   = 1;
+	cycles  = 0.0;
+	start   = now();
+#if defined(HAVE_RDTSC)
+	tsc     = __rdtsc();
+#endif
+	do {
+		for (ix = 0; ix < batch; ix += 1)
+		{
+			switch (func)
+			{
+			case 0:  sink = family->bf_slow(buffer, size);			break;
+			case 1:  sink = family->bf_fast(buffer, size);			break;
+			default: sink = family->bf_appnd(buffer, size, APPND_CHUNK);	break;
+			}
+		}
+		rounds  += batch;
+		batch   *= 2;
+		elapsed  = now() - start;
+	} while (elapsed * 1000.0 < (double)mintime);
+#if defined(HAVE_RDTSC)
+	cycles = (double)(__rdtsc() - tsc) / ((double)rounds * (double)size);
+#endif
+
+	printf("%-16s %-6s %6s %10.3f ", family->bf_name, names[func],
+	       format_size(size, sbuf, sizeof(sbuf)),
+	       (double)rounds * (double)size / elapsed / 1e9);
+	if (0.0 != cycles)
+		printf("%10.3f\n", cycles);
+	else
+		printf("%10s\n", "-");
+	fflush(stdout);
+}
+
+/*
+ * Size with an optional K, M or G suffix.
+ */
+static size_t
+parse_size(const char *str)
+{
+	char   *end;
+	size_t  size;
+
+	size = (size_t)strtoull(str, &end, 10);
+	switch (*end)
+	{
+	case 'G': case 'g': size <<= 10;	/* FALLTHROUGH */
+	case 'M': case 'm': size <<= 10;	/* FALLTHROUGH */
+	case 'K': case 'k': size <<= 10;	break;
+	case '\0':				break;
+	default:  cc_opts_usage(201);		break;
+	}
+	return size;
+}
+
+static const char *
+format_size(size_t size, char *buf, size_t bsz)
+{
+	static const char units[] = "BKMG";
+	int               unit;
+
+	for (unit = 0; unit < 3 && size >= 1024 && 0 == size % 1024; unit += 1)
+		size /= 1024;
+	(void)snprintf(buf, bsz, "%zu%c", size, units[unit]);
+	return buf;
+}
+
+/*
+ * Reproducible pseudo random bytes (xorshift64).
+ */
+static void
+fill_random(uint8_t *buffer, size_t size)
+{
+	uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+	for (; size > 0; size -= 1, buffer += 1)
+	{
+		state ^= state << 13;
+		state ^= state >>  7;
+		state ^= state << 17;
+		*buffer = (uint8_t)(state >> 24);
+	}
+}
+
+static double
+now(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
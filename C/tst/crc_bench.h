@@ -0,0 +1,39 @@
+/*
+ * #@ "crc_bench.h"
+ *
+ * Author : Christian CAMIER (chcamier@free.fr)
+ *
+ * CRC families exercised by crc_bench.
+ *
+ * Each family is seen through the same interface, whatever its width,
+ * the CRC values being held in the low bits of a cc_crc64_t.
+ *
+ * History :
+ * ---------
+ *
+ * Oct 18, 2026: Christian CAMIER
+ *	v1.0 :	Creation
+ */
+
+#ifndef __CRC_BENCH_H__
+#define __CRC_BENCH_H__
+
+#include <CCA/crc.h>
+
+struct bench_family_st {
+	const char  *bf_name;				/* Family name                  */
+	cc_crc64_t   bf_check;				/* CRC of "123456789"           */
+	cc_crc64_t (*bf_slow )(const void *, size_t);	/* crcSlow                      */
+	cc_crc64_t (*bf_fast )(const void *, size_t);	/* crcFast                      */
+	cc_crc64_t (*bf_appnd)(const void *, size_t, size_t); /* crcStart, crcAppnd by	*/
+							/* chunks (0: one chunk), crcClose */
+};
+
+extern const struct bench_family_st bench_ccitt;
+extern const struct bench_family_st bench_crc16;
+extern const struct bench_family_st bench_crc32;
+extern const struct bench_family_st bench_crc32c;
+extern const struct bench_family_st bench_crc64ecma;
+extern const struct bench_family_st bench_crc64xz;
+
+#endif /* !__CRC_BENCH_H__ */
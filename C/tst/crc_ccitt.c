@@ -0,0 +1,9 @@
+/*
+ * #@"crc_ccitt.c"
+ */
+
+#define CRC_CCITT
+
+#define BENCH_FAMILY	bench_ccitt
+
+#include "crc_family.h"
@@ -0,0 +1,9 @@
+/*
+ * #@"crc_crc16.c"
+ */
+
+#define CRC_CRC16
+
+#define BENCH_FAMILY	bench_crc16
+
+#include "crc_family.h"
@@ -0,0 +1,9 @@
+/*
+ * #@"crc_crc32.c"
+ */
+
+#define CRC_CRC32
+
+#define BENCH_FAMILY	bench_crc32
+
+#include "crc_family.h"
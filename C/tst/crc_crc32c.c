@@ -0,0 +1,9 @@
+/*
+ * #@"crc_crc32c.c"
+ */
+
+#define CRC_CRC32C
+
+#define BENCH_FAMILY	bench_crc32c
+
+#include "crc_family.h"
@@ -0,0 +1,56 @@
+/*
+ * #@ "crc_crc64.c"
+ *
+ * Author : Christian CAMIER (chcamier@free.fr)
+ *
+ * Bench interface of the CRC-64 families, which are built on the
+ * generic engine and have no entry in crc_internal.h. Their check
+ * values are the ones of cc_crc_model_crc64ecma and cc_crc_model_crc64xz.
+ *
+ * History :
+ * ---------
+ *
+ * Oct 18, 2026: Christian CAMIER
+ *	v1.0 :	Creation
+ */
+
+#include "crc_bench.h"
+
+#define BENCH_CRC64(PRFX, NAME, CHECK)						\
+static cc_crc64_t								\
+PRFX ## _slow(const void *data, size_t nBytes)					\
+{										\
+	return cc_ ## PRFX ## _crcSlow(data, nBytes);				\
+}										\
+										\
+static cc_crc64_t								\
+PRFX ## _fast(const void *data, size_t nBytes)					\
+{										\
+	return cc_ ## PRFX ## _crcFast(data, nBytes);				\
+}										\
+										\
+static cc_crc64_t								\
+PRFX ## _appnd(const void *data, size_t nBytes, size_t chunk)			\
+{										\
+	const uint8_t *message = (const uint8_t *)data;				\
+	cc_crc64_t     context;							\
+	size_t         size;							\
+										\
+	if (0 == chunk)								\
+		chunk = nBytes;							\
+										\
+	(void)cc_ ## PRFX ## _crcStart(&context);				\
+	for (; nBytes > 0; nBytes -= size, message += size)			\
+	{									\
+		size = (nBytes < chunk) ? nBytes : chunk;			\
+		(void)cc_ ## PRFX ## _crcAppnd(&context, message, size);	\
+	}									\
+	return cc_ ## PRFX ## _crcClose(&context);				\
+}										\
+										\
+const struct bench_family_st bench_ ## PRFX = {					\
+	NAME, CHECK, PRFX ## _slow, PRFX ## _fast, PRFX ## _appnd		\
+}
+
+BENCH_CRC64(crc64ecma, "CRC-64/ECMA-182", 0x6C40DF5F0B497347ULL);
+BENCH_CRC64(crc64xz,   "CRC-64/XZ",       0x995DC9BBDF1939FAULL);
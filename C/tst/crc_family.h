@@ -0,0 +1,60 @@
+/*
+ * #@ "crc_family.h"
+ *
+ * Author : Christian CAMIER (chcamier@free.fr)
+ *
+ * Bench interface of a CRC family described in crc_internal.h.
+ *
+ * Like the library sources, this file is included once per family with
+ * the family selected (CRC_CCITT, CRC_CRC16, ...) and BENCH_FAMILY set
+ * to the name of the descriptor to define. The check value is the
+ * CHECK_VALUE of the family.
+ *
+ * History :
+ * ---------
+ *
+ * Oct 18, 2026: Christian CAMIER
+ *	v1.0 :	Creation
+ */
+
+#include "crc_internal.h"
+#include "crc_bench.h"
+
+#define BENCH_PASTE2(A, B)	A ## B
+#define BENCH_PASTE(A, B)	BENCH_PASTE2(A, B)
+#define BENCH_FN(N)		BENCH_PASTE(CRC_PRFX, N)
+
+static cc_crc64_t
+bench_slow(const void *data, size_t nBytes)
+{
+	return BENCH_FN(_crcSlow)(data, nBytes);
+}
+
+static cc_crc64_t
+bench_fast(const void *data, size_t nBytes)
+{
+	return BENCH_FN(_crcFast)(data, nBytes);
+}
+
+static cc_crc64_t
+bench_appnd(const void *data, size_t nBytes, size_t chunk)
+{
+	const uint8_t *message = (const uint8_t *)data;
+	CRC_TYPE       context;
+	size_t         size;
+
+	if (0 == chunk)
+		chunk = nBytes;
+
+	(void)BENCH_FN(_crcStart)(&context);
+	for (; nBytes > 0; nBytes -= size, message += size)
+	{
+		size = (nBytes < chunk) ? nBytes : chunk;
+		(void)BENCH_FN(_crcAppnd)(&context, message, size);
+	}
+	return BENCH_FN(_crcClose)(&context);
+}
+
+const struct bench_family_st BENCH_FAMILY = {
+	CRC_NAME, CHECK_VALUE, bench_slow, bench_fast, bench_appnd
+};